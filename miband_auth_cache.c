@@ -0,0 +1,220 @@
+/**
+ * @file miband_auth_cache.c
+ * @brief Per-card authentication key cache implementation
+ */
+
+#include "miband_auth_cache.h"
+#include "miband_card_io.h"
+#include "miband_op_stats.h"
+
+#define TAG "MiBandAuthCache"
+
+#define MIBAND_AUTH_CACHE_UID_MAX 10
+
+typedef struct {
+    MfClassicKey key;
+    MfClassicKeyType key_type;
+    bool valid;
+} MiBandAuthCacheEntry;
+
+/**
+ * @brief Auth cache internal structure
+ */
+struct MiBandAuthCache {
+    uint8_t uid[MIBAND_AUTH_CACHE_UID_MAX];
+    size_t uid_len;
+    MiBandAuthCacheEntry sectors[MF_CLASSIC_TOTAL_SECTORS_MAX];
+    uint32_t auth_attempts;
+    uint32_t auth_failures;
+    MiBandLogger* logger;
+};
+
+MiBandAuthCache* miband_auth_cache_alloc(void) {
+    MiBandAuthCache* cache = malloc(sizeof(MiBandAuthCache));
+    memset(cache, 0, sizeof(MiBandAuthCache));
+    return cache;
+}
+
+void miband_auth_cache_free(MiBandAuthCache* cache) {
+    free(cache);
+}
+
+void miband_auth_cache_bind(MiBandAuthCache* cache, const uint8_t* uid, size_t uid_len) {
+    if(uid_len > MIBAND_AUTH_CACHE_UID_MAX) uid_len = MIBAND_AUTH_CACHE_UID_MAX;
+
+    if(cache->uid_len == uid_len && memcmp(cache->uid, uid, uid_len) == 0) {
+        return;
+    }
+
+    FURI_LOG_D(TAG, "New card bound, dropping cached keys");
+    miband_auth_cache_clear(cache);
+    memcpy(cache->uid, uid, uid_len);
+    cache->uid_len = uid_len;
+}
+
+bool miband_auth_cache_bind_card(MiBandAuthCache* cache, Nfc* nfc) {
+    Iso14443_3aData iso_data = {0};
+    if(miband_card_io_activate(nfc, &iso_data) != Iso14443_3aErrorNone) {
+        FURI_LOG_W(TAG, "No card to bind");
+        return false;
+    }
+
+    miband_auth_cache_bind(cache, iso_data.uid, iso_data.uid_len);
+    return true;
+}
+
+const uint8_t* miband_auth_cache_get_uid(const MiBandAuthCache* cache, size_t* uid_len) {
+    *uid_len = cache->uid_len;
+    return cache->uid;
+}
+
+void miband_auth_cache_clear(MiBandAuthCache* cache) {
+    memset(cache->sectors, 0, sizeof(cache->sectors));
+}
+
+bool miband_auth_cache_get(
+    const MiBandAuthCache* cache,
+    uint8_t sector,
+    MfClassicKey* key,
+    MfClassicKeyType* key_type) {
+    if(sector >= MF_CLASSIC_TOTAL_SECTORS_MAX || !cache->sectors[sector].valid) return false;
+
+    *key = cache->sectors[sector].key;
+    *key_type = cache->sectors[sector].key_type;
+    return true;
+}
+
+void miband_auth_cache_set(
+    MiBandAuthCache* cache,
+    uint8_t sector,
+    const MfClassicKey* key,
+    MfClassicKeyType key_type) {
+    if(sector >= MF_CLASSIC_TOTAL_SECTORS_MAX) return;
+
+    cache->sectors[sector].key = *key;
+    cache->sectors[sector].key_type = key_type;
+    cache->sectors[sector].valid = true;
+}
+
+void miband_auth_cache_forget(MiBandAuthCache* cache, uint8_t sector) {
+    if(sector >= MF_CLASSIC_TOTAL_SECTORS_MAX) return;
+    cache->sectors[sector].valid = false;
+}
+
+MfClassicError miband_auth_cache_auth(
+    MiBandAuthCache* cache,
+    Nfc* nfc,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicAuthContext* auth_context) {
+    MfClassicAuthContext local_context;
+    uint32_t start = miband_op_stats_start();
+    MfClassicError error = miband_card_io_auth(
+        nfc, block_num, key, key_type, auth_context ? auth_context : &local_context);
+    miband_op_stats_record(MiBandOpPhaseAuth, start, error);
+
+    miband_auth_cache_record(cache, block_num, key, key_type, error);
+    return error;
+}
+
+void miband_auth_cache_record(
+    MiBandAuthCache* cache,
+    uint8_t block_num,
+    const MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicError error) {
+    uint8_t sector = mf_classic_get_sector_by_block(block_num);
+    cache->auth_attempts++;
+    miband_logger_event(
+        cache->logger, LogLevelDebug, MiBandLogEventAuth, sector, block_num, key_type, error);
+
+    if(error == MfClassicErrorNone) {
+        miband_auth_cache_set(cache, sector, key, key_type);
+    } else {
+        cache->auth_failures++;
+
+        // A cached key the card rejected is stale (e.g. trailer rewritten);
+        // timeouts and a missing card say nothing about the key
+        MiBandAuthCacheEntry* entry = &cache->sectors[sector];
+        if(error == MfClassicErrorAuth && entry->valid && entry->key_type == key_type &&
+           memcmp(entry->key.data, key->data, sizeof(entry->key.data)) == 0) {
+            entry->valid = false;
+        }
+    }
+}
+
+static bool miband_auth_cache_add_candidate(
+    MfClassicKey* keys,
+    MfClassicKeyType* key_types,
+    size_t* count,
+    const uint8_t* key_data,
+    MfClassicKeyType key_type) {
+    for(size_t i = 0; i < *count; i++) {
+        if(key_types[i] == key_type && memcmp(keys[i].data, key_data, sizeof(keys[i].data)) == 0) {
+            return false;
+        }
+    }
+
+    if(*count >= MIBAND_AUTH_CACHE_MAX_CANDIDATES) return false;
+
+    memcpy(keys[*count].data, key_data, sizeof(keys[*count].data));
+    key_types[*count] = key_type;
+    (*count)++;
+    return true;
+}
+
+size_t miband_auth_cache_get_candidates(
+    const MiBandAuthCache* cache,
+    const MfClassicData* dump,
+    uint8_t sector,
+    bool magic_first,
+    MfClassicKey* keys,
+    MfClassicKeyType* key_types) {
+    static const uint8_t magic_key[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    size_t count = 0;
+
+    MfClassicKey cached_key;
+    MfClassicKeyType cached_type;
+    if(miband_auth_cache_get(cache, sector, &cached_key, &cached_type)) {
+        miband_auth_cache_add_candidate(keys, key_types, &count, cached_key.data, cached_type);
+    }
+
+    if(magic_first) {
+        miband_auth_cache_add_candidate(keys, key_types, &count, magic_key, MfClassicKeyTypeA);
+    }
+
+    MfClassicSectorTrailer* sec_tr =
+        dump ? mf_classic_get_sector_trailer_by_sector(dump, sector) : NULL;
+
+    if(sec_tr && mf_classic_is_key_found(dump, sector, MfClassicKeyTypeA)) {
+        miband_auth_cache_add_candidate(
+            keys, key_types, &count, sec_tr->key_a.data, MfClassicKeyTypeA);
+    }
+
+    if(sec_tr && mf_classic_is_key_found(dump, sector, MfClassicKeyTypeB)) {
+        miband_auth_cache_add_candidate(
+            keys, key_types, &count, sec_tr->key_b.data, MfClassicKeyTypeB);
+    }
+
+    miband_auth_cache_add_candidate(keys, key_types, &count, magic_key, MfClassicKeyTypeA);
+
+    return count;
+}
+
+void miband_auth_cache_reset_stats(MiBandAuthCache* cache) {
+    cache->auth_attempts = 0;
+    cache->auth_failures = 0;
+}
+
+uint32_t miband_auth_cache_get_attempts(const MiBandAuthCache* cache) {
+    return cache->auth_attempts;
+}
+
+uint32_t miband_auth_cache_get_failures(const MiBandAuthCache* cache) {
+    return cache->auth_failures;
+}
+
+void miband_auth_cache_set_logger(MiBandAuthCache* cache, MiBandLogger* logger) {
+    cache->logger = logger;
+}
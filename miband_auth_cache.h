@@ -0,0 +1,212 @@
+/**
+ * @file miband_auth_cache.h
+ * @brief Per-card authentication key cache
+ *
+ * Remembers which key last authenticated each sector of the card currently
+ * in the field, so backup, write and verify try the known-good key first
+ * instead of walking the whole dump/0xFF key chain for every sector.
+ *
+ * The cache is bound to a card UID: binding a different UID drops all
+ * cached keys. It also counts authentication attempts so each operation
+ * can report how many RF auth handshakes it needed, and logs every attempt
+ * as a structured event when a logger is attached.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <nfc/nfc.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
+#include "miband_logger.h"
+
+/** Maximum number of candidate keys returned for one sector */
+#define MIBAND_AUTH_CACHE_MAX_CANDIDATES 4
+
+/**
+ * @brief Auth cache structure
+ */
+typedef struct MiBandAuthCache MiBandAuthCache;
+
+/**
+ * @brief Create an empty auth cache
+ *
+ * @return Allocated MiBandAuthCache instance
+ */
+MiBandAuthCache* miband_auth_cache_alloc(void);
+
+/**
+ * @brief Free auth cache
+ *
+ * @param cache Auth cache instance
+ */
+void miband_auth_cache_free(MiBandAuthCache* cache);
+
+/**
+ * @brief Bind the cache to a card UID
+ *
+ * Cached keys are kept if the UID matches the current one, dropped otherwise.
+ *
+ * @param cache Auth cache instance
+ * @param uid Card UID bytes
+ * @param uid_len UID length in bytes
+ */
+void miband_auth_cache_bind(MiBandAuthCache* cache, const uint8_t* uid, size_t uid_len);
+
+/**
+ * @brief Read the UID of the card in the field and bind the cache to it
+ *
+ * @param cache Auth cache instance
+ * @param nfc NFC instance
+ * @return true if a card answered, false otherwise (cache is left untouched)
+ */
+bool miband_auth_cache_bind_card(MiBandAuthCache* cache, Nfc* nfc);
+
+/**
+ * @brief Get the UID the cache is bound to
+ *
+ * @param cache Auth cache instance
+ * @param uid_len Output UID length, 0 if no card was bound yet
+ * @return UID bytes
+ */
+const uint8_t* miband_auth_cache_get_uid(const MiBandAuthCache* cache, size_t* uid_len);
+
+/**
+ * @brief Drop every cached key
+ *
+ * @param cache Auth cache instance
+ */
+void miband_auth_cache_clear(MiBandAuthCache* cache);
+
+/**
+ * @brief Get the cached key for a sector
+ *
+ * @param cache Auth cache instance
+ * @param sector Sector number
+ * @param key Output key
+ * @param key_type Output key type
+ * @return true if a key is cached for this sector
+ */
+bool miband_auth_cache_get(
+    const MiBandAuthCache* cache,
+    uint8_t sector,
+    MfClassicKey* key,
+    MfClassicKeyType* key_type);
+
+/**
+ * @brief Store the working key for a sector
+ *
+ * @param cache Auth cache instance
+ * @param sector Sector number
+ * @param key Working key
+ * @param key_type Working key type
+ */
+void miband_auth_cache_set(
+    MiBandAuthCache* cache,
+    uint8_t sector,
+    const MfClassicKey* key,
+    MfClassicKeyType key_type);
+
+/**
+ * @brief Forget the cached key for a sector
+ *
+ * @param cache Auth cache instance
+ * @param sector Sector number
+ */
+void miband_auth_cache_forget(MiBandAuthCache* cache, uint8_t sector);
+
+/**
+ * @brief Authenticate a block, counting the attempt and caching the key on success
+ *
+ * Drop-in replacement for mf_classic_poller_sync_auth(). A cached key is
+ * dropped only when the card rejects it (MfClassicErrorAuth), not on
+ * timeouts or a lost card.
+ *
+ * @param cache Auth cache instance
+ * @param nfc NFC instance
+ * @param block_num Block to authenticate
+ * @param key Key to use
+ * @param key_type Key type
+ * @param auth_context Optional auth context output (may be NULL)
+ * @return MfClassicError from the poller
+ */
+MfClassicError miband_auth_cache_auth(
+    MiBandAuthCache* cache,
+    Nfc* nfc,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicAuthContext* auth_context);
+
+/**
+ * @brief Account for an auth made outside miband_auth_cache_auth()
+ *
+ * Counts and logs the attempt and updates the cached key exactly as
+ * miband_auth_cache_auth() does. Sector sessions report their in-session
+ * auth through it.
+ *
+ * @param cache Auth cache instance
+ * @param block_num Block that was authenticated
+ * @param key Key that was used
+ * @param key_type Key type
+ * @param error Outcome of the auth
+ */
+void miband_auth_cache_record(
+    MiBandAuthCache* cache,
+    uint8_t block_num,
+    const MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicError error);
+
+/**
+ * @brief Build the ordered list of keys to try for a sector
+ *
+ * The cached key (if any) always comes first. The rest of the chain is
+ * dump Key A, dump Key B, 0xFF Key A, or 0xFF first when magic_first is set.
+ * Duplicates are skipped so no key is tried twice.
+ *
+ * @param cache Auth cache instance
+ * @param dump Dump providing the original keys (may be NULL)
+ * @param sector Sector number
+ * @param magic_first Try the 0xFF key before the dump keys
+ * @param keys Output key array (MIBAND_AUTH_CACHE_MAX_CANDIDATES entries)
+ * @param key_types Output key type array (MIBAND_AUTH_CACHE_MAX_CANDIDATES entries)
+ * @return Number of candidates written
+ */
+size_t miband_auth_cache_get_candidates(
+    const MiBandAuthCache* cache,
+    const MfClassicData* dump,
+    uint8_t sector,
+    bool magic_first,
+    MfClassicKey* keys,
+    MfClassicKeyType* key_types);
+
+/**
+ * @brief Reset the attempt counters (cached keys are kept)
+ *
+ * @param cache Auth cache instance
+ */
+void miband_auth_cache_reset_stats(MiBandAuthCache* cache);
+
+/**
+ * @brief Get number of auth attempts since the last stats reset
+ *
+ * @param cache Auth cache instance
+ * @return Auth attempts
+ */
+uint32_t miband_auth_cache_get_attempts(const MiBandAuthCache* cache);
+
+/**
+ * @brief Get number of failed auth attempts since the last stats reset
+ *
+ * @param cache Auth cache instance
+ * @return Failed auth attempts
+ */
+uint32_t miband_auth_cache_get_failures(const MiBandAuthCache* cache);
+
+/**
+ * @brief Log every auth attempt to a logger
+ *
+ * @param cache Auth cache instance
+ * @param logger Logger instance, not owned, NULL to stop logging
+ */
+void miband_auth_cache_set_logger(MiBandAuthCache* cache, MiBandLogger* logger);
@@ -0,0 +1,89 @@
+/**
+ * @file miband_backup_saver.c
+ * @brief Background backup save implementation
+ */
+
+#include "miband_backup_saver.h"
+#include <nfc/nfc_device.h>
+
+#define TAG "MiBandBackupSaver"
+
+#define BACKUP_SAVER_STACK_SIZE 2048
+
+struct MiBandBackupSaver {
+    FuriThread* thread;
+    NfcDevice* device; // Owns the copy of the backup being saved
+    FuriString* path;
+
+    bool pending; // Started and not yet waited for
+    bool saved;
+};
+
+static int32_t backup_saver_thread(void* context) {
+    MiBandBackupSaver* saver = context;
+
+    uint32_t start = furi_get_tick();
+    saver->saved = nfc_device_save(saver->device, furi_string_get_cstr(saver->path));
+    FURI_LOG_I(
+        TAG,
+        "%s %s in %lu ms",
+        saver->saved ? "Saved" : "Failed to save",
+        furi_string_get_cstr(saver->path),
+        furi_get_tick() - start);
+    return 0;
+}
+
+MiBandBackupSaver* miband_backup_saver_alloc(void) {
+    MiBandBackupSaver* saver = malloc(sizeof(MiBandBackupSaver));
+    memset(saver, 0, sizeof(MiBandBackupSaver));
+
+    saver->device = nfc_device_alloc();
+    saver->path = furi_string_alloc();
+    saver->thread = furi_thread_alloc_ex(
+        "MiBandBackupSaver", BACKUP_SAVER_STACK_SIZE, backup_saver_thread, saver);
+    // Below the GUI and NFC threads, so the write in the foreground never waits on SD
+    furi_thread_set_priority(saver->thread, FuriThreadPriorityLow);
+    return saver;
+}
+
+void miband_backup_saver_free(MiBandBackupSaver* saver) {
+    if(!saver) return;
+
+    miband_backup_saver_wait(saver);
+    furi_thread_free(saver->thread);
+    nfc_device_free(saver->device);
+    furi_string_free(saver->path);
+    free(saver);
+}
+
+void miband_backup_saver_start(
+    MiBandBackupSaver* saver,
+    const MfClassicData* data,
+    const char* path) {
+    furi_assert(saver);
+    furi_assert(data);
+    furi_assert(path);
+
+    miband_backup_saver_wait(saver);
+
+    nfc_device_set_data(saver->device, NfcProtocolMfClassic, data);
+    furi_string_set_str(saver->path, path);
+    saver->saved = false;
+    saver->pending = true;
+    furi_thread_start(saver->thread);
+}
+
+MiBandBackupSaveResult miband_backup_saver_wait(MiBandBackupSaver* saver) {
+    furi_assert(saver);
+
+    if(!saver->pending) return MiBandBackupSaveNone;
+
+    furi_thread_join(saver->thread);
+    saver->pending = false;
+    return saver->saved ? MiBandBackupSaveOk : MiBandBackupSaveFailed;
+}
+
+const char* miband_backup_saver_get_path(const MiBandBackupSaver* saver) {
+    furi_assert(saver);
+    return furi_string_get_cstr(saver->path);
+}
@@ -0,0 +1,76 @@
+/**
+ * @file miband_backup_saver.h
+ * @brief Background save of the pre-write backup
+ *
+ * Serializing a full dump to a text .nfc on SD takes longer than writing
+ * the band itself, yet the writer does not need the file, only the data
+ * that was read. The saver takes a copy of the backup and writes it on a
+ * low-priority thread while the writer runs on the band that is still in
+ * the field; the result is collected when the write finishes.
+ *
+ * One save is in flight at a time.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
+
+/**
+ * @brief Outcome of the last queued save
+ */
+typedef enum {
+    MiBandBackupSaveNone, /**< Nothing was queued since the last wait */
+    MiBandBackupSaveOk,
+    MiBandBackupSaveFailed,
+} MiBandBackupSaveResult;
+
+/**
+ * @brief Backup saver structure
+ */
+typedef struct MiBandBackupSaver MiBandBackupSaver;
+
+/**
+ * @brief Create a backup saver
+ *
+ * @return Allocated MiBandBackupSaver instance
+ */
+MiBandBackupSaver* miband_backup_saver_alloc(void);
+
+/**
+ * @brief Free backup saver, finishing a save still in flight
+ *
+ * @param saver Backup saver instance
+ */
+void miband_backup_saver_free(MiBandBackupSaver* saver);
+
+/**
+ * @brief Queue a backup save and return immediately
+ *
+ * The data is copied, so the caller may overwrite it right away. A save
+ * still in flight is waited for first.
+ *
+ * @param saver Backup saver instance
+ * @param data Backup data
+ * @param path Destination .nfc path
+ */
+void miband_backup_saver_start(
+    MiBandBackupSaver* saver,
+    const MfClassicData* data,
+    const char* path);
+
+/**
+ * @brief Wait for the queued save and take its result
+ *
+ * @param saver Backup saver instance
+ * @return Result, MiBandBackupSaveNone if nothing was queued
+ */
+MiBandBackupSaveResult miband_backup_saver_wait(MiBandBackupSaver* saver);
+
+/**
+ * @brief Get the path of the last queued save
+ *
+ * @param saver Backup saver instance
+ * @return Path, empty before the first save
+ */
+const char* miband_backup_saver_get_path(const MiBandBackupSaver* saver);
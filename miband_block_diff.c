@@ -0,0 +1,86 @@
+/**
+ * @file miband_block_diff.c
+ * @brief Block-by-block comparison implementation
+ */
+
+#include "miband_block_diff.h"
+
+#define MIBAND_BLOCK_DIFF_WORDS (MF_CLASSIC_BLOCK_SIZE / sizeof(uint32_t))
+
+/**
+ * @brief Turn the XOR of two words into a 4-bit mask of differing bytes
+ *
+ * Folds every byte onto its low bit, then gathers bits 0, 8, 16 and 24
+ * into bits 0..3 with one multiply (the partial products never overlap).
+ * Little-endian byte order, as on the Cortex-M4.
+ */
+static inline uint32_t miband_block_diff_word(uint32_t diff) {
+    diff |= diff >> 4;
+    diff |= diff >> 2;
+    diff |= diff >> 1;
+    diff &= 0x01010101U;
+    return ((diff * 0x00204081U) >> 21) & 0xFU;
+}
+
+uint16_t miband_block_diff(const MfClassicBlock* expected, const MfClassicBlock* found) {
+    uint16_t byte_mask = 0;
+
+    for(size_t word = 0; word < MIBAND_BLOCK_DIFF_WORDS; word++) {
+        uint32_t expected_word;
+        uint32_t found_word;
+        // Block data has no alignment guarantee, memcpy compiles to a plain load
+        memcpy(&expected_word, &expected->data[word * sizeof(uint32_t)], sizeof(uint32_t));
+        memcpy(&found_word, &found->data[word * sizeof(uint32_t)], sizeof(uint32_t));
+
+        uint32_t diff = expected_word ^ found_word;
+        if(diff) byte_mask |= miband_block_diff_word(diff) << (word * sizeof(uint32_t));
+    }
+
+    return byte_mask;
+}
+
+uint16_t miband_block_diff_sector(
+    const MfClassicData* expected,
+    const MfClassicData* found,
+    uint8_t sector) {
+    uint8_t first_block = mf_classic_get_first_block_num_of_sector(sector);
+    uint8_t blocks_in_sector = mf_classic_get_blocks_num_in_sector(sector);
+    uint16_t diff_mask = 0;
+
+    // Last block of the sector is the trailer
+    for(uint8_t block_in_sector = 0; block_in_sector < blocks_in_sector - 1; block_in_sector++) {
+        uint8_t block_idx = first_block + block_in_sector;
+        if(block_idx == 0) continue;
+
+        if(miband_block_diff(&expected->block[block_idx], &found->block[block_idx])) {
+            diff_mask |= 1U << block_in_sector;
+        }
+    }
+
+    return diff_mask;
+}
+
+size_t miband_block_diff_collect(
+    const MfClassicData* expected,
+    const MfClassicData* found,
+    MiBandBlockDiff* diffs,
+    size_t max_diffs) {
+    size_t total_blocks = mf_classic_get_total_block_num(expected->type);
+    size_t diff_count = 0;
+
+    for(size_t block_idx = 1; block_idx < total_blocks; block_idx++) {
+        if(mf_classic_is_sector_trailer(block_idx)) continue;
+
+        uint16_t byte_mask =
+            miband_block_diff(&expected->block[block_idx], &found->block[block_idx]);
+        if(!byte_mask) continue;
+
+        if(diffs && diff_count < max_diffs) {
+            diffs[diff_count].block = block_idx;
+            diffs[diff_count].byte_mask = byte_mask;
+        }
+        diff_count++;
+    }
+
+    return diff_count;
+}
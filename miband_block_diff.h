@@ -0,0 +1,77 @@
+/**
+ * @file miband_block_diff.h
+ * @brief Block-by-block comparison of MfClassic dumps
+ *
+ * Shared by verify (match/mismatch count), the diff viewer (byte-level
+ * report) and the writer (delta write: skip blocks the card already holds).
+ *
+ * Blocks are compared as four 32-bit words and each result is a 16-bit
+ * mask, bit N set where byte N differs. A dump comparison is a sparse list
+ * of the differing blocks only, four bytes per entry.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
+
+/**
+ * @brief One differing block of a dump comparison
+ */
+typedef struct {
+    uint16_t block; // Absolute block number, up to 255 on a 4K card
+    uint16_t byte_mask; // Bit N set where byte N differs
+} MiBandBlockDiff;
+
+/**
+ * @brief Compare two blocks
+ *
+ * @param expected Expected block
+ * @param found Block read from the card
+ * @return Mask of differing bytes, bit N = byte N; 0 if the blocks match
+ */
+uint16_t miband_block_diff(const MfClassicBlock* expected, const MfClassicBlock* found);
+
+/**
+ * @brief Get the number of differing bytes of a miband_block_diff() mask
+ *
+ * @param byte_mask Byte mask
+ * @return Number of set bits
+ */
+static inline uint8_t miband_block_diff_count(uint16_t byte_mask) {
+    return __builtin_popcount(byte_mask);
+}
+
+/**
+ * @brief Get the data blocks of a sector that differ between two dumps
+ *
+ * Sector trailers and Block 0 are never reported: trailer keys cannot be
+ * read back and Block 0 is not written.
+ *
+ * @param expected Expected dump
+ * @param found Dump read from the card
+ * @param sector Sector number
+ * @return Mask of differing data blocks, bit N = Nth block of the sector
+ */
+uint16_t miband_block_diff_sector(
+    const MfClassicData* expected,
+    const MfClassicData* found,
+    uint8_t sector);
+
+/**
+ * @brief Collect the differing data blocks of two dumps, in block order
+ *
+ * Skips Block 0 and sector trailers like miband_block_diff_sector(). Call
+ * with diffs NULL to only count, then again with a list of that size.
+ *
+ * @param expected Expected dump, its type sets the block count
+ * @param found Dump read from the card
+ * @param diffs Output list, may be NULL
+ * @param max_diffs Capacity of diffs
+ * @return Number of differing blocks, may exceed max_diffs
+ */
+size_t miband_block_diff_collect(
+    const MfClassicData* expected,
+    const MfClassicData* found,
+    MiBandBlockDiff* diffs,
+    size_t max_diffs);
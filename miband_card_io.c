@@ -0,0 +1,63 @@
+/**
+ * @file miband_card_io.c
+ * @brief Card I/O dispatch to the active backend
+ */
+
+#include "miband_card_io.h"
+
+static const MiBandCardIoBackend* card_io_backend = NULL;
+static void* card_io_context = NULL;
+
+void miband_card_io_set_backend(const MiBandCardIoBackend* backend, void* context) {
+    furi_assert(backend);
+
+    card_io_backend = backend;
+    card_io_context = context;
+}
+
+Iso14443_3aError miband_card_io_activate(Nfc* nfc, Iso14443_3aData* data) {
+    furi_check(card_io_backend);
+    return card_io_backend->activate(card_io_context, nfc, data);
+}
+
+MfClassicError miband_card_io_detect_type(Nfc* nfc, MfClassicType* type) {
+    furi_check(card_io_backend);
+    return card_io_backend->detect_type(card_io_context, nfc, type);
+}
+
+MfClassicError miband_card_io_auth(
+    Nfc* nfc,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicAuthContext* auth_context) {
+    furi_check(card_io_backend);
+    return card_io_backend->auth(card_io_context, nfc, block_num, key, key_type, auth_context);
+}
+
+MfClassicError miband_card_io_read_block(
+    Nfc* nfc,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicBlock* data) {
+    furi_check(card_io_backend);
+    return card_io_backend->read_block(card_io_context, nfc, block_num, key, key_type, data);
+}
+
+MfClassicError miband_card_io_write_block(
+    Nfc* nfc,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicBlock* data) {
+    furi_check(card_io_backend);
+    return card_io_backend->write_block(card_io_context, nfc, block_num, key, key_type, data);
+}
+
+MfClassicError
+    miband_card_io_run_session(Nfc* nfc, MiBandCardIoSessionCallback callback, void* context) {
+    furi_check(card_io_backend);
+    furi_assert(callback);
+    return card_io_backend->run_session(card_io_context, nfc, callback, context);
+}
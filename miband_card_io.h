@@ -0,0 +1,147 @@
+/**
+ * @file miband_card_io.h
+ * @brief Card I/O backend behind every MfClassic exchange of the engines
+ *
+ * Backup, write, verify and their shared helpers (auth cache, card session,
+ * sector sessions) talk to the band only through these functions. The app
+ * installs the NFC backend (miband_card_io_nfc.h) at start; the host harness
+ * in sim/ installs a simulated card instead, so the same sector strategy and
+ * retry policies run on a PC.
+ *
+ * Like miband_op_stats, one backend is active at a time and the calls keep
+ * the Nfc* argument of the mf_classic_poller_sync_* functions they replace.
+ *
+ * A session activates the card once and hands a set of in-session
+ * operations to a callback: on hardware it runs on the NFC worker thread
+ * inside the poller callback, the crypto session lasting until halt.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <nfc/nfc.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
+#include <nfc/protocols/iso14443_3a/iso14443_3a.h>
+
+/**
+ * @brief Operations on an activated card, valid only inside a session callback
+ */
+typedef struct {
+    MfClassicError (*auth)(
+        void* session,
+        uint8_t block_num,
+        MfClassicKey* key,
+        MfClassicKeyType key_type);
+    MfClassicError (*read_block)(void* session, uint8_t block_num, MfClassicBlock* data);
+    MfClassicError (*write_block)(void* session, uint8_t block_num, MfClassicBlock* data);
+    void (*halt)(void* session);
+} MiBandCardIoSessionApi;
+
+/**
+ * @brief Session body
+ *
+ * @param api In-session operations
+ * @param session Backend session handle, passed back to every api call
+ * @param context Caller context
+ * @return Outcome of the session
+ */
+typedef MfClassicError (*MiBandCardIoSessionCallback)(
+    const MiBandCardIoSessionApi* api,
+    void* session,
+    void* context);
+
+/**
+ * @brief Card I/O backend
+ *
+ * Each single-block operation activates and authenticates on its own, as
+ * mf_classic_poller_sync_* does.
+ */
+typedef struct {
+    Iso14443_3aError (*activate)(void* context, Nfc* nfc, Iso14443_3aData* data);
+    MfClassicError (*detect_type)(void* context, Nfc* nfc, MfClassicType* type);
+    MfClassicError (*auth)(
+        void* context,
+        Nfc* nfc,
+        uint8_t block_num,
+        MfClassicKey* key,
+        MfClassicKeyType key_type,
+        MfClassicAuthContext* auth_context);
+    MfClassicError (*read_block)(
+        void* context,
+        Nfc* nfc,
+        uint8_t block_num,
+        MfClassicKey* key,
+        MfClassicKeyType key_type,
+        MfClassicBlock* data);
+    MfClassicError (*write_block)(
+        void* context,
+        Nfc* nfc,
+        uint8_t block_num,
+        MfClassicKey* key,
+        MfClassicKeyType key_type,
+        MfClassicBlock* data);
+    MfClassicError (*run_session)(
+        void* context,
+        Nfc* nfc,
+        MiBandCardIoSessionCallback callback,
+        void* callback_context);
+} MiBandCardIoBackend;
+
+/**
+ * @brief Install the backend used by every following call
+ *
+ * @param backend Backend, must outlive its use
+ * @param context Backend context, passed to every backend call
+ */
+void miband_card_io_set_backend(const MiBandCardIoBackend* backend, void* context);
+
+/**
+ * @brief Anticollision, drop-in for iso14443_3a_poller_sync_read()
+ */
+Iso14443_3aError miband_card_io_activate(Nfc* nfc, Iso14443_3aData* data);
+
+/**
+ * @brief Drop-in for mf_classic_poller_sync_detect_type()
+ */
+MfClassicError miband_card_io_detect_type(Nfc* nfc, MfClassicType* type);
+
+/**
+ * @brief Drop-in for mf_classic_poller_sync_auth()
+ */
+MfClassicError miband_card_io_auth(
+    Nfc* nfc,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicAuthContext* auth_context);
+
+/**
+ * @brief Drop-in for mf_classic_poller_sync_read_block()
+ */
+MfClassicError miband_card_io_read_block(
+    Nfc* nfc,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicBlock* data);
+
+/**
+ * @brief Drop-in for mf_classic_poller_sync_write_block()
+ */
+MfClassicError miband_card_io_write_block(
+    Nfc* nfc,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicBlock* data);
+
+/**
+ * @brief Activate the card and run a session callback on it
+ *
+ * @param nfc NFC instance
+ * @param callback Session body
+ * @param context Callback context
+ * @return Activation error, or the callback's outcome
+ */
+MfClassicError
+    miband_card_io_run_session(Nfc* nfc, MiBandCardIoSessionCallback callback, void* context);
@@ -0,0 +1,160 @@
+/**
+ * @file miband_card_io_nfc.c
+ * @brief Card I/O backend on the Flipper NFC pollers
+ */
+
+#include "miband_card_io_nfc.h"
+#include <nfc/nfc_poller.h>
+#include <nfc/protocols/iso14443_3a/iso14443_3a_poller.h>
+#include <nfc/protocols/iso14443_3a/iso14443_3a_poller_sync.h>
+#include <nfc/protocols/mf_classic/mf_classic_poller_sync.h>
+#include <lib/nfc/protocols/mf_classic/mf_classic_poller.h>
+
+#define CARD_IO_NFC_SESSION_DONE_EVENT (1UL << 0)
+
+/**
+ * @brief State shared with the poller callback for one session
+ */
+typedef struct {
+    MiBandCardIoSessionCallback callback;
+    void* callback_context;
+    FuriThreadId thread_id;
+    MfClassicError error;
+} CardIoNfcSession;
+
+static MfClassicError card_io_nfc_process_error(Iso14443_3aError error) {
+    switch(error) {
+    case Iso14443_3aErrorNone:
+        return MfClassicErrorNone;
+    case Iso14443_3aErrorNotPresent:
+        return MfClassicErrorNotPresent;
+    case Iso14443_3aErrorTimeout:
+        return MfClassicErrorTimeout;
+    default:
+        return MfClassicErrorProtocol;
+    }
+}
+
+static MfClassicError card_io_nfc_session_auth(
+    void* session,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type) {
+    return mf_classic_poller_auth(session, block_num, key, key_type, NULL, false);
+}
+
+static MfClassicError
+    card_io_nfc_session_read_block(void* session, uint8_t block_num, MfClassicBlock* data) {
+    return mf_classic_poller_read_block(session, block_num, data);
+}
+
+static MfClassicError
+    card_io_nfc_session_write_block(void* session, uint8_t block_num, MfClassicBlock* data) {
+    return mf_classic_poller_write_block(session, block_num, data);
+}
+
+static void card_io_nfc_session_halt(void* session) {
+    mf_classic_poller_halt(session);
+}
+
+static const MiBandCardIoSessionApi card_io_nfc_session_api = {
+    .auth = card_io_nfc_session_auth,
+    .read_block = card_io_nfc_session_read_block,
+    .write_block = card_io_nfc_session_write_block,
+    .halt = card_io_nfc_session_halt,
+};
+
+static NfcCommand card_io_nfc_session_callback(NfcGenericEventEx event, void* context) {
+    furi_assert(event.poller);
+    furi_assert(event.parent_event_data);
+    furi_assert(context);
+
+    CardIoNfcSession* ctx = context;
+    Iso14443_3aPollerEvent* iso14443_3a_event = event.parent_event_data;
+
+    if(iso14443_3a_event->type == Iso14443_3aPollerEventTypeReady) {
+        ctx->error = ctx->callback(&card_io_nfc_session_api, event.poller, ctx->callback_context);
+    } else if(iso14443_3a_event->type == Iso14443_3aPollerEventTypeError) {
+        ctx->error = card_io_nfc_process_error(iso14443_3a_event->data->error);
+    }
+
+    furi_thread_flags_set(ctx->thread_id, CARD_IO_NFC_SESSION_DONE_EVENT);
+    return NfcCommandStop;
+}
+
+static MfClassicError card_io_nfc_run_session(
+    void* context,
+    Nfc* nfc,
+    MiBandCardIoSessionCallback callback,
+    void* callback_context) {
+    UNUSED(context);
+    furi_assert(nfc);
+
+    CardIoNfcSession ctx = {
+        .callback = callback,
+        .callback_context = callback_context,
+        .thread_id = furi_thread_get_current_id(),
+        .error = MfClassicErrorNone,
+    };
+
+    NfcPoller* poller = nfc_poller_alloc(nfc, NfcProtocolMfClassic);
+    nfc_poller_start_ex(poller, card_io_nfc_session_callback, &ctx);
+    furi_thread_flags_wait(CARD_IO_NFC_SESSION_DONE_EVENT, FuriFlagWaitAny, FuriWaitForever);
+    furi_thread_flags_clear(CARD_IO_NFC_SESSION_DONE_EVENT);
+    nfc_poller_stop(poller);
+    nfc_poller_free(poller);
+
+    return ctx.error;
+}
+
+static Iso14443_3aError card_io_nfc_activate(void* context, Nfc* nfc, Iso14443_3aData* data) {
+    UNUSED(context);
+    return iso14443_3a_poller_sync_read(nfc, data);
+}
+
+static MfClassicError card_io_nfc_detect_type(void* context, Nfc* nfc, MfClassicType* type) {
+    UNUSED(context);
+    return mf_classic_poller_sync_detect_type(nfc, type);
+}
+
+static MfClassicError card_io_nfc_auth(
+    void* context,
+    Nfc* nfc,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicAuthContext* auth_context) {
+    UNUSED(context);
+    return mf_classic_poller_sync_auth(nfc, block_num, key, key_type, auth_context);
+}
+
+static MfClassicError card_io_nfc_read_block(
+    void* context,
+    Nfc* nfc,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicBlock* data) {
+    UNUSED(context);
+    return mf_classic_poller_sync_read_block(nfc, block_num, key, key_type, data);
+}
+
+static MfClassicError card_io_nfc_write_block(
+    void* context,
+    Nfc* nfc,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicBlock* data) {
+    UNUSED(context);
+    return mf_classic_poller_sync_write_block(nfc, block_num, key, key_type, data);
+}
+
+const MiBandCardIoBackend miband_card_io_nfc = {
+    .activate = card_io_nfc_activate,
+    .detect_type = card_io_nfc_detect_type,
+    .auth = card_io_nfc_auth,
+    .read_block = card_io_nfc_read_block,
+    .write_block = card_io_nfc_write_block,
+    .run_session = card_io_nfc_run_session,
+};
@@ -0,0 +1,14 @@
+/**
+ * @file miband_card_io_nfc.h
+ * @brief Card I/O backend on the Flipper NFC pollers
+ *
+ * Single-block operations map to mf_classic_poller_sync_*, sessions run
+ * on the async MfClassic poller. The backend needs no context.
+ */
+
+#pragma once
+
+#include "miband_card_io.h"
+
+/** Backend to install with miband_card_io_set_backend(&miband_card_io_nfc, NULL) */
+extern const MiBandCardIoBackend miband_card_io_nfc;
@@ -0,0 +1,132 @@
+/**
+ * @file miband_card_session.c
+ * @brief Card session implementation
+ */
+
+#include "miband_card_session.h"
+#include "miband_card_io.h"
+#include "miband_op_stats.h"
+
+#define TAG "MiBandCardSession"
+
+/**
+ * @brief Card session internal structure
+ */
+struct MiBandCardSession {
+    MiBandAuthCache* auth_cache;
+
+    bool active;
+    uint8_t uid[MIBAND_CARD_SESSION_UID_MAX];
+    size_t uid_len;
+
+    bool type_known;
+    MfClassicType type;
+    MiBandCardKeyState key_state;
+};
+
+MiBandCardSession* miband_card_session_alloc(MiBandAuthCache* auth_cache) {
+    furi_assert(auth_cache);
+
+    MiBandCardSession* session = malloc(sizeof(MiBandCardSession));
+    memset(session, 0, sizeof(MiBandCardSession));
+    session->auth_cache = auth_cache;
+    return session;
+}
+
+void miband_card_session_free(MiBandCardSession* session) {
+    free(session);
+}
+
+void miband_card_session_reset(MiBandCardSession* session) {
+    furi_assert(session);
+
+    session->active = false;
+    session->uid_len = 0;
+    session->type_known = false;
+    session->key_state = MiBandCardKeysUnknown;
+}
+
+bool miband_card_session_refresh(MiBandCardSession* session, Nfc* nfc) {
+    furi_assert(session);
+    furi_assert(nfc);
+
+    Iso14443_3aData iso_data = {0};
+    uint32_t start = miband_op_stats_start();
+    Iso14443_3aError iso_error = miband_card_io_activate(nfc, &iso_data);
+    miband_op_stats_record(
+        MiBandOpPhaseDetect,
+        start,
+        iso_error == Iso14443_3aErrorNone ? MfClassicErrorNone : MfClassicErrorNotPresent);
+
+    if(iso_error != Iso14443_3aErrorNone) {
+        if(session->active) FURI_LOG_D(TAG, "Field dropped, session closed");
+        miband_card_session_reset(session);
+        return false;
+    }
+
+    size_t uid_len = MIN(iso_data.uid_len, (size_t)MIBAND_CARD_SESSION_UID_MAX);
+    if(session->active && session->uid_len == uid_len &&
+       memcmp(session->uid, iso_data.uid, uid_len) == 0) {
+        return true;
+    }
+
+    FURI_LOG_D(TAG, "New card session");
+    miband_card_session_reset(session);
+    memcpy(session->uid, iso_data.uid, uid_len);
+    session->uid_len = uid_len;
+    session->active = true;
+
+    // Keys cached for another UID are dropped here
+    miband_auth_cache_bind(session->auth_cache, session->uid, session->uid_len);
+    return true;
+}
+
+bool miband_card_session_is_active(const MiBandCardSession* session) {
+    furi_assert(session);
+    return session->active;
+}
+
+const uint8_t* miband_card_session_get_uid(const MiBandCardSession* session, size_t* uid_len) {
+    furi_assert(session);
+    *uid_len = session->uid_len;
+    return session->uid;
+}
+
+MfClassicError
+    miband_card_session_get_type(MiBandCardSession* session, Nfc* nfc, MfClassicType* type) {
+    furi_assert(session);
+    furi_assert(type);
+
+    if(session->active && session->type_known) {
+        *type = session->type;
+        return MfClassicErrorNone;
+    }
+
+    uint32_t start = miband_op_stats_start();
+    MfClassicError error = miband_card_io_detect_type(nfc, type);
+    miband_op_stats_record(MiBandOpPhaseDetect, start, error);
+    if(error == MfClassicErrorNone && session->active) {
+        session->type = *type;
+        session->type_known = true;
+    }
+    return error;
+}
+
+MiBandCardKeyState miband_card_session_get_key_state(const MiBandCardSession* session) {
+    furi_assert(session);
+    return session->active ? session->key_state : MiBandCardKeysUnknown;
+}
+
+void miband_card_session_set_key_state(MiBandCardSession* session, MiBandCardKeyState key_state) {
+    furi_assert(session);
+    if(session->active) session->key_state = key_state;
+}
+
+MiBandCardKeyState miband_card_session_classify_key(const MfClassicKey* key) {
+    furi_assert(key);
+
+    for(size_t i = 0; i < sizeof(key->data); i++) {
+        if(key->data[i] != 0xFF) return MiBandCardKeysOriginal;
+    }
+    return MiBandCardKeysMagic;
+}
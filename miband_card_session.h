@@ -0,0 +1,125 @@
+/**
+ * @file miband_card_session.h
+ * @brief What is known about the band in the field, shared by chained scenes
+ *
+ * Backup, write and verify each used to run their own scanner pass, type
+ * detection and 0xFF probe auth, so a backup -> write -> verify chain on one
+ * band detected it up to three times. The card session keeps the UID, the
+ * detected type and the magic/original key state of the band in the field,
+ * and binds the auth cache (the last working keys) to the same UID.
+ *
+ * A refresh is a single anticollision. The session is dropped when the band
+ * leaves the field or a different UID answers; only then is anything
+ * detected again.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <nfc/nfc.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
+#include "miband_auth_cache.h"
+
+#define MIBAND_CARD_SESSION_UID_MAX 10
+
+/**
+ * @brief Key state of the band
+ */
+typedef enum {
+    MiBandCardKeysUnknown,
+    MiBandCardKeysMagic, /**< Answers to the 0xFF key (blank or magic-initialized) */
+    MiBandCardKeysOriginal, /**< Uses the dump keys */
+} MiBandCardKeyState;
+
+/**
+ * @brief Card session structure
+ */
+typedef struct MiBandCardSession MiBandCardSession;
+
+/**
+ * @brief Create a card session
+ *
+ * @param auth_cache Auth cache bound to the session's card, not owned
+ * @return Allocated MiBandCardSession instance
+ */
+MiBandCardSession* miband_card_session_alloc(MiBandAuthCache* auth_cache);
+
+/**
+ * @brief Free card session
+ *
+ * @param session Card session instance
+ */
+void miband_card_session_free(MiBandCardSession* session);
+
+/**
+ * @brief Check which band is in the field
+ *
+ * Keeps the session when the same UID answers, drops it when the field is
+ * empty, starts a new one (and rebinds the auth cache) on a different UID.
+ *
+ * @param session Card session instance
+ * @param nfc NFC instance
+ * @return true if a card is in the field
+ */
+bool miband_card_session_refresh(MiBandCardSession* session, Nfc* nfc);
+
+/**
+ * @brief Check whether a band was seen since the field last dropped
+ *
+ * @param session Card session instance
+ * @return true if the session holds a card
+ */
+bool miband_card_session_is_active(const MiBandCardSession* session);
+
+/**
+ * @brief Forget the band, e.g. after it was rewritten or the field dropped
+ *
+ * Cached keys stay in the auth cache, they are UID-bound.
+ *
+ * @param session Card session instance
+ */
+void miband_card_session_reset(MiBandCardSession* session);
+
+/**
+ * @brief Get the UID of the session's band
+ *
+ * @param session Card session instance
+ * @param uid_len UID length output, 0 if no band
+ * @return UID bytes
+ */
+const uint8_t* miband_card_session_get_uid(const MiBandCardSession* session, size_t* uid_len);
+
+/**
+ * @brief Get the MfClassic type, detecting it only the first time
+ *
+ * @param session Card session instance
+ * @param nfc NFC instance
+ * @param type Type output
+ * @return MfClassicError of the detection, MfClassicErrorNone when cached
+ */
+MfClassicError
+    miband_card_session_get_type(MiBandCardSession* session, Nfc* nfc, MfClassicType* type);
+
+/**
+ * @brief Get the key state of the session's band
+ *
+ * @param session Card session instance
+ * @return Key state, MiBandCardKeysUnknown until set
+ */
+MiBandCardKeyState miband_card_session_get_key_state(const MiBandCardSession* session);
+
+/**
+ * @brief Record the key state of the session's band
+ *
+ * @param session Card session instance
+ * @param key_state Key state
+ */
+void miband_card_session_set_key_state(MiBandCardSession* session, MiBandCardKeyState key_state);
+
+/**
+ * @brief Tell which key state a working sector key stands for
+ *
+ * @param key Key that authenticated (or will authenticate) a data sector
+ * @return MiBandCardKeysMagic for the 0xFF key, MiBandCardKeysOriginal otherwise
+ */
+MiBandCardKeyState miband_card_session_classify_key(const MfClassicKey* key);
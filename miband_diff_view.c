@@ -0,0 +1,209 @@
+/**
+ * @file miband_diff_view.c
+ * @brief Paged diff view implementation
+ */
+
+#include "miband_diff_view.h"
+#include <gui/elements.h>
+
+#define MIBAND_DIFF_VIEW_BYTES_PER_ROW 8
+#define MIBAND_DIFF_VIEW_HEX_X         18
+#define MIBAND_DIFF_VIEW_BYTE_WIDTH    13
+
+/**
+ * @brief What the view draws; the dumps are referenced, not copied
+ */
+typedef struct {
+    const MfClassicData* expected;
+    const MfClassicData* found;
+    const MiBandBlockDiff* diffs;
+    size_t diff_count;
+    size_t total_blocks;
+    size_t index;
+} MiBandDiffViewModel;
+
+/**
+ * @brief Diff view internal structure
+ */
+struct MiBandDiffView {
+    View* view;
+    MiBandBlockDiff* diffs; // Owned, passed to the model read-only
+};
+
+/**
+ * @brief Draw one 16-byte block as two hex rows, differing bytes inverted
+ */
+static void miband_diff_view_draw_block(
+    Canvas* canvas,
+    uint8_t y,
+    const char* label,
+    const uint8_t* data,
+    uint16_t byte_mask) {
+    char hex[3];
+
+    canvas_draw_str(canvas, 0, y, label);
+    for(size_t i = 0; i < MF_CLASSIC_BLOCK_SIZE; i++) {
+        uint8_t x = MIBAND_DIFF_VIEW_HEX_X +
+                    (i % MIBAND_DIFF_VIEW_BYTES_PER_ROW) * MIBAND_DIFF_VIEW_BYTE_WIDTH;
+        uint8_t row_y = y + (i / MIBAND_DIFF_VIEW_BYTES_PER_ROW) * 9;
+        bool differs = byte_mask & (1U << i);
+
+        snprintf(hex, sizeof(hex), "%02X", data[i]);
+        if(differs) {
+            canvas_draw_box(canvas, x - 1, row_y - 8, MIBAND_DIFF_VIEW_BYTE_WIDTH - 1, 9);
+            canvas_set_color(canvas, ColorWhite);
+        }
+        canvas_draw_str(canvas, x, row_y, hex);
+        if(differs) canvas_set_color(canvas, ColorBlack);
+    }
+}
+
+static void miband_diff_view_draw_callback(Canvas* canvas, void* _model) {
+    MiBandDiffViewModel* model = _model;
+    char line[32];
+
+    canvas_clear(canvas);
+
+    if(model->diff_count == 0) {
+        canvas_set_font(canvas, FontPrimary);
+        canvas_draw_str_aligned(canvas, 64, 20, AlignCenter, AlignTop, "All blocks match!");
+        canvas_set_font(canvas, FontSecondary);
+        snprintf(line, sizeof(line), "%zu blocks compared", model->total_blocks);
+        canvas_draw_str_aligned(canvas, 64, 34, AlignCenter, AlignTop, line);
+        return;
+    }
+
+    const MiBandBlockDiff* diff = &model->diffs[model->index];
+
+    canvas_set_font(canvas, FontPrimary);
+    snprintf(
+        line,
+        sizeof(line),
+        "Block %u, sector %u",
+        diff->block,
+        mf_classic_get_sector_by_block(diff->block));
+    canvas_draw_str(canvas, 0, 9, line);
+
+    canvas_set_font(canvas, FontSecondary);
+    snprintf(
+        line,
+        sizeof(line),
+        "Diff %zu/%zu: %u bytes",
+        model->index + 1,
+        model->diff_count,
+        miband_block_diff_count(diff->byte_mask));
+    canvas_draw_str(canvas, 0, 19, line);
+
+    canvas_set_font(canvas, FontKeyboard);
+    miband_diff_view_draw_block(
+        canvas, 31, "Exp", model->expected->block[diff->block].data, diff->byte_mask);
+    miband_diff_view_draw_block(
+        canvas, 53, "Got", model->found->block[diff->block].data, diff->byte_mask);
+
+    elements_scrollbar(canvas, model->index, model->diff_count);
+}
+
+static bool miband_diff_view_input_callback(InputEvent* event, void* context) {
+    MiBandDiffView* diff_view = context;
+
+    if(event->type != InputTypeShort && event->type != InputTypeRepeat) return false;
+
+    int32_t step = 0;
+    if(event->key == InputKeyRight) {
+        step = 1;
+    } else if(event->key == InputKeyLeft) {
+        step = -1;
+    } else if(event->key == InputKeyDown) {
+        step = MIBAND_DIFF_VIEW_PAGE_JUMP;
+    } else if(event->key == InputKeyUp) {
+        step = -MIBAND_DIFF_VIEW_PAGE_JUMP;
+    } else {
+        return false;
+    }
+
+    with_view_model(
+        diff_view->view,
+        MiBandDiffViewModel * model,
+        {
+            if(model->diff_count > 0) {
+                int32_t index = (int32_t)model->index + step;
+                index = CLAMP(index, (int32_t)model->diff_count - 1, 0);
+                model->index = index;
+            }
+        },
+        true);
+    return true;
+}
+
+MiBandDiffView* miband_diff_view_alloc(void) {
+    MiBandDiffView* diff_view = malloc(sizeof(MiBandDiffView));
+    diff_view->diffs = NULL;
+
+    diff_view->view = view_alloc();
+    view_allocate_model(diff_view->view, ViewModelTypeLocking, sizeof(MiBandDiffViewModel));
+    view_set_context(diff_view->view, diff_view);
+    view_set_draw_callback(diff_view->view, miband_diff_view_draw_callback);
+    view_set_input_callback(diff_view->view, miband_diff_view_input_callback);
+
+    miband_diff_view_reset(diff_view);
+    return diff_view;
+}
+
+void miband_diff_view_free(MiBandDiffView* diff_view) {
+    furi_assert(diff_view);
+
+    miband_diff_view_reset(diff_view);
+    view_free(diff_view->view);
+    free(diff_view);
+}
+
+View* miband_diff_view_get_view(MiBandDiffView* diff_view) {
+    furi_assert(diff_view);
+    return diff_view->view;
+}
+
+size_t miband_diff_view_load(
+    MiBandDiffView* diff_view,
+    const MfClassicData* expected,
+    const MfClassicData* found) {
+    furi_assert(diff_view);
+    furi_assert(expected);
+    furi_assert(found);
+
+    miband_diff_view_reset(diff_view);
+
+    // Count first so the list holds the differing blocks only
+    size_t diff_count = miband_block_diff_collect(expected, found, NULL, 0);
+    if(diff_count > 0) {
+        diff_view->diffs = malloc(sizeof(MiBandBlockDiff) * diff_count);
+        miband_block_diff_collect(expected, found, diff_view->diffs, diff_count);
+    }
+
+    with_view_model(
+        diff_view->view,
+        MiBandDiffViewModel * model,
+        {
+            model->expected = expected;
+            model->found = found;
+            model->diffs = diff_view->diffs;
+            model->diff_count = diff_count;
+            model->total_blocks = mf_classic_get_total_block_num(expected->type);
+            model->index = 0;
+        },
+        true);
+
+    return diff_count;
+}
+
+void miband_diff_view_reset(MiBandDiffView* diff_view) {
+    furi_assert(diff_view);
+
+    with_view_model(
+        diff_view->view,
+        MiBandDiffViewModel * model,
+        { memset(model, 0, sizeof(MiBandDiffViewModel)); },
+        false);
+
+    free(diff_view->diffs);
+    diff_view->diffs = NULL;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file miband_diff_view.h
+ * @brief Paged view of the blocks that differ between two dumps
+ *
+ * The view keeps only the sparse comparison list (miband_block_diff_collect)
+ * and draws the block on screen straight from both dumps, one block per
+ * page, so every difference of a 4K card can be browsed without formatting
+ * a report up front. Left/Right step one block, Up/Down ten; Back is left
+ * to the scene.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <gui/view.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
+#include "miband_block_diff.h"
+
+#define MIBAND_DIFF_VIEW_PAGE_JUMP 10
+
+/**
+ * @brief Diff view structure
+ */
+typedef struct MiBandDiffView MiBandDiffView;
+
+/**
+ * @brief Create a diff view
+ *
+ * @return Allocated MiBandDiffView instance
+ */
+MiBandDiffView* miband_diff_view_alloc(void);
+
+/**
+ * @brief Free diff view
+ *
+ * @param diff_view Diff view instance
+ */
+void miband_diff_view_free(MiBandDiffView* diff_view);
+
+/**
+ * @brief Get the view for the view dispatcher
+ *
+ * @param diff_view Diff view instance
+ * @return View
+ */
+View* miband_diff_view_get_view(MiBandDiffView* diff_view);
+
+/**
+ * @brief Compare two dumps and show the first difference
+ *
+ * Both dumps are read while drawing and must outlive the view's use, up
+ * to miband_diff_view_reset().
+ *
+ * @param diff_view Diff view instance
+ * @param expected Expected dump
+ * @param found Dump read from the card
+ * @return Number of differing blocks
+ */
+size_t miband_diff_view_load(
+    MiBandDiffView* diff_view,
+    const MfClassicData* expected,
+    const MfClassicData* found);
+
+/**
+ * @brief Drop the comparison and the dump references
+ *
+ * @param diff_view Diff view instance
+ */
+void miband_diff_view_reset(MiBandDiffView* diff_view);
@@ -0,0 +1,139 @@
+/**
+ * @file miband_dir_walker.c
+ * @brief Recursive directory walk implementation
+ */
+
+#include "miband_dir_walker.h"
+
+#define TAG "MiBandDirWalker"
+
+#define MIBAND_DIR_WALKER_PENDING_MAX 128
+#define MIBAND_DIR_WALKER_NAME_MAX    128
+
+typedef struct {
+    FuriString* path;
+    uint32_t mtime;
+    uint8_t depth;
+} MiBandDirWalkerDir;
+
+typedef struct {
+    MiBandDirWalkerDir dirs[MIBAND_DIR_WALKER_PENDING_MAX];
+    size_t count;
+} MiBandDirWalkerStack;
+
+static bool miband_dir_walker_push(
+    MiBandDirWalkerStack* stack,
+    const FuriString* path,
+    uint32_t mtime,
+    uint8_t depth) {
+    if(stack->count >= MIBAND_DIR_WALKER_PENDING_MAX) {
+        FURI_LOG_W(TAG, "Too many pending dirs, skipping %s", furi_string_get_cstr(path));
+        return false;
+    }
+
+    MiBandDirWalkerDir* dir = &stack->dirs[stack->count++];
+    dir->path = furi_string_alloc_set(path);
+    dir->mtime = mtime;
+    dir->depth = depth;
+    return true;
+}
+
+/**
+ * @brief Order the dirs pushed since `first` so the newest is popped first
+ *
+ * Insertion sort by ascending mtime, sibling counts are small.
+ */
+static void miband_dir_walker_sort_children(MiBandDirWalkerStack* stack, size_t first) {
+    for(size_t i = first + 1; i < stack->count; i++) {
+        MiBandDirWalkerDir dir = stack->dirs[i];
+        size_t j = i;
+        while(j > first && stack->dirs[j - 1].mtime > dir.mtime) {
+            stack->dirs[j] = stack->dirs[j - 1];
+            j--;
+        }
+        stack->dirs[j] = dir;
+    }
+}
+
+static bool miband_dir_walker_has_extension(const char* name, const char* extension) {
+    size_t name_len = strlen(name);
+    size_t ext_len = strlen(extension);
+    return name_len > ext_len && strcasecmp(&name[name_len - ext_len], extension) == 0;
+}
+
+bool miband_dir_walk(
+    Storage* storage,
+    const char* root,
+    const char* skip,
+    const char* extension,
+    MiBandDirWalkerCallback callback,
+    void* context) {
+    furi_assert(storage);
+    furi_assert(root);
+    furi_assert(extension);
+    furi_assert(callback);
+
+    // Kept on the heap: the walker runs on small worker stacks
+    MiBandDirWalkerStack* stack = malloc(sizeof(MiBandDirWalkerStack));
+    stack->count = 0;
+
+    File* dir = storage_file_alloc(storage);
+    FuriString* path = furi_string_alloc();
+    FileInfo file_info;
+    char name[MIBAND_DIR_WALKER_NAME_MAX];
+    bool complete = true;
+    bool root_ok = false;
+
+    furi_string_set_str(path, root);
+    miband_dir_walker_push(stack, path, 0, 0);
+
+    while(stack->count > 0 && complete) {
+        MiBandDirWalkerDir current = stack->dirs[--stack->count];
+
+        if(!storage_dir_open(dir, furi_string_get_cstr(current.path))) {
+            FURI_LOG_W(TAG, "Cannot open %s", furi_string_get_cstr(current.path));
+            storage_dir_close(dir);
+            furi_string_free(current.path);
+            continue;
+        }
+        if(current.depth == 0) root_ok = true;
+
+        size_t first_child = stack->count;
+        while(storage_dir_read(dir, &file_info, name, sizeof(name))) {
+            if(name[0] == '.') continue;
+
+            furi_string_printf(path, "%s/%s", furi_string_get_cstr(current.path), name);
+
+            if(file_info.flags & FSF_DIRECTORY) {
+                if(current.depth >= MIBAND_DIR_WALKER_DEPTH_MAX) continue;
+                if(skip && furi_string_equal_str(path, skip)) continue;
+
+                uint32_t mtime = 0;
+                storage_common_timestamp(storage, furi_string_get_cstr(path), &mtime);
+                miband_dir_walker_push(stack, path, mtime, current.depth + 1);
+                continue;
+            }
+
+            if(!miband_dir_walker_has_extension(name, extension)) continue;
+
+            if(!callback(furi_string_get_cstr(path), &file_info, context)) {
+                complete = false;
+                break;
+            }
+        }
+
+        storage_dir_close(dir);
+        furi_string_free(current.path);
+        miband_dir_walker_sort_children(stack, first_child);
+    }
+
+    while(stack->count > 0) {
+        furi_string_free(stack->dirs[--stack->count].path);
+    }
+
+    furi_string_free(path);
+    storage_file_free(dir);
+    free(stack);
+
+    return complete && root_ok;
+}
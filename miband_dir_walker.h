@@ -0,0 +1,51 @@
+/**
+ * @file miband_dir_walker.h
+ * @brief Recursive directory walk with an explicit stack
+ *
+ * Walks a folder tree without recursion: pending directories live on a
+ * heap stack, so the walk depth does not cost thread stack. Each directory
+ * is listed completely and closed before its children are visited, keeping
+ * a single directory handle open at a time.
+ *
+ * Subdirectories are visited most recently modified first: a folder that
+ * just received a dump is the likeliest to hold the one being looked for.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+
+/** Directories below the root that are still descended into */
+#define MIBAND_DIR_WALKER_DEPTH_MAX 8
+
+/**
+ * @brief File callback
+ *
+ * @param path Full path of the file
+ * @param info File info from the directory listing
+ * @param context User context
+ * @return false to stop the walk
+ */
+typedef bool (*MiBandDirWalkerCallback)(const char* path, const FileInfo* info, void* context);
+
+/**
+ * @brief Walk a folder tree and report every file with a given extension
+ *
+ * Hidden entries (leading '.') are skipped.
+ *
+ * @param storage Storage API instance
+ * @param root Folder to start from
+ * @param skip Folder left out together with everything below it, NULL for none
+ * @param extension File extension to report, matched case-insensitively
+ * @param callback File callback
+ * @param context Callback context
+ * @return true if the whole tree was walked, false if stopped or root unreadable
+ */
+bool miband_dir_walk(
+    Storage* storage,
+    const char* root,
+    const char* skip,
+    const char* extension,
+    MiBandDirWalkerCallback callback,
+    void* context);
@@ -0,0 +1,147 @@
+/**
+ * @file miband_dump_cache.c
+ * @brief Parsed dump cache implementation
+ */
+
+#include "miband_dump_cache.h"
+
+#define TAG "MiBandDumpCache"
+
+/**
+ * @brief One cached dump
+ */
+typedef struct {
+    FuriString* path; // Empty when the slot is free
+    uint32_t mtime;
+    uint32_t last_used; // Use counter of the cache at the last get/put
+    MfClassicData* data;
+} MiBandDumpCacheEntry;
+
+struct MiBandDumpCache {
+    MiBandDumpCacheEntry entries[MIBAND_DUMP_CACHE_SIZE];
+    uint32_t use_counter;
+};
+
+static bool miband_dump_cache_is_used(const MiBandDumpCacheEntry* entry) {
+    return !furi_string_empty(entry->path);
+}
+
+static MiBandDumpCacheEntry* miband_dump_cache_find(MiBandDumpCache* cache, const char* path) {
+    for(size_t i = 0; i < MIBAND_DUMP_CACHE_SIZE; i++) {
+        MiBandDumpCacheEntry* entry = &cache->entries[i];
+        if(miband_dump_cache_is_used(entry) && furi_string_equal_str(entry->path, path)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void miband_dump_cache_drop(MiBandDumpCacheEntry* entry) {
+    furi_string_reset(entry->path);
+    entry->last_used = 0;
+}
+
+MiBandDumpCache* miband_dump_cache_alloc(void) {
+    MiBandDumpCache* cache = malloc(sizeof(MiBandDumpCache));
+    memset(cache, 0, sizeof(MiBandDumpCache));
+
+    // Dumps are allocated on first use, an unused cache costs a few bytes
+    for(size_t i = 0; i < MIBAND_DUMP_CACHE_SIZE; i++) {
+        cache->entries[i].path = furi_string_alloc();
+    }
+    return cache;
+}
+
+void miband_dump_cache_free(MiBandDumpCache* cache) {
+    furi_assert(cache);
+
+    for(size_t i = 0; i < MIBAND_DUMP_CACHE_SIZE; i++) {
+        furi_string_free(cache->entries[i].path);
+        if(cache->entries[i].data) mf_classic_free(cache->entries[i].data);
+    }
+    free(cache);
+}
+
+bool miband_dump_cache_get(
+    MiBandDumpCache* cache,
+    Storage* storage,
+    const char* path,
+    MfClassicData* data) {
+    furi_assert(cache);
+    furi_assert(path);
+    furi_assert(data);
+
+    MiBandDumpCacheEntry* entry = miband_dump_cache_find(cache, path);
+    if(!entry) return false;
+
+    uint32_t mtime = 0;
+    if(storage_common_timestamp(storage, path, &mtime) != FSE_OK || mtime != entry->mtime) {
+        FURI_LOG_D(TAG, "Stale: %s", path);
+        miband_dump_cache_drop(entry);
+        return false;
+    }
+
+    mf_classic_copy(data, entry->data);
+    entry->last_used = ++cache->use_counter;
+    FURI_LOG_D(TAG, "Hit: %s", path);
+    return true;
+}
+
+void miband_dump_cache_put(
+    MiBandDumpCache* cache,
+    Storage* storage,
+    const char* path,
+    const MfClassicData* data) {
+    furi_assert(cache);
+    furi_assert(path);
+    furi_assert(data);
+
+    uint32_t mtime = 0;
+    if(storage_common_timestamp(storage, path, &mtime) != FSE_OK) return;
+
+    MiBandDumpCacheEntry* entry = miband_dump_cache_find(cache, path);
+    if(!entry) {
+        // Free slots have last_used 0, so they go before any eviction
+        entry = &cache->entries[0];
+        for(size_t i = 1; i < MIBAND_DUMP_CACHE_SIZE; i++) {
+            if(cache->entries[i].last_used < entry->last_used) entry = &cache->entries[i];
+        }
+        furi_string_set_str(entry->path, path);
+    }
+
+    if(!entry->data) entry->data = mf_classic_alloc();
+    mf_classic_copy(entry->data, data);
+    entry->mtime = mtime;
+    entry->last_used = ++cache->use_counter;
+}
+
+size_t miband_dump_cache_get_count(const MiBandDumpCache* cache) {
+    furi_assert(cache);
+
+    size_t count = 0;
+    for(size_t i = 0; i < MIBAND_DUMP_CACHE_SIZE; i++) {
+        if(miband_dump_cache_is_used(&cache->entries[i])) count++;
+    }
+    return count;
+}
+
+const char* miband_dump_cache_get_path(const MiBandDumpCache* cache, size_t index) {
+    furi_assert(cache);
+
+    // Rank by recency: the entry with exactly `index` more recent ones
+    for(size_t i = 0; i < MIBAND_DUMP_CACHE_SIZE; i++) {
+        const MiBandDumpCacheEntry* entry = &cache->entries[i];
+        if(!miband_dump_cache_is_used(entry)) continue;
+
+        size_t newer = 0;
+        for(size_t j = 0; j < MIBAND_DUMP_CACHE_SIZE; j++) {
+            if(miband_dump_cache_is_used(&cache->entries[j]) &&
+               cache->entries[j].last_used > entry->last_used) {
+                newer++;
+            }
+        }
+        if(newer == index) return furi_string_get_cstr(entry->path);
+    }
+
+    return NULL;
+}
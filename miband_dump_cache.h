@@ -0,0 +1,84 @@
+/**
+ * @file miband_dump_cache.h
+ * @brief Small LRU cache of parsed dumps, keyed by path and mtime
+ *
+ * Parsing a text .nfc from SD is the slow part of every flow. The cache
+ * keeps the last few parsed MfClassicData in RAM; a lookup only stats the
+ * file and copies the dump when the modification time still matches. The
+ * cached paths, most recent first, double as the "Recent Dumps" list.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
+
+#define MIBAND_DUMP_CACHE_SIZE 3 // About 4.5 KB of heap per parsed 4K dump
+
+/**
+ * @brief Dump cache structure
+ */
+typedef struct MiBandDumpCache MiBandDumpCache;
+
+/**
+ * @brief Create an empty dump cache
+ *
+ * @return Allocated MiBandDumpCache instance
+ */
+MiBandDumpCache* miband_dump_cache_alloc(void);
+
+/**
+ * @brief Free dump cache
+ *
+ * @param cache Dump cache instance
+ */
+void miband_dump_cache_free(MiBandDumpCache* cache);
+
+/**
+ * @brief Get a dump if it is cached and the file did not change since
+ *
+ * A stale entry (different mtime or file gone) is dropped.
+ *
+ * @param cache Dump cache instance
+ * @param storage Storage instance
+ * @param path Dump path
+ * @param data Output, filled on a hit
+ * @return true on a hit
+ */
+bool miband_dump_cache_get(
+    MiBandDumpCache* cache,
+    Storage* storage,
+    const char* path,
+    MfClassicData* data);
+
+/**
+ * @brief Store a freshly parsed dump, evicting the least recently used one
+ *
+ * @param cache Dump cache instance
+ * @param storage Storage instance
+ * @param path Dump path
+ * @param data Parsed dump, copied
+ */
+void miband_dump_cache_put(
+    MiBandDumpCache* cache,
+    Storage* storage,
+    const char* path,
+    const MfClassicData* data);
+
+/**
+ * @brief Get the number of cached dumps
+ *
+ * @param cache Dump cache instance
+ * @return Number of entries
+ */
+size_t miband_dump_cache_get_count(const MiBandDumpCache* cache);
+
+/**
+ * @brief Get a cached path by recency
+ *
+ * @param cache Dump cache instance
+ * @param index 0 = most recently used, below miband_dump_cache_get_count()
+ * @return Path, valid until the cache is next modified; NULL if out of range
+ */
+const char* miband_dump_cache_get_path(const MiBandDumpCache* cache, size_t index);
@@ -0,0 +1,209 @@
+/**
+ * @file miband_dump_sidecar.c
+ * @brief Binary dump sidecar implementation
+ */
+
+#include "miband_dump_sidecar.h"
+#include "miband_hash.h"
+
+#define TAG "MiBandSidecar"
+
+#define MIBAND_DUMP_SIDECAR_MAGIC     "MBDS"
+#define MIBAND_DUMP_SIDECAR_VERSION   1
+#define MIBAND_DUMP_SIDECAR_EXTENSION ".mbd"
+#define MIBAND_DUMP_SIDECAR_PATH_MAX  256
+#define MIBAND_DUMP_SIDECAR_UID_MAX   10
+
+/**
+ * @brief On-disk header, followed by path_len bytes of source path and the blocks
+ */
+typedef struct {
+    char magic[4];
+    uint16_t version;
+    uint16_t path_len;
+    uint32_t source_mtime;
+    uint32_t source_size;
+    uint32_t checksum; // miband_hash_dump() of type and blocks
+    uint8_t type; // MfClassicType
+    uint8_t uid_len;
+    uint8_t uid[MIBAND_DUMP_SIDECAR_UID_MAX];
+    uint8_t atqa[2];
+    uint8_t sak;
+    uint8_t reserved[3];
+    uint64_t key_a_mask;
+    uint64_t key_b_mask;
+    uint32_t block_read_mask[MF_CLASSIC_TOTAL_BLOCKS_MAX / 32];
+} MiBandDumpSidecarHeader;
+
+/**
+ * @brief Build the sidecar path: cache folder + source name + full path hash with .mbd
+ *
+ * The hash keeps same-named dumps of different folders apart, the name keeps
+ * the cache folder readable.
+ */
+static void miband_dump_sidecar_path(const char* src_path, FuriString* sidecar_path) {
+    const char* name = strrchr(src_path, '/');
+    name = name ? name + 1 : src_path;
+    const char* ext = strrchr(name, '.');
+    int name_len = ext ? (int)(ext - name) : (int)strlen(name);
+
+    furi_string_printf(
+        sidecar_path,
+        "%s/%.*s_%08lX%s",
+        MIBAND_DUMP_SIDECAR_FOLDER,
+        name_len,
+        name,
+        miband_hash_str(src_path),
+        MIBAND_DUMP_SIDECAR_EXTENSION);
+}
+
+static bool miband_dump_sidecar_stat_source(
+    Storage* storage,
+    const char* src_path,
+    uint32_t* mtime,
+    uint32_t* size) {
+    FileInfo info;
+    if(storage_common_stat(storage, src_path, &info) != FSE_OK) return false;
+    if(storage_common_timestamp(storage, src_path, mtime) != FSE_OK) return false;
+    *size = (uint32_t)info.size;
+    return true;
+}
+
+bool miband_dump_sidecar_load(Storage* storage, const char* src_path, MfClassicData* data) {
+    furi_assert(storage);
+    furi_assert(src_path);
+    furi_assert(data);
+
+    uint32_t mtime = 0;
+    uint32_t size = 0;
+    if(!miband_dump_sidecar_stat_source(storage, src_path, &mtime, &size)) return false;
+
+    FuriString* sidecar_path = furi_string_alloc();
+    miband_dump_sidecar_path(src_path, sidecar_path);
+
+    File* file = storage_file_alloc(storage);
+    char* stored_path = malloc(MIBAND_DUMP_SIDECAR_PATH_MAX);
+    MiBandDumpSidecarHeader header;
+    bool success = false;
+
+    do {
+        if(!storage_file_open(
+               file, furi_string_get_cstr(sidecar_path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+            break;
+        }
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(memcmp(header.magic, MIBAND_DUMP_SIDECAR_MAGIC, sizeof(header.magic)) != 0 ||
+           header.version != MIBAND_DUMP_SIDECAR_VERSION) {
+            FURI_LOG_D(TAG, "Unknown sidecar format");
+            break;
+        }
+        if(header.source_mtime != mtime || header.source_size != size) {
+            FURI_LOG_D(TAG, "Sidecar stale");
+            break;
+        }
+
+        // Guards against two source paths with the same hash
+        size_t src_len = strlen(src_path);
+        if(header.path_len != src_len || src_len >= MIBAND_DUMP_SIDECAR_PATH_MAX) break;
+        if(storage_file_read(file, stored_path, header.path_len) != header.path_len) break;
+        if(memcmp(stored_path, src_path, src_len) != 0) break;
+
+        if(header.type >= MfClassicTypeNum || header.uid_len > MIBAND_DUMP_SIDECAR_UID_MAX) {
+            break;
+        }
+
+        // Blocks go straight into the dump, no parsing
+        mf_classic_reset(data);
+        data->type = header.type;
+        size_t blocks_size = mf_classic_get_total_block_num(data->type) * sizeof(MfClassicBlock);
+        if(storage_file_read(file, data->block, blocks_size) != blocks_size) break;
+        if(miband_hash_dump(data) != header.checksum) {
+            FURI_LOG_W(TAG, "Sidecar checksum mismatch");
+            break;
+        }
+
+        iso14443_3a_set_uid(data->iso14443_3a_data, header.uid, header.uid_len);
+        iso14443_3a_set_atqa(data->iso14443_3a_data, header.atqa);
+        iso14443_3a_set_sak(data->iso14443_3a_data, header.sak);
+        data->key_a_mask = header.key_a_mask;
+        data->key_b_mask = header.key_b_mask;
+        memcpy(data->block_read_mask, header.block_read_mask, sizeof(data->block_read_mask));
+
+        success = true;
+    } while(false);
+
+    storage_file_close(file);
+    storage_file_free(file);
+    free(stored_path);
+    furi_string_free(sidecar_path);
+
+    if(success) FURI_LOG_D(TAG, "Loaded sidecar of %s", src_path);
+    return success;
+}
+
+bool miband_dump_sidecar_save(Storage* storage, const char* src_path, const MfClassicData* data) {
+    furi_assert(storage);
+    furi_assert(src_path);
+    furi_assert(data);
+
+    size_t src_len = strlen(src_path);
+    if(src_len >= MIBAND_DUMP_SIDECAR_PATH_MAX) return false;
+
+    MiBandDumpSidecarHeader header;
+    memset(&header, 0, sizeof(header));
+    if(!miband_dump_sidecar_stat_source(
+           storage, src_path, &header.source_mtime, &header.source_size)) {
+        return false;
+    }
+
+    memcpy(header.magic, MIBAND_DUMP_SIDECAR_MAGIC, sizeof(header.magic));
+    header.version = MIBAND_DUMP_SIDECAR_VERSION;
+    header.path_len = src_len;
+    header.checksum = miband_hash_dump(data);
+    header.type = data->type;
+
+    size_t uid_len = 0;
+    const uint8_t* uid = iso14443_3a_get_uid(data->iso14443_3a_data, &uid_len);
+    header.uid_len = MIN(uid_len, (size_t)MIBAND_DUMP_SIDECAR_UID_MAX);
+    memcpy(header.uid, uid, header.uid_len);
+    memcpy(header.atqa, data->iso14443_3a_data->atqa, sizeof(header.atqa));
+    header.sak = data->iso14443_3a_data->sak;
+    header.key_a_mask = data->key_a_mask;
+    header.key_b_mask = data->key_b_mask;
+    memcpy(header.block_read_mask, data->block_read_mask, sizeof(header.block_read_mask));
+
+    storage_simply_mkdir(storage, EXT_PATH("apps_data"));
+    storage_simply_mkdir(storage, EXT_PATH("apps_data/miband_nfc"));
+    storage_simply_mkdir(storage, MIBAND_DUMP_SIDECAR_FOLDER);
+
+    FuriString* sidecar_path = furi_string_alloc();
+    miband_dump_sidecar_path(src_path, sidecar_path);
+    FuriString* tmp_path = furi_string_alloc_printf("%s.tmp", furi_string_get_cstr(sidecar_path));
+
+    File* file = storage_file_alloc(storage);
+    size_t blocks_size = mf_classic_get_total_block_num(data->type) * sizeof(MfClassicBlock);
+    bool success =
+        storage_file_open(file, furi_string_get_cstr(tmp_path), FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+        storage_file_write(file, &header, sizeof(header)) == sizeof(header) &&
+        storage_file_write(file, src_path, src_len) == src_len &&
+        storage_file_write(file, data->block, blocks_size) == blocks_size;
+    storage_file_close(file);
+    storage_file_free(file);
+
+    // Replace the old sidecar only once the new one is complete
+    if(success) {
+        storage_common_remove(storage, furi_string_get_cstr(sidecar_path));
+        success = storage_common_rename(
+                      storage,
+                      furi_string_get_cstr(tmp_path),
+                      furi_string_get_cstr(sidecar_path)) == FSE_OK;
+    }
+    if(!success) {
+        storage_common_remove(storage, furi_string_get_cstr(tmp_path));
+        FURI_LOG_W(TAG, "Cannot write sidecar of %s", src_path);
+    }
+
+    furi_string_free(tmp_path);
+    furi_string_free(sidecar_path);
+    return success;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file miband_dump_sidecar.h
+ * @brief Binary copy of a parsed .nfc dump, loaded without parsing
+ *
+ * The sidecar of <folder>/<name>.nfc is
+ * MIBAND_DUMP_SIDECAR_FOLDER/<name>_<hash>.mbd, hash being the FNV-1a of the
+ * full source path, so same-named dumps of different folders get their own
+ * sidecar. It holds a fixed, versioned header (source path, mtime and size,
+ * type, UID, ATQA/SAK, key and read masks, checksum) followed by the raw
+ * 16-byte blocks, which are read straight into MfClassicData. A sidecar is only
+ * used while the source file still has the recorded mtime and size, and
+ * its blocks match the checksum.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
+
+#define MIBAND_DUMP_SIDECAR_FOLDER EXT_PATH("apps_data/miband_nfc/cache")
+
+/**
+ * @brief Load a dump from its sidecar
+ *
+ * @param storage Storage instance
+ * @param src_path Path of the .nfc dump
+ * @param data Output, only valid when true is returned
+ * @return true if a valid, up-to-date sidecar was loaded
+ */
+bool miband_dump_sidecar_load(Storage* storage, const char* src_path, MfClassicData* data);
+
+/**
+ * @brief Write the sidecar of a freshly parsed dump
+ *
+ * @param storage Storage instance
+ * @param src_path Path of the .nfc dump the data was parsed from
+ * @param data Parsed dump
+ * @return true on success
+ */
+bool miband_dump_sidecar_save(Storage* storage, const char* src_path, const MfClassicData* data);
@@ -0,0 +1,31 @@
+/**
+ * @file miband_hash.c
+ * @brief FNV-1a hashing implementation
+ */
+
+#include "miband_hash.h"
+
+#define MIBAND_HASH_PRIME 0x01000193U
+
+uint32_t miband_hash_fnv1a(uint32_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = data;
+    for(size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= MIBAND_HASH_PRIME;
+    }
+    return hash;
+}
+
+uint32_t miband_hash_str(const char* str) {
+    furi_assert(str);
+    return miband_hash_fnv1a(MIBAND_HASH_INIT, str, strlen(str));
+}
+
+uint32_t miband_hash_dump(const MfClassicData* data) {
+    furi_assert(data);
+
+    uint8_t type = data->type;
+    uint32_t hash = miband_hash_fnv1a(MIBAND_HASH_INIT, &type, sizeof(type));
+    size_t total_blocks = mf_classic_get_total_block_num(data->type);
+    return miband_hash_fnv1a(hash, data->block, total_blocks * sizeof(MfClassicBlock));
+}
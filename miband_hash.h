@@ -0,0 +1,43 @@
+/**
+ * @file miband_hash.h
+ * @brief FNV-1a hashing of paths and dump contents
+ *
+ * One implementation for every module that keys files by a hash: the write
+ * checkpoint identifies the dump being written, the dump sidecar names its
+ * files after the source path and checks its blocks. Values end up on SD,
+ * so changing the hash invalidates checkpoints and sidecars alike.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
+
+/** Initial value of a 32-bit FNV-1a hash */
+#define MIBAND_HASH_INIT 0x811C9DC5U
+
+/**
+ * @brief Feed bytes into a 32-bit FNV-1a hash
+ *
+ * @param hash MIBAND_HASH_INIT, or the result of a previous call
+ * @param data Bytes to hash
+ * @param size Number of bytes
+ * @return Updated hash
+ */
+uint32_t miband_hash_fnv1a(uint32_t hash, const void* data, size_t size);
+
+/**
+ * @brief Hash a NUL-terminated string
+ *
+ * @param str String to hash
+ * @return FNV-1a hash of the string, terminator excluded
+ */
+uint32_t miband_hash_str(const char* str);
+
+/**
+ * @brief Hash the content of a dump
+ *
+ * @param data Dump
+ * @return FNV-1a hash of the card type and all blocks
+ */
+uint32_t miband_hash_dump(const MfClassicData* data);
@@ -10,6 +10,212 @@
 
 #define TAG "MiBandLogger"
 
+#define LOGGER_THREAD_STACK_SIZE 2048
+#define LOGGER_FLUSH_INTERVAL_MS 250
+#define LOGGER_FLAG_STOP         (1UL << 0)
+#define LOGGER_BATCH_SIZE        512
+#define LOGGER_READ_CHUNK        256
+#define LOGGER_LINE_SIZE         160
+
+#define LOGGER_FILE_MAGIC   "MBLG"
+#define LOGGER_FILE_VERSION 1
+
+/**
+ * @brief Log file header, followed by records
+ *
+ * A MiBandLogEventText record is followed by one length byte and the text.
+ */
+typedef struct {
+    char magic[4];
+    uint8_t version;
+    uint8_t reserved[3];
+} LoggerFileHeader;
+
+/**
+ * @brief Queued free-text entry
+ */
+typedef struct {
+    MiBandLogRecord record;
+    char message[MAX_LOG_TEXT];
+} LoggerText;
+
+/**
+ * @brief Buffered reader used by export
+ */
+typedef struct {
+    File* file;
+    uint8_t buffer[LOGGER_READ_CHUNK];
+    size_t pos;
+    size_t len;
+} LoggerReader;
+
+/**
+ * @brief Logger internal structure
+ */
+struct MiBandLogger {
+    Storage* storage;
+    bool enabled;
+    uint16_t seq; // Bumped without a lock; a race only swaps two entries on export
+
+    FuriMessageQueue* records; // MiBandLogRecord copies, filled by any thread
+    FuriMessageQueue* texts; // LoggerText copies, filled by any thread
+    FuriThread* thread;
+    volatile bool running;
+    uint32_t dropped;
+
+    FuriMutex* file_mutex; // Guards everything below
+    File* file; // LOG_FILE, opened on the first flush
+    MiBandLogRecord pending_record;
+    LoggerText pending_text;
+    bool has_pending_record;
+    bool has_pending_text;
+    uint8_t batch[LOGGER_BATCH_SIZE];
+    size_t batch_len;
+    size_t count;
+};
+
+static const char* const logger_event_names[MiBandLogEventCount] = {
+    [MiBandLogEventText] = "",
+    [MiBandLogEventAuth] = "Auth",
+    [MiBandLogEventAuthFailed] = "Auth failed",
+    [MiBandLogEventReadFailed] = "Read failed",
+    [MiBandLogEventWriteFailed] = "Write failed",
+    [MiBandLogEventVerifyMismatch] = "Verify mismatch",
+};
+
+static const char* logger_level_str(uint8_t level) {
+    switch(level) {
+    case LogLevelDebug:
+        return "DEBUG";
+    case LogLevelInfo:
+        return "INFO ";
+    case LogLevelWarning:
+        return "WARN ";
+    case LogLevelError:
+        return "ERROR";
+    default:
+        return "?????";
+    }
+}
+
+/**
+ * @brief Open LOG_FILE for appending, rolling it over if the batch would not fit
+ *
+ * Called with file_mutex held.
+ */
+static bool logger_open_file(MiBandLogger* logger, size_t pending) {
+    bool opened = storage_file_is_open(logger->file) ||
+                  storage_file_open(logger->file, LOG_FILE, FSAM_WRITE, FSOM_OPEN_APPEND);
+
+    if(opened && storage_file_size(logger->file) + pending > MAX_LOG_SIZE) {
+        storage_file_close(logger->file);
+        storage_common_remove(logger->storage, LOG_FILE_OLD);
+        storage_common_rename(logger->storage, LOG_FILE, LOG_FILE_OLD);
+        FURI_LOG_I(TAG, "Log rolled over");
+        opened = storage_file_open(logger->file, LOG_FILE, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+    }
+
+    if(opened && storage_file_size(logger->file) == 0) {
+        LoggerFileHeader header = {.version = LOGGER_FILE_VERSION};
+        memcpy(header.magic, LOGGER_FILE_MAGIC, sizeof(header.magic));
+        opened = storage_file_write(logger->file, &header, sizeof(header)) == sizeof(header);
+    }
+
+    return opened;
+}
+
+/**
+ * @brief Append the pending batch to LOG_FILE and sync it
+ *
+ * Called with file_mutex held.
+ */
+static void logger_flush_batch(MiBandLogger* logger) {
+    if(logger->batch_len == 0) return;
+
+    if(logger_open_file(logger, logger->batch_len)) {
+        storage_file_write(logger->file, logger->batch, logger->batch_len);
+        storage_file_sync(logger->file);
+    } else {
+        FURI_LOG_E(TAG, "Cannot open %s", LOG_FILE);
+    }
+    logger->batch_len = 0;
+}
+
+/**
+ * @brief Add one encoded record to the batch, flushing first if it is full
+ *
+ * Called with file_mutex held.
+ */
+static void logger_batch_add(MiBandLogger* logger, const void* data, size_t size) {
+    if(logger->batch_len + size > sizeof(logger->batch)) {
+        logger_flush_batch(logger);
+    }
+    memcpy(&logger->batch[logger->batch_len], data, size);
+    logger->batch_len += size;
+    logger->count++;
+}
+
+/**
+ * @brief Move every queued record to LOG_FILE, merging both queues in logging order
+ *
+ * Called with file_mutex held.
+ */
+static void logger_drain(MiBandLogger* logger) {
+    while(true) {
+        if(!logger->has_pending_record) {
+            logger->has_pending_record =
+                furi_message_queue_get(logger->records, &logger->pending_record, 0) ==
+                FuriStatusOk;
+        }
+        if(!logger->has_pending_text) {
+            logger->has_pending_text =
+                furi_message_queue_get(logger->texts, &logger->pending_text, 0) == FuriStatusOk;
+        }
+        if(!logger->has_pending_record && !logger->has_pending_text) break;
+
+        bool text_first = logger->has_pending_text &&
+                          (!logger->has_pending_record ||
+                           (int16_t)(logger->pending_text.record.seq -
+                                     logger->pending_record.seq) < 0);
+
+        if(text_first) {
+            uint8_t encoded[sizeof(MiBandLogRecord) + 1 + MAX_LOG_TEXT];
+            uint8_t text_len = strnlen(logger->pending_text.message, MAX_LOG_TEXT - 1);
+            memcpy(encoded, &logger->pending_text.record, sizeof(MiBandLogRecord));
+            encoded[sizeof(MiBandLogRecord)] = text_len;
+            memcpy(&encoded[sizeof(MiBandLogRecord) + 1], logger->pending_text.message, text_len);
+            logger_batch_add(logger, encoded, sizeof(MiBandLogRecord) + 1 + text_len);
+            logger->has_pending_text = false;
+        } else {
+            logger_batch_add(logger, &logger->pending_record, sizeof(MiBandLogRecord));
+            logger->has_pending_record = false;
+        }
+    }
+    logger_flush_batch(logger);
+
+    if(logger->dropped) {
+        FURI_LOG_W(TAG, "%lu log entries dropped", logger->dropped);
+        logger->dropped = 0;
+    }
+}
+
+/**
+ * @brief Flush thread: writes queued records out in batches
+ */
+static int32_t logger_thread(void* context) {
+    MiBandLogger* logger = context;
+
+    while(logger->running) {
+        furi_thread_flags_wait(LOGGER_FLAG_STOP, FuriFlagWaitAny, LOGGER_FLUSH_INTERVAL_MS);
+
+        furi_mutex_acquire(logger->file_mutex, FuriWaitForever);
+        logger_drain(logger);
+        furi_mutex_release(logger->file_mutex);
+    }
+
+    return 0;
+}
+
 MiBandLogger* miband_logger_alloc(Storage* storage) {
     if(!storage) {
         FURI_LOG_E(TAG, "Storage is NULL!");
@@ -21,18 +227,14 @@ MiBandLogger* miband_logger_alloc(Storage* storage) {
         FURI_LOG_E(TAG, "Failed to allocate logger");
         return NULL;
     }
+    memset(logger, 0, sizeof(MiBandLogger));
 
-    logger->capacity = MAX_LOG_ENTRIES;
-    logger->entries = malloc(sizeof(LogEntry) * logger->capacity);
-    if(!logger->entries) {
-        FURI_LOG_E(TAG, "Failed to allocate log entries");
-        free(logger);
-        return NULL;
-    }
-
-    logger->count = 0;
     logger->storage = storage;
     logger->enabled = true;
+    logger->records = furi_message_queue_alloc(MAX_LOG_RECORDS, sizeof(MiBandLogRecord));
+    logger->texts = furi_message_queue_alloc(MAX_LOG_TEXTS, sizeof(LoggerText));
+    logger->file_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    logger->file = storage_file_alloc(storage);
 
     // SAFE directory creation con check
     FS_Error err;
@@ -52,129 +254,269 @@ MiBandLogger* miband_logger_alloc(Storage* storage) {
         FURI_LOG_W(TAG, "Failed to create log dir: %d", err);
     }
 
+    logger->running = true;
+    logger->thread =
+        furi_thread_alloc_ex("MiBandLogger", LOGGER_THREAD_STACK_SIZE, logger_thread, logger);
+    furi_thread_set_priority(logger->thread, FuriThreadPriorityLow);
+    furi_thread_start(logger->thread);
+
     FURI_LOG_I(TAG, "Logger initialized");
     return logger;
 }
 
 void miband_logger_free(MiBandLogger* logger) {
-    if(logger) {
-        if(logger->entries) {
-            free(logger->entries);
-        }
-        free(logger);
-    }
-}
+    if(!logger) return;
 
-void miband_logger_log(MiBandLogger* logger, LogLevel level, const char* format, ...) {
-    if(!logger || !logger->enabled || !logger->entries || !logger->storage) return;
+    // The thread drains whatever is still queued before it exits
+    logger->running = false;
+    furi_thread_flags_set(furi_thread_get_id(logger->thread), LOGGER_FLAG_STOP);
+    furi_thread_join(logger->thread);
+    furi_thread_free(logger->thread);
 
-    // Rotate if full
-    if(logger->count >= logger->capacity) {
-        // Remove oldest 25% entries
-        size_t keep = logger->capacity * 3 / 4;
-        memmove(
-            logger->entries, logger->entries + (logger->count - keep), sizeof(LogEntry) * keep);
-        logger->count = keep;
-    }
+    storage_file_close(logger->file);
+    storage_file_free(logger->file);
+    furi_mutex_free(logger->file_mutex);
+    furi_message_queue_free(logger->texts);
+    furi_message_queue_free(logger->records);
+    free(logger);
+}
 
-    LogEntry* entry = &logger->entries[logger->count++];
+void miband_logger_log(MiBandLogger* logger, LogLevel level, const char* format, ...) {
+    if(!logger || !logger->enabled) return;
 
-    // Get timestamp
-    furi_hal_rtc_get_datetime(&entry->timestamp);
-    entry->level = level;
+    LoggerText entry = {
+        .record =
+            {
+                .timestamp = furi_hal_rtc_get_timestamp(),
+                .seq = logger->seq++,
+                .level = level,
+                .event = MiBandLogEventText,
+                .sector = MIBAND_LOG_NONE,
+                .block = MIBAND_LOG_NONE,
+                .key_type = MIBAND_LOG_NONE,
+            },
+    };
 
-    // Format message
     va_list args;
     va_start(args, format);
-    vsnprintf(entry->message, sizeof(entry->message), format, args);
+    vsnprintf(entry.message, sizeof(entry.message), format, args);
     va_end(args);
 
+    if(furi_message_queue_put(logger->texts, &entry, 0) != FuriStatusOk) {
+        logger->dropped++;
+    }
+
     // Also log to FURI
     switch(level) {
     case LogLevelDebug:
-        FURI_LOG_D(TAG, "%s", entry->message);
+        FURI_LOG_D(TAG, "%s", entry.message);
         break;
     case LogLevelInfo:
-        FURI_LOG_I(TAG, "%s", entry->message);
+        FURI_LOG_I(TAG, "%s", entry.message);
         break;
     case LogLevelWarning:
-        FURI_LOG_W(TAG, "%s", entry->message);
+        FURI_LOG_W(TAG, "%s", entry.message);
         break;
     case LogLevelError:
-        FURI_LOG_E(TAG, "%s", entry->message);
+        FURI_LOG_E(TAG, "%s", entry.message);
         break;
     }
 }
 
+void miband_logger_event(
+    MiBandLogger* logger,
+    LogLevel level,
+    MiBandLogEvent event,
+    uint8_t sector,
+    uint8_t block,
+    uint8_t key_type,
+    uint8_t error) {
+    if(!logger || !logger->enabled) return;
+    furi_assert(event > MiBandLogEventText && event < MiBandLogEventCount);
+
+    MiBandLogRecord record = {
+        .timestamp = furi_hal_rtc_get_timestamp(),
+        .seq = logger->seq++,
+        .level = level,
+        .event = event,
+        .sector = sector,
+        .block = block,
+        .key_type = key_type,
+        .error = error,
+    };
+
+    if(furi_message_queue_put(logger->records, &record, 0) != FuriStatusOk) {
+        logger->dropped++;
+    }
+}
+
+static bool logger_reader_read(LoggerReader* reader, void* data, size_t size) {
+    uint8_t* out = data;
+
+    while(size > 0) {
+        if(reader->pos == reader->len) {
+            reader->len = storage_file_read(reader->file, reader->buffer, sizeof(reader->buffer));
+            reader->pos = 0;
+            if(reader->len == 0) return false;
+        }
+
+        size_t chunk = MIN(size, reader->len - reader->pos);
+        memcpy(out, &reader->buffer[reader->pos], chunk);
+        reader->pos += chunk;
+        out += chunk;
+        size -= chunk;
+    }
+    return true;
+}
+
+/**
+ * @brief Format one record as a text line
+ */
+static size_t logger_format_record(
+    const MiBandLogRecord* record,
+    const char* text,
+    char* line,
+    size_t size) {
+    DateTime dt;
+    datetime_timestamp_to_datetime(record->timestamp, &dt);
+
+    int len = snprintf(
+        line,
+        size,
+        "%04d-%02d-%02d %02d:%02d:%02d [%s] %s",
+        dt.year,
+        dt.month,
+        dt.day,
+        dt.hour,
+        dt.minute,
+        dt.second,
+        logger_level_str(record->level),
+        record->event == MiBandLogEventText ? text :
+        record->event < MiBandLogEventCount ? logger_event_names[record->event] :
+                                              "Unknown event");
+
+    if(record->event != MiBandLogEventText) {
+        if(record->sector != MIBAND_LOG_NONE && len > 0 && (size_t)len < size) {
+            len += snprintf(&line[len], size - len, " sector %u", record->sector);
+        }
+        if(record->block != MIBAND_LOG_NONE && len > 0 && (size_t)len < size) {
+            len += snprintf(&line[len], size - len, " block %u", record->block);
+        }
+        if(record->key_type != MIBAND_LOG_NONE && len > 0 && (size_t)len < size) {
+            len += snprintf(&line[len], size - len, " key %c", record->key_type ? 'B' : 'A');
+        }
+        if(record->error && len > 0 && (size_t)len < size) {
+            len += snprintf(&line[len], size - len, " error %u", record->error);
+        }
+    }
+
+    if(len < 0) return 0;
+    if((size_t)len >= size - 1) len = size - 2;
+    line[len++] = '\n';
+    line[len] = '\0';
+    return len;
+}
+
+/**
+ * @brief Format every record of one log file into the export file
+ */
+static size_t
+    logger_export_file(Storage* storage, const char* path, File* out, LoggerReader* reader) {
+    size_t exported = 0;
+    reader->file = storage_file_alloc(storage);
+    reader->pos = 0;
+    reader->len = 0;
+
+    LoggerFileHeader header;
+    if(storage_file_open(reader->file, path, FSAM_READ, FSOM_OPEN_EXISTING) &&
+       logger_reader_read(reader, &header, sizeof(header)) &&
+       memcmp(header.magic, LOGGER_FILE_MAGIC, sizeof(header.magic)) == 0 &&
+       header.version == LOGGER_FILE_VERSION) {
+        MiBandLogRecord record;
+        char text[MAX_LOG_TEXT];
+        char line[LOGGER_LINE_SIZE];
+
+        while(logger_reader_read(reader, &record, sizeof(record))) {
+            text[0] = '\0';
+            if(record.event == MiBandLogEventText) {
+                uint8_t text_len;
+                if(!logger_reader_read(reader, &text_len, 1) || text_len >= sizeof(text) ||
+                   !logger_reader_read(reader, text, text_len)) {
+                    break;
+                }
+                text[text_len] = '\0';
+            }
+
+            size_t len = logger_format_record(&record, text, line, sizeof(line));
+            if(storage_file_write(out, line, len) != len) break;
+            exported++;
+        }
+    }
+
+    storage_file_close(reader->file);
+    storage_file_free(reader->file);
+    return exported;
+}
+
 bool miband_logger_export(MiBandLogger* logger, const char* filename) {
-    if(!logger || logger->count == 0) return false;
+    if(!logger) return false;
 
     FuriString* filepath = furi_string_alloc_printf("%s/%s", LOG_PATH, filename);
     File* file = storage_file_alloc(logger->storage);
+    LoggerReader* reader = malloc(sizeof(LoggerReader));
     bool success = false;
 
+    furi_mutex_acquire(logger->file_mutex, FuriWaitForever);
+
+    // Write out what is still queued, then release LOG_FILE for reading
+    logger_drain(logger);
+    storage_file_close(logger->file);
+
     if(storage_file_open(file, furi_string_get_cstr(filepath), FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
         // Write header
         const char* header = "Mi Band NFC Writer - Log Export\n"
                              "================================\n\n";
         storage_file_write(file, header, strlen(header));
 
-        // Write each entry
-        for(size_t i = 0; i < logger->count; i++) {
-            LogEntry* entry = &logger->entries[i];
-
-            const char* level_str;
-            switch(entry->level) {
-            case LogLevelDebug:
-                level_str = "DEBUG";
-                break;
-            case LogLevelInfo:
-                level_str = "INFO ";
-                break;
-            case LogLevelWarning:
-                level_str = "WARN ";
-                break;
-            case LogLevelError:
-                level_str = "ERROR";
-                break;
-            default:
-                level_str = "?????";
-                break;
-            }
-
-            FuriString* line = furi_string_alloc_printf(
-                "%04d-%02d-%02d %02d:%02d:%02d [%s] %s\n",
-                entry->timestamp.year,
-                entry->timestamp.month,
-                entry->timestamp.day,
-                entry->timestamp.hour,
-                entry->timestamp.minute,
-                entry->timestamp.second,
-                level_str,
-                entry->message);
-
-            storage_file_write(file, furi_string_get_cstr(line), furi_string_size(line));
-            furi_string_free(line);
-        }
+        size_t exported = logger_export_file(logger->storage, LOG_FILE_OLD, file, reader);
+        exported += logger_export_file(logger->storage, LOG_FILE, file, reader);
 
         storage_file_close(file);
-        success = true;
-        FURI_LOG_I(TAG, "Exported %zu log entries to %s", logger->count, filename);
+        success = exported > 0;
+        FURI_LOG_I(TAG, "Exported %zu log entries to %s", exported, filename);
     }
 
+    furi_mutex_release(logger->file_mutex);
+
+    free(reader);
     storage_file_free(file);
     furi_string_free(filepath);
     return success;
 }
 
 void miband_logger_clear(MiBandLogger* logger) {
-    if(logger) {
-        logger->count = 0;
-    }
+    if(!logger) return;
+
+    furi_mutex_acquire(logger->file_mutex, FuriWaitForever);
+
+    furi_message_queue_reset(logger->records);
+    furi_message_queue_reset(logger->texts);
+    logger->has_pending_record = false;
+    logger->has_pending_text = false;
+    logger->batch_len = 0;
+    logger->count = 0;
+
+    storage_file_close(logger->file);
+    storage_common_remove(logger->storage, LOG_FILE);
+    storage_common_remove(logger->storage, LOG_FILE_OLD);
+
+    furi_mutex_release(logger->file_mutex);
 }
 
 size_t miband_logger_get_count(MiBandLogger* logger) {
-    return logger ? logger->count : 0;
+    if(!logger) return 0;
+    return logger->count + furi_message_queue_get_count(logger->records) +
+           furi_message_queue_get_count(logger->texts);
 }
 
 void miband_logger_set_enabled(MiBandLogger* logger, bool enabled) {
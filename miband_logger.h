@@ -1,6 +1,13 @@
 /**
  * @file miband_logger.h
- * @brief Logging system with file export
+ * @brief Logging system with a rolling binary event log
+ *
+ * Logging only copies a small record into a queue, so it is cheap enough for
+ * the NFC workers. Hot-path events (auth attempts, failed blocks) are
+ * structured records of a few integers; formatting into text is deferred to
+ * miband_logger_export(). A low-priority thread appends queued records to
+ * LOG_FILE in batches, synced after every batch so a crash mid-write loses at
+ * most the last batch. LOG_FILE rolls over to LOG_FILE_OLD at MAX_LOG_SIZE.
  */
 
 #pragma once
@@ -10,7 +17,11 @@
 #include <datetime/datetime.h>
 
 #define LOG_PATH        EXT_PATH("apps_data/miband_nfc/logs")
-#define MAX_LOG_ENTRIES 50
+#define LOG_FILE        LOG_PATH "/events.bin"
+#define LOG_FILE_OLD    LOG_PATH "/events.old.bin"
+#define MAX_LOG_RECORDS 192 // Structured records queued for the flush thread
+#define MAX_LOG_TEXTS   32 // Free-text entries queued, fits the largest summary burst
+#define MAX_LOG_TEXT    64
 #define MAX_LOG_SIZE    50000 // 50KB max per file
 
 typedef enum {
@@ -20,19 +31,36 @@ typedef enum {
     LogLevelError,
 } LogLevel;
 
-typedef struct {
-    DateTime timestamp;
-    LogLevel level;
-    char message[64];
-} LogEntry;
+/**
+ * @brief Structured event ids, each formatted by its own template on export
+ */
+typedef enum {
+    MiBandLogEventText, /**< Free text from miband_logger_log() */
+    MiBandLogEventAuth, /**< One auth attempt: sector, block, key type, error */
+    MiBandLogEventAuthFailed, /**< No key opened the sector */
+    MiBandLogEventReadFailed, /**< Sector/block could not be read */
+    MiBandLogEventWriteFailed, /**< Sector/block could not be written */
+    MiBandLogEventVerifyMismatch, /**< Block read back differs from the dump */
+    MiBandLogEventCount,
+} MiBandLogEvent;
+
+#define MIBAND_LOG_NONE 0xFF // Sector/block/key type not applicable
 
+/**
+ * @brief On-disk and in-queue event record
+ */
 typedef struct {
-    LogEntry* entries;
-    size_t count;
-    size_t capacity;
-    Storage* storage;
-    bool enabled;
-} MiBandLogger;
+    uint32_t timestamp; // RTC seconds
+    uint16_t seq; // Logging order across both queues
+    uint8_t level; // LogLevel
+    uint8_t event; // MiBandLogEvent
+    uint8_t sector;
+    uint8_t block;
+    uint8_t key_type; // MfClassicKeyType
+    uint8_t error; // MfClassicError
+} MiBandLogRecord;
+
+typedef struct MiBandLogger MiBandLogger;
 
 /**
  * @brief Create logger instance
@@ -45,22 +73,49 @@ MiBandLogger* miband_logger_alloc(Storage* storage);
 void miband_logger_free(MiBandLogger* logger);
 
 /**
- * @brief Add log entry
+ * @brief Add a free-text log entry
+ *
+ * Never blocks; the entry is dropped if the flush thread is behind. The text
+ * queue holds the largest burst (an operation summary or the benchmark
+ * report). Formats at call time, so prefer miband_logger_event() inside
+ * sector loops.
  */
 void miband_logger_log(MiBandLogger* logger, LogLevel level, const char* format, ...);
 
 /**
- * @brief Export logs to file
+ * @brief Add a structured event, formatted only when exported
+ *
+ * Never blocks and never formats; costs one 12-byte copy.
+ *
+ * @param logger Logger instance, may be NULL
+ * @param level Log level
+ * @param event Event id
+ * @param sector Sector number or MIBAND_LOG_NONE
+ * @param block Block number or MIBAND_LOG_NONE
+ * @param key_type MfClassicKeyType or MIBAND_LOG_NONE
+ * @param error MfClassicError of the operation
+ */
+void miband_logger_event(
+    MiBandLogger* logger,
+    LogLevel level,
+    MiBandLogEvent event,
+    uint8_t sector,
+    uint8_t block,
+    uint8_t key_type,
+    uint8_t error);
+
+/**
+ * @brief Flush pending entries and export the rolling log as text to LOG_PATH/filename
  */
 bool miband_logger_export(MiBandLogger* logger, const char* filename);
 
 /**
- * @brief Clear all logs
+ * @brief Delete the rolling log files
  */
 void miband_logger_clear(MiBandLogger* logger);
 
 /**
- * @brief Get log count
+ * @brief Get the number of entries logged since start or clear
  */
 size_t miband_logger_get_count(MiBandLogger* logger);
 
@@ -0,0 +1,44 @@
+/**
+ * @file miband_magic.c
+ * @brief Magic transform implementation
+ */
+
+#include "miband_magic.h"
+
+#define MIBAND_MAGIC_ACCESS_0 0xFF
+#define MIBAND_MAGIC_ACCESS_1 0x07
+#define MIBAND_MAGIC_ACCESS_2 0x80
+#define MIBAND_MAGIC_GPB      0x69
+
+// Each access byte nibble must be the complement of its C1/C2/C3 twin
+_Static_assert(
+    (MIBAND_MAGIC_ACCESS_0 & 0x0F) == (~(MIBAND_MAGIC_ACCESS_1 >> 4) & 0x0F) &&
+        (MIBAND_MAGIC_ACCESS_0 >> 4) == (~MIBAND_MAGIC_ACCESS_2 & 0x0F) &&
+        (MIBAND_MAGIC_ACCESS_1 & 0x0F) == (~(MIBAND_MAGIC_ACCESS_2 >> 4) & 0x0F),
+    "Invalid magic trailer access bits");
+
+static const MfClassicBlock magic_trailer = {
+    .data = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // Key A
+             MIBAND_MAGIC_ACCESS_0,
+             MIBAND_MAGIC_ACCESS_1,
+             MIBAND_MAGIC_ACCESS_2,
+             MIBAND_MAGIC_GPB,
+             0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}, // Key B
+};
+
+const MfClassicBlock* miband_magic_get_trailer(void) {
+    return &magic_trailer;
+}
+
+void miband_magic_apply(MfClassicData* data) {
+    furi_assert(data);
+
+    MiBandSectorIter iter;
+    miband_sector_iter_init(&iter, data->type);
+    while(miband_sector_iter_next(&iter)) {
+        data->block[iter.trailer_block] = magic_trailer;
+
+        FURI_BIT_SET(data->key_a_mask, iter.sector);
+        FURI_BIT_SET(data->key_b_mask, iter.sector);
+    }
+}
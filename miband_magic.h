@@ -0,0 +1,34 @@
+/**
+ * @file miband_magic.h
+ * @brief Magic (0xFF keys) transform of MfClassic dumps
+ *
+ * A magic dump is the original dump with every sector trailer replaced by
+ * one constant template: 0xFF Key A and Key B and the transport access
+ * bits. The template is checked at build time, so the transform never
+ * validates or rebuilds a trailer at run time.
+ *
+ * The transform works in place on a loaded dump; streaming converters (see
+ * miband_magic_file.h) write the template over each trailer they copy.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
+#include "miband_sector_iter.h"
+
+/**
+ * @brief Get the magic trailer template
+ *
+ * @return 16-byte trailer: Key A FF..FF, access bits FF 07 80, GPB 69, Key B FF..FF
+ */
+const MfClassicBlock* miband_magic_get_trailer(void);
+
+/**
+ * @brief Turn a dump into its magic variant in place
+ *
+ * Replaces every sector trailer and marks both keys of every sector found.
+ *
+ * @param data Dump to transform
+ */
+void miband_magic_apply(MfClassicData* data);
@@ -0,0 +1,237 @@
+/**
+ * @file miband_magic_file.c
+ * @brief Streaming magic converter implementation
+ */
+
+#include "miband_magic_file.h"
+#include "miband_magic.h"
+
+#define TAG "MiBandMagicFile"
+
+#define MIBAND_MAGIC_FILE_CHUNK_SIZE 512
+#define MIBAND_MAGIC_FILE_LINE_MAX   96
+#define MIBAND_MAGIC_FILE_TMP_SUFFIX ".tmp"
+
+#define MIBAND_MAGIC_FILE_FILETYPE   "Filetype: Flipper NFC device"
+#define MIBAND_MAGIC_FILE_MF_CLASSIC "Device type: Mifare Classic"
+#define MIBAND_MAGIC_FILE_BLOCK      "Block "
+
+/**
+ * @brief Converter state, heap allocated to keep the caller's stack small
+ */
+typedef struct {
+    File* out;
+    bool io_error;
+    size_t out_len;
+    char out_buf[MIBAND_MAGIC_FILE_CHUNK_SIZE];
+
+    char in_buf[MIBAND_MAGIC_FILE_CHUNK_SIZE];
+    char line[MIBAND_MAGIC_FILE_LINE_MAX];
+    size_t line_len;
+    bool passthrough; // Rest of an over-long line, copied as is
+
+    size_t lines;
+    bool is_mf_classic;
+    bool invalid;
+    size_t trailers;
+} MiBandMagicFileConverter;
+
+static void miband_magic_file_flush(MiBandMagicFileConverter* conv) {
+    if(conv->out_len == 0 || conv->io_error) return;
+    if(storage_file_write(conv->out, conv->out_buf, conv->out_len) != conv->out_len) {
+        conv->io_error = true;
+    }
+    conv->out_len = 0;
+}
+
+static void miband_magic_file_put(MiBandMagicFileConverter* conv, const char* data, size_t size) {
+    while(size > 0) {
+        if(conv->out_len == sizeof(conv->out_buf)) miband_magic_file_flush(conv);
+
+        size_t count = MIN(size, sizeof(conv->out_buf) - conv->out_len);
+        memcpy(&conv->out_buf[conv->out_len], data, count);
+        conv->out_len += count;
+        data += count;
+        size -= count;
+    }
+}
+
+/**
+ * @brief Parse "Block N:" and return N, or -1 for any other line
+ */
+static int miband_magic_file_block_num(const char* line) {
+    size_t prefix_len = strlen(MIBAND_MAGIC_FILE_BLOCK);
+    if(strncmp(line, MIBAND_MAGIC_FILE_BLOCK, prefix_len) != 0) return -1;
+
+    int block = 0;
+    const char* c = &line[prefix_len];
+    if(*c < '0' || *c > '9') return -1;
+    while(*c >= '0' && *c <= '9') {
+        block = block * 10 + (*c - '0');
+        if(block > 0xFF) return -1;
+        c++;
+    }
+    return *c == ':' ? block : -1;
+}
+
+static void miband_magic_file_put_trailer(MiBandMagicFileConverter* conv, int block, bool cr) {
+    const MfClassicBlock* trailer = miband_magic_get_trailer();
+    char text[MIBAND_MAGIC_FILE_LINE_MAX];
+
+    int len = snprintf(text, sizeof(text), "Block %d:", block);
+    for(size_t i = 0; i < sizeof(trailer->data); i++) {
+        len += snprintf(&text[len], sizeof(text) - len, " %02X", trailer->data[i]);
+    }
+    miband_magic_file_put(conv, text, len);
+    miband_magic_file_put(conv, cr ? "\r\n" : "\n", cr ? 2 : 1);
+}
+
+/**
+ * @brief Handle one complete line (without its '\n')
+ */
+static void miband_magic_file_line(MiBandMagicFileConverter* conv) {
+    size_t len = conv->line_len;
+    bool cr = len > 0 && conv->line[len - 1] == '\r';
+    conv->line[cr ? len - 1 : len] = '\0';
+    conv->lines++;
+
+    if(conv->lines == 1) {
+        conv->invalid = strcmp(conv->line, MIBAND_MAGIC_FILE_FILETYPE) != 0;
+    } else if(strncmp(
+                  conv->line,
+                  MIBAND_MAGIC_FILE_MF_CLASSIC,
+                  strlen(MIBAND_MAGIC_FILE_MF_CLASSIC)) == 0) {
+        conv->is_mf_classic = true;
+    }
+
+    int block = miband_magic_file_block_num(conv->line);
+    if(block >= 0) {
+        // Blocks before the device type: not a dump this converter understands
+        if(!conv->is_mf_classic) conv->invalid = true;
+        if(mf_classic_is_sector_trailer(block)) {
+            miband_magic_file_put_trailer(conv, block, cr);
+            conv->trailers++;
+            return;
+        }
+    }
+
+    if(cr) conv->line[len - 1] = '\r';
+    miband_magic_file_put(conv, conv->line, len);
+    miband_magic_file_put(conv, "\n", 1);
+}
+
+static void miband_magic_file_feed(MiBandMagicFileConverter* conv, const char* data, size_t size) {
+    for(size_t i = 0; i < size && !conv->invalid; i++) {
+        char c = data[i];
+
+        if(conv->passthrough) {
+            miband_magic_file_put(conv, &c, 1);
+            if(c == '\n') conv->passthrough = false;
+        } else if(c == '\n') {
+            miband_magic_file_line(conv);
+            conv->line_len = 0;
+        } else if(conv->line_len < sizeof(conv->line) - 1) {
+            conv->line[conv->line_len++] = c;
+        } else {
+            // Longer than any block line: copy it through untouched
+            miband_magic_file_put(conv, conv->line, conv->line_len);
+            miband_magic_file_put(conv, &c, 1);
+            conv->line_len = 0;
+            conv->passthrough = true;
+        }
+    }
+}
+
+void miband_magic_file_output_path(const char* src_path, FuriString* dst_path) {
+    furi_assert(src_path);
+    furi_assert(dst_path);
+
+    furi_string_set_str(dst_path, src_path);
+    size_t ext_pos = furi_string_search_rchar(dst_path, '.');
+    if(ext_pos != FURI_STRING_FAILURE) {
+        furi_string_left(dst_path, ext_pos);
+    }
+    furi_string_cat_str(dst_path, MIBAND_MAGIC_FILE_SUFFIX);
+}
+
+bool miband_magic_file_is_magic(const char* path) {
+    furi_assert(path);
+
+    size_t path_len = strlen(path);
+    size_t suffix_len = strlen(MIBAND_MAGIC_FILE_SUFFIX);
+    return path_len >= suffix_len &&
+           strcmp(&path[path_len - suffix_len], MIBAND_MAGIC_FILE_SUFFIX) == 0;
+}
+
+bool miband_magic_file_convert(Storage* storage, const char* src_path, const char* dst_path) {
+    furi_assert(storage);
+    furi_assert(src_path);
+    furi_assert(dst_path);
+
+    MiBandMagicFileConverter* conv = malloc(sizeof(MiBandMagicFileConverter));
+    if(!conv) return false;
+    memset(conv, 0, sizeof(MiBandMagicFileConverter));
+
+    FuriString* tmp_path =
+        furi_string_alloc_printf("%s%s", dst_path, MIBAND_MAGIC_FILE_TMP_SUFFIX);
+    File* in = storage_file_alloc(storage);
+    conv->out = storage_file_alloc(storage);
+    bool success = false;
+
+    do {
+        if(!storage_file_open(in, src_path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            FURI_LOG_E(TAG, "Cannot open %s", src_path);
+            break;
+        }
+        if(!storage_file_open(
+               conv->out, furi_string_get_cstr(tmp_path), FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            FURI_LOG_E(TAG, "Cannot create %s", furi_string_get_cstr(tmp_path));
+            break;
+        }
+
+        size_t read;
+        while(!conv->invalid && !conv->io_error &&
+              (read = storage_file_read(in, conv->in_buf, sizeof(conv->in_buf))) > 0) {
+            miband_magic_file_feed(conv, conv->in_buf, read);
+        }
+
+        // Last line without a trailing newline
+        if(conv->line_len > 0 && !conv->passthrough && !conv->invalid) {
+            miband_magic_file_line(conv);
+            // miband_magic_file_line() always terminates the line, drop the added '\n'
+            conv->out_len--;
+        }
+        miband_magic_file_flush(conv);
+
+        if(conv->invalid || !conv->is_mf_classic || conv->trailers == 0) {
+            FURI_LOG_W(TAG, "%s is not a Mifare Classic dump", src_path);
+            break;
+        }
+        if(conv->io_error) {
+            FURI_LOG_E(TAG, "Write error on %s", furi_string_get_cstr(tmp_path));
+            break;
+        }
+
+        success = true;
+    } while(false);
+
+    storage_file_close(in);
+    storage_file_close(conv->out);
+    storage_file_free(in);
+    storage_file_free(conv->out);
+
+    if(success) {
+        storage_common_remove(storage, dst_path);
+        success = storage_common_rename(storage, furi_string_get_cstr(tmp_path), dst_path) ==
+                  FSE_OK;
+    }
+    if(!success) {
+        storage_common_remove(storage, furi_string_get_cstr(tmp_path));
+    } else {
+        FURI_LOG_I(TAG, "Converted %s, %zu trailers", src_path, conv->trailers);
+    }
+
+    furi_string_free(tmp_path);
+    free(conv);
+    return success;
+}
@@ -0,0 +1,48 @@
+/**
+ * @file miband_magic_file.h
+ * @brief Streaming .nfc -> _magic.nfc converter
+ *
+ * Converting through nfc_device_load()/nfc_device_save() parses the whole
+ * dump into an MfClassicData and serializes it back. The converter instead
+ * copies the source file line by line and only rewrites the "Block N:"
+ * lines of sector trailers with the magic template, so memory stays
+ * constant (a few small buffers) whatever the dump size, and output is
+ * written in large chunks.
+ *
+ * The output is written to a temporary file and renamed over the target
+ * once complete, so an interrupted conversion never leaves a truncated
+ * _magic.nfc behind.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+
+#define MIBAND_MAGIC_FILE_SUFFIX "_magic.nfc"
+
+/**
+ * @brief Build the _magic.nfc path of a dump
+ *
+ * @param src_path Source dump path
+ * @param dst_path Output, "<src without extension>_magic.nfc"
+ */
+void miband_magic_file_output_path(const char* src_path, FuriString* dst_path);
+
+/**
+ * @brief Check whether a path is already a magic dump
+ *
+ * @param path File path
+ * @return true if the name ends with MIBAND_MAGIC_FILE_SUFFIX
+ */
+bool miband_magic_file_is_magic(const char* path);
+
+/**
+ * @brief Convert a Mifare Classic dump to its magic variant
+ *
+ * @param storage Storage API instance
+ * @param src_path Source dump path
+ * @param dst_path Output path, replaced only on success
+ * @return true if the source is a Flipper Mifare Classic dump and it was converted
+ */
+bool miband_magic_file_convert(Storage* storage, const char* src_path, const char* dst_path);
@@ -73,10 +73,23 @@ static MiBandNfcApp* miband_nfc_app_alloc() {
     view_dispatcher_add_view(
         app->view_dispatcher, MiBandNfcViewIdUidReport, text_box_get_view(app->text_box_report));
 
+    app->progress = progress_tracker_alloc(0, "Sector");
+    view_dispatcher_add_view(
+        app->view_dispatcher, MiBandNfcViewIdProgress, progress_tracker_get_view(app->progress));
+
+    app->diff_view = miband_diff_view_alloc();
+    view_dispatcher_add_view(
+        app->view_dispatcher, MiBandNfcViewIdDiff, miband_diff_view_get_view(app->diff_view));
+
     app->nfc = nfc_alloc();
+    miband_card_io_set_backend(&miband_card_io_nfc, NULL);
     app->nfc_device = nfc_device_alloc();
     app->target_data = mf_classic_alloc();
     app->mf_classic_data = mf_classic_alloc();
+    app->auth_cache = miband_auth_cache_alloc();
+    app->card_session = miband_card_session_alloc(app->auth_cache);
+    app->dump_cache = miband_dump_cache_alloc();
+    app->backup_saver = miband_backup_saver_alloc();
 
     app->poller = NULL;
     app->scanner = NULL;
@@ -97,6 +110,10 @@ static MiBandNfcApp* miband_nfc_app_alloc() {
 
         if(app->temp_text_buffer) furi_string_free(app->temp_text_buffer);
         if(app->file_path) furi_string_free(app->file_path);
+        if(app->backup_saver) miband_backup_saver_free(app->backup_saver);
+        if(app->dump_cache) miband_dump_cache_free(app->dump_cache);
+        if(app->card_session) miband_card_session_free(app->card_session);
+        if(app->auth_cache) miband_auth_cache_free(app->auth_cache);
         if(app->mf_classic_data) mf_classic_free(app->mf_classic_data);
         if(app->target_data) mf_classic_free(app->target_data);
         if(app->nfc_device) nfc_device_free(app->nfc_device);
@@ -105,16 +122,20 @@ static MiBandNfcApp* miband_nfc_app_alloc() {
         goto error;
     }
 
+    // Loading keeps the defaults of fields an older settings file lacks
+    miband_settings_set_defaults(app);
     if(!miband_settings_load(app)) {
-        app->auto_backup_enabled = true;
-        app->verify_after_write = false;
-        app->show_detailed_progress = true;
-        app->enable_logging = true;
         FURI_LOG_I(TAG, "Using default settings");
     }
+    progress_tracker_set_redraw_ms(app->progress, miband_nfc_get_profile(app)->redraw_ms);
+
+    if(app->write_checkpoint_file) {
+        miband_write_checkpoint_load(&app->write_checkpoint, app->storage);
+    }
 
     if(app->logger) {
         miband_logger_set_enabled(app->logger, app->enable_logging);
+        miband_auth_cache_set_logger(app->auth_cache, app->logger);
         miband_logger_log(app->logger, LogLevelInfo, "Application started");
     }
 
@@ -166,6 +187,16 @@ static void miband_nfc_app_free(MiBandNfcApp* app) {
         dialog_ex_free(app->dialog_ex);
     }
 
+    if(app->progress) {
+        view_dispatcher_remove_view(app->view_dispatcher, MiBandNfcViewIdProgress);
+        progress_tracker_free(app->progress);
+    }
+
+    if(app->diff_view) {
+        view_dispatcher_remove_view(app->view_dispatcher, MiBandNfcViewIdDiff);
+        miband_diff_view_free(app->diff_view);
+    }
+
     if(app->scene_manager) {
         scene_manager_free(app->scene_manager);
     }
@@ -205,6 +236,22 @@ static void miband_nfc_app_free(MiBandNfcApp* app) {
         mf_classic_free(app->target_data);
     }
 
+    if(app->backup_saver) {
+        miband_backup_saver_free(app->backup_saver);
+    }
+
+    if(app->dump_cache) {
+        miband_dump_cache_free(app->dump_cache);
+    }
+
+    if(app->card_session) {
+        miband_card_session_free(app->card_session);
+    }
+
+    if(app->auth_cache) {
+        miband_auth_cache_free(app->auth_cache);
+    }
+
     if(app->file_path) {
         furi_string_free(app->file_path);
     }
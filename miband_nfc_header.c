@@ -0,0 +1,141 @@
+/**
+ * @file miband_nfc_header.c
+ * @brief Streaming .nfc header reader implementation
+ */
+
+#include "miband_nfc_header.h"
+
+#define TAG "MiBandNfcHeader"
+
+#define MIBAND_NFC_HEADER_CHUNK_SIZE 64
+#define MIBAND_NFC_HEADER_LINE_MAX   80
+/** The header is a few hundred bytes, never read further than this */
+#define MIBAND_NFC_HEADER_READ_MAX   2048
+
+#define MIBAND_NFC_HEADER_FILETYPE   "Flipper NFC device"
+#define MIBAND_NFC_HEADER_MF_CLASSIC "Mifare Classic"
+#define MIBAND_NFC_HEADER_BLOCK0_UID 4
+
+typedef struct {
+    MiBandNfcHeader* header;
+    bool filetype_ok;
+    bool device_type_seen;
+    bool done;
+} MiBandNfcHeaderParser;
+
+static int miband_nfc_header_hex_nibble(char c) {
+    if(c >= '0' && c <= '9') return c - '0';
+    if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+/**
+ * @brief Parse space separated hex bytes, "??" (unknown) fails
+ */
+static size_t miband_nfc_header_parse_hex(const char* value, uint8_t* out, size_t out_max) {
+    size_t count = 0;
+    while(*value && count < out_max) {
+        if(*value == ' ') {
+            value++;
+            continue;
+        }
+
+        int high = miband_nfc_header_hex_nibble(value[0]);
+        int low = high < 0 ? -1 : miband_nfc_header_hex_nibble(value[1]);
+        if(low < 0) return 0;
+
+        out[count++] = (uint8_t)((high << 4) | low);
+        value += 2;
+    }
+    return count;
+}
+
+/**
+ * @brief Match a "Key: value" line, returns the value or NULL
+ */
+static const char* miband_nfc_header_value(const char* line, const char* key) {
+    size_t key_len = strlen(key);
+    if(strncmp(line, key, key_len) != 0 || line[key_len] != ':') return NULL;
+
+    const char* value = &line[key_len + 1];
+    while(*value == ' ') value++;
+    return value;
+}
+
+static void miband_nfc_header_parse_line(MiBandNfcHeaderParser* parser, const char* line) {
+    MiBandNfcHeader* header = parser->header;
+    const char* value;
+
+    if(line[0] == '#' || line[0] == '\0') return;
+
+    if(!parser->filetype_ok) {
+        // Filetype is always the first line
+        value = miband_nfc_header_value(line, "Filetype");
+        parser->filetype_ok = value && strcmp(value, MIBAND_NFC_HEADER_FILETYPE) == 0;
+        if(!parser->filetype_ok) parser->done = true;
+    } else if((value = miband_nfc_header_value(line, "Device type"))) {
+        parser->device_type_seen = true;
+        header->is_mf_classic = strcmp(value, MIBAND_NFC_HEADER_MF_CLASSIC) == 0;
+        if(!header->is_mf_classic) parser->done = true;
+    } else if((value = miband_nfc_header_value(line, "UID"))) {
+        header->uid_len =
+            miband_nfc_header_parse_hex(value, header->uid, MIBAND_NFC_HEADER_UID_MAX);
+    } else if((value = miband_nfc_header_value(line, "Block 0"))) {
+        if(header->uid_len == 0) {
+            uint8_t block0[MIBAND_NFC_HEADER_BLOCK0_UID];
+            if(miband_nfc_header_parse_hex(value, block0, sizeof(block0)) == sizeof(block0)) {
+                memcpy(header->uid, block0, sizeof(block0));
+                header->uid_len = sizeof(block0);
+            }
+        }
+        // Past the header, nothing more to learn
+        parser->done = true;
+    }
+
+    if(parser->device_type_seen && header->uid_len > 0) parser->done = true;
+}
+
+bool miband_nfc_header_read(File* file, const char* path, MiBandNfcHeader* header) {
+    furi_assert(file);
+    furi_assert(path);
+    furi_assert(header);
+
+    memset(header, 0, sizeof(MiBandNfcHeader));
+    if(!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        storage_file_close(file);
+        return false;
+    }
+
+    MiBandNfcHeaderParser parser = {.header = header};
+    char chunk[MIBAND_NFC_HEADER_CHUNK_SIZE];
+    char line[MIBAND_NFC_HEADER_LINE_MAX];
+    size_t line_len = 0;
+    size_t total = 0;
+
+    while(!parser.done && total < MIBAND_NFC_HEADER_READ_MAX) {
+        size_t read = storage_file_read(file, chunk, sizeof(chunk));
+        if(read == 0) break;
+        total += read;
+
+        for(size_t i = 0; i < read && !parser.done; i++) {
+            char c = chunk[i];
+            if(c == '\r') continue;
+            if(c != '\n') {
+                // Long lines are truncated, only their beginning matters
+                if(line_len < sizeof(line) - 1) line[line_len++] = c;
+                continue;
+            }
+
+            line[line_len] = '\0';
+            miband_nfc_header_parse_line(&parser, line);
+            line_len = 0;
+        }
+    }
+
+    storage_file_close(file);
+
+    bool success = parser.filetype_ok && header->is_mf_classic && header->uid_len > 0;
+    if(!success) FURI_LOG_D(TAG, "No MfClassic UID in %s", path);
+    return success;
+}
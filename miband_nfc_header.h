@@ -0,0 +1,38 @@
+/**
+ * @file miband_nfc_header.h
+ * @brief Streaming reader for the header of .nfc dump files
+ *
+ * nfc_device_load() parses the whole dump into an NfcDevice just to expose
+ * the UID. This reader streams the file in small chunks, picks the device
+ * type and the UID out of the header and stops as soon as both are known,
+ * without touching the block data or allocating an NfcDevice.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+
+#define MIBAND_NFC_HEADER_UID_MAX 10
+
+/**
+ * @brief Fields extracted from a dump header
+ */
+typedef struct {
+    uint8_t uid[MIBAND_NFC_HEADER_UID_MAX];
+    size_t uid_len;
+    bool is_mf_classic; /**< "Device type: Mifare Classic" */
+} MiBandNfcHeader;
+
+/**
+ * @brief Read the UID of a .nfc dump
+ *
+ * Uses the "UID:" line; falls back to the first 4 bytes of "Block 0:"
+ * when a dump has no UID line. The file is closed again on return.
+ *
+ * @param file File instance to use, reused across calls by the caller
+ * @param path Dump path
+ * @param header Output
+ * @return true if the file is a Flipper NFC dump and a UID was found
+ */
+bool miband_nfc_header_read(File* file, const char* path, MiBandNfcHeader* header);
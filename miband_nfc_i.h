@@ -33,9 +33,29 @@
 #include "miband_nfc_scene.h"
 #include "progress_tracker.h"
 #include "miband_logger.h"
+#include "miband_card_io.h"
+#include "miband_card_io_nfc.h"
+#include "miband_auth_cache.h"
+#include "miband_card_session.h"
+#include "miband_op_stats.h"
+#include "miband_sector_session.h"
+#include "miband_sector_iter.h"
+#include "miband_retry.h"
+#include "miband_pipeline.h"
+#include "miband_block_diff.h"
+#include "miband_diff_view.h"
+#include "miband_magic.h"
+#include "miband_magic_file.h"
+#include "miband_uid_index.h"
+#include "miband_path_arena.h"
+#include "miband_write_checkpoint.h"
+#include "miband_dump_cache.h"
+#include "miband_dump_sidecar.h"
+#include "miband_backup_saver.h"
 
 #define NFC_APP_FOLDER    EXT_PATH("nfc")
 #define NFC_APP_EXTENSION ".nfc"
+#define BACKUP_FOLDER     EXT_PATH("nfc/backups") // Auto-backups, left out of the UID check
 
 typedef enum {
     MiBandNfcViewIdMainMenu, // 0
@@ -46,6 +66,8 @@ typedef enum {
     MiBandNfcViewIdAbout, // 5
     MiBandNfcViewIdUidReport, // 6
     MiBandNfcViewIdDialog, // 7
+    MiBandNfcViewIdProgress, // 8
+    MiBandNfcViewIdDiff, // 9
 } MiBandNfcViewId;
 
 /**
@@ -53,21 +75,31 @@ typedef enum {
  */
 typedef enum {
     SubmenuIndexQuickUidCheck = 0,
+    SubmenuIndexRecentDumps,
     SubmenuIndexEmulateNfcMagic,
     SubmenuIndexWriteOriginalData,
+    SubmenuIndexBatchWrite,
     SubmenuIndexSaveMagic,
+    SubmenuIndexConvertFolder,
     SubmenuIndexVerify,
+    SubmenuIndexLastRunStats,
     SubmenuIndexSettings,
     SubmenuIndexAbout,
 } SubmenuIndex;
 
 typedef enum {
     SettingsIndexAutoBackup = 0,
+    SettingsIndexPipelineProfile,
     SettingsIndexVerifyAfterWrite,
+    SettingsIndexDeltaWrite,
     SettingsIndexShowProgress,
     SettingsIndexEnableLogging,
+    SettingsIndexUidFirstMatch,
+    SettingsIndexResumeFile,
+    SettingsIndexDumpSidecar,
     SettingsIndexExportLogs,
     SettingsIndexClearLogs,
+    SettingsIndexBenchmark,
     SettingsIndexBack,
 } SettingsIndex;
 
@@ -81,6 +113,14 @@ enum MiBandNfcCustomEvent {
     MiBandNfcCustomEventPollerFailed,
     MiBandNfcCustomEventVerifyExit,
     MiBandNfcCustomEventVerifyViewDetails,
+    MiBandNfcCustomEventWriterSuccess,
+    MiBandNfcCustomEventWriterFailed,
+    MiBandNfcCustomEventPopupDone,
+    MiBandNfcCustomEventUidCheckUpdate,
+    MiBandNfcCustomEventBatchCardRemoved,
+    MiBandNfcCustomEventFolderConvertDone,
+    MiBandNfcCustomEventEmulatorTick,
+    MiBandNfcCustomEventBenchmarkDone,
 };
 
 typedef enum {
@@ -88,8 +128,18 @@ typedef enum {
     OperationTypeWriteOriginal,
     OperationTypeSaveMagic,
     OperationTypeVerify,
+    OperationTypeBatchWrite,
 } OperationType;
 
+/**
+ * @brief Batch provisioning counters, reset when the writer scene is entered
+ */
+typedef struct {
+    uint32_t bands_ok;
+    uint32_t bands_failed;
+    uint32_t start_tick; // First band detected
+} MiBandBatchStats;
+
 struct MiBandNfcApp {
     // GUI components
     Gui* gui;
@@ -103,6 +153,8 @@ struct MiBandNfcApp {
     TextBox* text_box; // Shared by About and UID Check
     TextBox* text_box_report;
     DialogEx* dialog_ex;
+    ProgressTracker* progress; // Progress view shared by backup, write and verify
+    MiBandDiffView* diff_view; // Paged verify differences
 
     // File handling
     DialogsApp* dialogs;
@@ -110,12 +162,20 @@ struct MiBandNfcApp {
     FuriString* file_path;
 
     MiBandLogger* logger;
+    MiBandAuthCache* auth_cache; // Working keys of the card in the field
+    MiBandCardSession* card_session; // UID, type and key state shared by chained scenes
+    MiBandDumpCache* dump_cache; // Recently parsed dumps, also the Recent Dumps list
+    MiBandBackupSaver* backup_saver; // Saves the pre-write backup while the writer runs
 
     // Settings
     bool auto_backup_enabled;
-    bool verify_after_write;
     bool show_detailed_progress;
     bool enable_logging;
+    MiBandPipelineProfileId pipeline_profile; // Active entry of pipeline_profiles
+    MiBandPipelineProfile pipeline_profiles[MiBandPipelineProfileCount];
+    bool uid_check_first_match; // Quick UID Check stops at the first matching dump
+    bool write_checkpoint_file; // Keep the write checkpoint in a file, not only in RAM
+    bool dump_sidecar; // Load dumps from binary sidecars, write one on each parse
 
     // NFC components (allocated on demand)
     Nfc* nfc;
@@ -127,19 +187,57 @@ struct MiBandNfcApp {
     // NFC data
     MfClassicData* target_data; // Data read from physical card
     MfClassicData* mf_classic_data; // Data loaded from file
+    bool target_snapshot_valid; // target_data holds a full read of the card in the field
 
     // State
     bool is_valid_nfc_data;
     bool is_scan_active;
     SubmenuIndex last_selected_submenu_index;
     OperationType current_operation;
+    MiBandBatchStats batch;
+    MiBandOpStats op_stats; // Timing of the last backup/write/verify run
+    MiBandWriteCheckpoint write_checkpoint; // Sectors committed by an interrupted write
 
     FuriString* temp_text_buffer;
 
     bool is_emulating;
     void* uid_check_context; // Puntatore a UidCheckContext (allocato dinamicamente)
+    void* writer_context; // Pointer to WriterContext (owned by the writer scene)
+    void* magic_folder_context; // Pointer to MagicFolderContext (owned by its scene)
+    void* benchmark_context; // Pointer to BenchmarkContext (owned by its scene)
     void* emulation_stats; // Puntatore a EmulationStats
 };
 
+void miband_settings_set_defaults(MiBandNfcApp* app);
 bool miband_settings_save(MiBandNfcApp* app);
 bool miband_settings_load(MiBandNfcApp* app);
+
+/**
+ * @brief Get the active pipeline profile
+ *
+ * @param app App instance
+ * @return Profile selected in Settings
+ */
+static inline MiBandPipelineProfile* miband_nfc_get_profile(MiBandNfcApp* app) {
+    return &app->pipeline_profiles[app->pipeline_profile];
+}
+
+/**
+ * @brief Load app->file_path into app->mf_classic_data
+ *
+ * Served from the dump cache when the file did not change since it was
+ * last parsed, then from its binary sidecar if enabled; a parsed file is
+ * added to the cache and, if enabled, gets a sidecar.
+ *
+ * @param app App instance
+ * @param from_cache Optional output, true on a cache hit
+ * @return NULL on success, otherwise a short error for the popup
+ */
+const char* miband_nfc_load_dump(MiBandNfcApp* app, bool* from_cache);
+
+/**
+ * @brief Open the scene of app->current_operation for the loaded dump
+ *
+ * @param app App instance
+ */
+void miband_nfc_start_operation(MiBandNfcApp* app);
@@ -5,13 +5,15 @@
  * This scene automatically backs up the current Mi Band data before
  * performing write operations. Creates backups in /ext/nfc/backups/
  * with timestamp for easy restoration.
+ * 
+ * The file is written by the backup saver in the background; the writer
+ * starts right away and collects the save result when it finishes.
  */
 
 #include "miband_nfc_i.h"
 #include <datetime/datetime.h>
 
-#define TAG           "MiBandNfc"
-#define BACKUP_FOLDER EXT_PATH("nfc/backups")
+#define TAG "MiBandNfc"
 
 /**
  * @brief Create backup directory if it doesn't exist
@@ -38,77 +40,64 @@ static bool ensure_backup_directory(Storage* storage) {
  * @return true if all sectors read successfully
  */
 static bool backup_read_all_data(MiBandNfcApp* app) {
-    size_t total_sectors = mf_classic_get_total_sectors_num(app->mf_classic_data->type);
-
-    popup_set_text(app->popup, "Reading Mi Band...\n\nSector 0/16", 64, 22, AlignCenter, AlignTop);
-
-    FuriString* progress = furi_string_alloc();
-    for(size_t sector = 0; sector < total_sectors; sector++) {
-        uint8_t first_block = mf_classic_get_first_block_num_of_sector(sector);
-        uint8_t blocks_in_sector = mf_classic_get_blocks_num_in_sector(sector);
-
-        if(sector % 2 == 0) {
-            furi_string_reset(progress);
-            furi_string_printf(
-                progress, "Reading...\nSector %zu/%zu\n", sector + 1, total_sectors);
-
-            uint32_t percent = ((sector + 1) * 100) / total_sectors;
-            furi_string_cat_str(progress, "[");
-            for(uint8_t i = 0; i < 20; i++) {
-                if(i < (percent / 5))
-                    furi_string_cat_str(progress, "=");
-                else
-                    furi_string_cat_str(progress, " ");
-            }
-            furi_string_cat_printf(progress, "]\n%lu%%", percent);
-
-            popup_set_text(
-                app->popup, furi_string_get_cstr(progress), 64, 18, AlignCenter, AlignTop);
-        }
+    MiBandSectorIter iter;
+    miband_sector_iter_init(&iter, app->target_data->type);
+    const MiBandRetryPolicy* policy = &miband_nfc_get_profile(app)->retry;
 
-        furi_delay_ms(50);
+    progress_tracker_reset(app->progress, iter.total_sectors, "Sector");
+    progress_tracker_set_header(app->progress, "Creating Backup");
+    progress_tracker_set_status(app->progress, "Reading Mi Band...");
+    view_dispatcher_switch_to_view(app->view_dispatcher, MiBandNfcViewIdProgress);
 
-        MfClassicKey keys_to_try[3];
-        MfClassicKeyType key_types[3];
-        int keys_count = 0;
-
-        MfClassicSectorTrailer* sec_tr =
-            mf_classic_get_sector_trailer_by_sector(app->mf_classic_data, sector);
-
-        if(sec_tr && mf_classic_is_key_found(app->mf_classic_data, sector, MfClassicKeyTypeA)) {
-            memcpy(keys_to_try[keys_count].data, sec_tr->key_a.data, 6);
-            key_types[keys_count] = MfClassicKeyTypeA;
-            keys_count++;
-        }
+    while(miband_sector_iter_next(&iter)) {
+        size_t sector = iter.sector;
+        uint8_t first_block = iter.first_block;
+        uint8_t blocks_in_sector = iter.blocks_in_sector;
 
-        if(sec_tr && mf_classic_is_key_found(app->mf_classic_data, sector, MfClassicKeyTypeB)) {
-            memcpy(keys_to_try[keys_count].data, sec_tr->key_b.data, 6);
-            key_types[keys_count] = MfClassicKeyTypeB;
-            keys_count++;
-        }
+        progress_tracker_update(app->progress, sector);
 
-        memset(keys_to_try[keys_count].data, 0xFF, 6);
-        key_types[keys_count] = MfClassicKeyTypeA;
-        keys_count++;
+        MfClassicKey keys_to_try[MIBAND_AUTH_CACHE_MAX_CANDIDATES];
+        MfClassicKeyType key_types[MIBAND_AUTH_CACHE_MAX_CANDIDATES];
+        size_t keys_count = miband_auth_cache_get_candidates(
+            app->auth_cache, app->mf_classic_data, sector, false, keys_to_try, key_types);
 
         bool sector_read = false;
-        for(int key_idx = 0; key_idx < keys_count && !sector_read; key_idx++) {
-            MfClassicAuthContext auth_context;
-            MfClassicError error = mf_classic_poller_sync_auth(
-                app->nfc, first_block, &keys_to_try[key_idx], key_types[key_idx], &auth_context);
-
-            if(error == MfClassicErrorNone) {
+        for(size_t key_idx = 0; key_idx < keys_count && !sector_read; key_idx++) {
+            // Read the whole sector in one auth session, its auth tests the key
+            MiBandSectorSessionRequest request = {
+                .op = MiBandSectorSessionOpRead,
+                .sector = sector,
+                .key = keys_to_try[key_idx],
+                .key_type = key_types[key_idx],
+                .block_mask = iter.full_mask,
+                .blocks = app->target_data->block,
+                .auth_cache = app->auth_cache,
+            };
+            MiBandSectorSessionResult session_result;
+            miband_sector_session_transfer(
+                app->nfc, &request, policy->max_attempts, &session_result);
+
+            if(session_result.authenticated) {
+                MfClassicError error;
+
+                // Fall back to per-block reads for whatever the session missed
                 bool all_read = true;
                 for(uint8_t block_in_sector = 0; block_in_sector < blocks_in_sector;
                     block_in_sector++) {
                     size_t block_idx = first_block + block_in_sector;
 
-                    error = mf_classic_poller_sync_read_block(
-                        app->nfc,
-                        block_idx,
-                        &keys_to_try[key_idx],
-                        key_types[key_idx],
-                        &app->target_data->block[block_idx]);
+                    if(session_result.done_mask & (1U << block_in_sector)) continue;
+
+                    MiBandRetry retry;
+                    miband_retry_init(&retry, policy);
+                    do {
+                        error = miband_op_stats_read_block(
+                            app->nfc,
+                            block_idx,
+                            &keys_to_try[key_idx],
+                            key_types[key_idx],
+                            &app->target_data->block[block_idx]);
+                    } while(error != MfClassicErrorNone && miband_retry_next(&retry, error));
 
                     if(error != MfClassicErrorNone) {
                         all_read = false;
@@ -126,13 +115,19 @@ static bool backup_read_all_data(MiBandNfcApp* app) {
 
         if(!sector_read) {
             FURI_LOG_W(TAG, "Failed to read sector %zu for backup", sector);
-            furi_string_free(progress);
             return false;
         }
+    }
+    progress_tracker_update(app->progress, iter.total_sectors);
 
-        furi_delay_ms(50);
+    if(app->logger) {
+        miband_logger_log(
+            app->logger,
+            LogLevelInfo,
+            "Backup: %lu auth attempts, %lu failed",
+            miband_auth_cache_get_attempts(app->auth_cache),
+            miband_auth_cache_get_failures(app->auth_cache));
     }
-    furi_string_free(progress);
     return true;
 }
 
@@ -168,12 +163,16 @@ void miband_nfc_scene_backup_on_enter(void* context) {
     }
 
     mf_classic_reset(app->target_data);
-    app->target_data->type = app->mf_classic_data->type;
+    app->target_snapshot_valid = false;
 
     popup_set_text(app->popup, "Detecting card...", 64, 30, AlignCenter, AlignTop);
+    miband_op_stats_begin(&app->op_stats, "Backup");
 
     MfClassicType detected_type;
-    if(mf_classic_poller_sync_detect_type(app->nfc, &detected_type) != MfClassicErrorNone) {
+    if(!miband_card_session_refresh(app->card_session, app->nfc) ||
+       miband_card_session_get_type(app->card_session, app->nfc, &detected_type) !=
+           MfClassicErrorNone) {
+        miband_op_stats_end(app->logger);
         notification_message(app->notifications, &sequence_error);
         popup_set_header(app->popup, "Card Not Found", 64, 4, AlignCenter, AlignTop);
         popup_set_text(app->popup, "Place card near\nFlipper Zero", 64, 22, AlignCenter, AlignTop);
@@ -182,7 +181,15 @@ void miband_nfc_scene_backup_on_enter(void* context) {
         return;
     }
 
-    if(!backup_read_all_data(app)) {
+    // Back up the whole card, which may hold more sectors than the dump
+    app->target_data->type = detected_type;
+    miband_auth_cache_reset_stats(app->auth_cache);
+
+    bool read_success = backup_read_all_data(app);
+    view_dispatcher_switch_to_view(app->view_dispatcher, MiBandNfcViewIdScanner);
+
+    if(!read_success) {
+        miband_op_stats_end(app->logger);
         if(app->logger) {
             miband_logger_log(app->logger, LogLevelError, "Backup: cannot read all sectors");
         }
@@ -194,6 +201,17 @@ void miband_nfc_scene_backup_on_enter(void* context) {
         return;
     }
 
+    // Writer uses this snapshot to skip blocks the band already holds
+    app->target_snapshot_valid = true;
+
+    // ...and the sector 1 key that worked instead of probing the band again
+    MfClassicKey sector_key;
+    MfClassicKeyType sector_key_type;
+    if(miband_auth_cache_get(app->auth_cache, 1, &sector_key, &sector_key_type)) {
+        miband_card_session_set_key_state(
+            app->card_session, miband_card_session_classify_key(&sector_key));
+    }
+
     DateTime datetime;
     furi_hal_rtc_get_datetime(&datetime);
 
@@ -207,49 +225,14 @@ void miband_nfc_scene_backup_on_enter(void* context) {
         datetime.minute,
         datetime.second);
 
-    popup_set_text(app->popup, "Saving backup...", 64, 11, AlignCenter, AlignTop);
-
-    nfc_device_set_data(app->nfc_device, NfcProtocolMfClassic, app->target_data);
-    bool save_success = nfc_device_save(app->nfc_device, furi_string_get_cstr(backup_path));
-    nfc_device_set_data(app->nfc_device, NfcProtocolMfClassic, app->mf_classic_data);
-
-    popup_reset(app->popup);
-
-    if(save_success) {
-        if(app->logger) {
-            miband_logger_log(
-                app->logger, LogLevelInfo, "Backup saved: %s", furi_string_get_cstr(backup_path));
-        }
-        notification_message(app->notifications, &sequence_success);
-        popup_set_header(app->popup, "Backup Created!", 64, 4, AlignCenter, AlignTop);
-
-        FuriString* msg = furi_string_alloc_printf(
-            "Saved to:\nbackups/backup_%04d%02d%02d\n_%02d%02d%02d.nfc",
-            datetime.year,
-            datetime.month,
-            datetime.day,
-            datetime.hour,
-            datetime.minute,
-            datetime.second);
-
-        popup_set_text(app->popup, furi_string_get_cstr(msg), 4, 18, AlignLeft, AlignTop);
-        popup_set_icon(app->popup, 90, 20, &I_DolphinSuccess_91x55);
-
-        furi_string_free(msg);
-        FURI_LOG_I(TAG, "Backup saved: %s", furi_string_get_cstr(backup_path));
-    } else {
-        if(app->logger) {
-            miband_logger_log(app->logger, LogLevelError, "Failed to save backup file");
-        }
-        notification_message(app->notifications, &sequence_error);
-        popup_set_header(app->popup, "Save Failed", 64, 4, AlignCenter, AlignTop);
-        popup_set_text(app->popup, "Cannot save\nbackup file", 64, 22, AlignCenter, AlignTop);
-        popup_set_icon(app->popup, 40, 28, &I_WarningDolphinFlip_45x42);
-        FURI_LOG_E(TAG, "Failed to save backup");
-    }
+    // The band stays in the field: save the file in the background and write right away.
+    // target_data is not touched by the save, it remains the writer's "before" image.
+    miband_backup_saver_start(
+        app->backup_saver, app->target_data, furi_string_get_cstr(backup_path));
+    miband_op_stats_end(app->logger);
+    FURI_LOG_I(TAG, "Backup queued: %s", furi_string_get_cstr(backup_path));
 
     furi_string_free(backup_path);
-    furi_delay_ms(3000);
 
     scene_manager_next_scene(app->scene_manager, MiBandNfcSceneWriter);
 }
@@ -0,0 +1,635 @@
+/**
+ * @file miband_nfc_scene_benchmark.c
+ * @brief Fixed timing suite for the NFC and storage hot paths
+ * 
+ * Listed in the settings menu only while the system Debug flag is set.
+ * A worker thread runs the same suite every time against a blank magic
+ * band (0xFF keys) in the field:
+ * 
+ * - auth with key A and key B, single block read and write
+ * - full card read, write and verify through sector sessions
+ * - nfc_device_save() and nfc_device_load() of the card just read
+ * - header-only UID scan over /ext/nfc
+ * 
+ * Every write puts back what was read, so the band keeps its content.
+ * Each measurement reports min/avg/max; the report goes to the log and is
+ * exported with miband_logger_export(), together with the app and firmware
+ * versions, so runs on different releases can be compared.
+ */
+
+#include "miband_nfc_i.h"
+#include "miband_nfc_header.h"
+#include "miband_dir_walker.h"
+#include <furi_hal.h>
+#include <furi_hal_version.h>
+#include <toolbox/version.h>
+#include <datetime/datetime.h>
+
+#define TAG "MiBandNfc"
+
+#define BENCHMARK_WORKER_STACK_SIZE (4 * 1024)
+#define BENCHMARK_SAMPLES           20 // Per single-block measurement
+#define BENCHMARK_ROUNDS            3 // Per full-card and storage measurement
+#define BENCHMARK_BLOCK             4 // First data block of sector 1
+#define BENCHMARK_CARD_POLL_MS      100
+#define BENCHMARK_DUMP_PATH         EXT_PATH("apps_data/miband_nfc/benchmark.nfc")
+
+#ifndef FAP_VERSION
+#define FAP_VERSION "?"
+#endif
+
+/**
+ * @brief Measurements of the suite
+ */
+typedef enum {
+    BenchmarkStatAuthA,
+    BenchmarkStatAuthB,
+    BenchmarkStatBlockRead,
+    BenchmarkStatBlockWrite,
+    BenchmarkStatCardRead,
+    BenchmarkStatCardWrite,
+    BenchmarkStatCardVerify,
+    BenchmarkStatDumpSave,
+    BenchmarkStatDumpLoad,
+    BenchmarkStatUidScan,
+    BenchmarkStatCount,
+} BenchmarkStatId;
+
+// Header, stop reason, one line per stat and the scan rate, all queued before the export
+_Static_assert(
+    BenchmarkStatCount + 3 <= MAX_LOG_TEXTS,
+    "Benchmark report overflows the log text queue");
+
+/**
+ * @brief Steps shown on the progress view
+ */
+typedef enum {
+    BenchmarkStepBlock,
+    BenchmarkStepCardRead,
+    BenchmarkStepCardWrite,
+    BenchmarkStepCardVerify,
+    BenchmarkStepStorage,
+    BenchmarkStepUidScan,
+    BenchmarkStepCount,
+} BenchmarkStep;
+
+/**
+ * @brief One measurement, in the unit of its stat_units entry
+ */
+typedef struct {
+    uint32_t count; // Successful samples
+    uint32_t failures;
+    uint32_t min;
+    uint32_t max;
+    uint32_t total;
+} BenchmarkStat;
+
+static const char* const stat_names[BenchmarkStatCount] = {
+    [BenchmarkStatAuthA] = "Auth A",
+    [BenchmarkStatAuthB] = "Auth B",
+    [BenchmarkStatBlockRead] = "Block read",
+    [BenchmarkStatBlockWrite] = "Block write",
+    [BenchmarkStatCardRead] = "Card read",
+    [BenchmarkStatCardWrite] = "Card write",
+    [BenchmarkStatCardVerify] = "Card verify",
+    [BenchmarkStatDumpSave] = "Dump save",
+    [BenchmarkStatDumpLoad] = "Dump load",
+    [BenchmarkStatUidScan] = "UID scan",
+};
+
+// Single NFC exchanges are a few ms long, they are timed on the cycle counter
+static const char* const stat_units[BenchmarkStatCount] = {
+    [BenchmarkStatAuthA] = "us",
+    [BenchmarkStatAuthB] = "us",
+    [BenchmarkStatBlockRead] = "us",
+    [BenchmarkStatBlockWrite] = "us",
+    [BenchmarkStatCardRead] = "ms",
+    [BenchmarkStatCardWrite] = "ms",
+    [BenchmarkStatCardVerify] = "ms",
+    [BenchmarkStatDumpSave] = "ms",
+    [BenchmarkStatDumpLoad] = "ms",
+    [BenchmarkStatUidScan] = "ms",
+};
+
+static const MfClassicKey benchmark_key = {.data = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}};
+
+/**
+ * @brief Benchmark state shared between the worker and the GUI thread
+ */
+typedef struct {
+    MiBandNfcApp* app;
+    FuriThread* thread;
+
+    volatile bool abort_requested;
+    volatile bool done;
+    const char* error; // Why the suite stopped early, NULL if it completed
+
+    MfClassicType type;
+    BenchmarkStat stats[BenchmarkStatCount];
+    uint32_t scan_files; // Dumps seen by the last UID scan pass
+
+    MfClassicData* card; // Content of the band, written back by the write tests
+    MfClassicData* readback; // Verify pass output
+    File* scan_file; // Reused by every header read of the UID scan
+    FuriString* report; // TextBox keeps the pointer
+} BenchmarkContext;
+
+static uint32_t benchmark_cycles(void) {
+    return DWT->CYCCNT;
+}
+
+static uint32_t benchmark_elapsed_us(uint32_t start_cycles) {
+    return (DWT->CYCCNT - start_cycles) / furi_hal_cortex_instructions_per_microsecond();
+}
+
+static void benchmark_record(BenchmarkStat* stat, uint32_t value, bool success) {
+    if(!success) {
+        stat->failures++;
+        return;
+    }
+
+    if(stat->count == 0 || value < stat->min) stat->min = value;
+    if(value > stat->max) stat->max = value;
+    stat->total += value;
+    stat->count++;
+}
+
+static uint32_t benchmark_avg(const BenchmarkStat* stat) {
+    return stat->count ? stat->total / stat->count : 0;
+}
+
+/**
+ * @brief Wait until a band answers in the field
+ * 
+ * @return false if aborted first
+ */
+static bool benchmark_wait_card(BenchmarkContext* ctx) {
+    Iso14443_3aData iso_data;
+    while(!ctx->abort_requested) {
+        if(miband_card_io_activate(ctx->app->nfc, &iso_data) == Iso14443_3aErrorNone) {
+            return true;
+        }
+        furi_delay_ms(BENCHMARK_CARD_POLL_MS);
+    }
+    return false;
+}
+
+/**
+ * @brief Time single auth handshakes and single block transfers on BENCHMARK_BLOCK
+ * 
+ * The block write puts back the content of the first successful read.
+ */
+static void benchmark_block_ops(BenchmarkContext* ctx) {
+    Nfc* nfc = ctx->app->nfc;
+    MfClassicKey key = benchmark_key;
+    MfClassicAuthContext auth_context;
+    MfClassicBlock block;
+    bool have_block = false;
+
+    for(size_t i = 0; i < BENCHMARK_SAMPLES && !ctx->abort_requested; i++) {
+        uint32_t start = benchmark_cycles();
+        MfClassicError error = miband_card_io_auth(
+            nfc, BENCHMARK_BLOCK, &key, MfClassicKeyTypeA, &auth_context);
+        benchmark_record(
+            &ctx->stats[BenchmarkStatAuthA],
+            benchmark_elapsed_us(start),
+            error == MfClassicErrorNone);
+
+        start = benchmark_cycles();
+        error = miband_card_io_auth(nfc, BENCHMARK_BLOCK, &key, MfClassicKeyTypeB, &auth_context);
+        benchmark_record(
+            &ctx->stats[BenchmarkStatAuthB],
+            benchmark_elapsed_us(start),
+            error == MfClassicErrorNone);
+
+        MfClassicBlock read_block;
+        start = benchmark_cycles();
+        error = miband_card_io_read_block(
+            nfc, BENCHMARK_BLOCK, &key, MfClassicKeyTypeA, &read_block);
+        benchmark_record(
+            &ctx->stats[BenchmarkStatBlockRead],
+            benchmark_elapsed_us(start),
+            error == MfClassicErrorNone);
+        if(error == MfClassicErrorNone && !have_block) {
+            block = read_block;
+            have_block = true;
+        }
+
+        if(!have_block) continue;
+        start = benchmark_cycles();
+        error = miband_card_io_write_block(nfc, BENCHMARK_BLOCK, &key, MfClassicKeyTypeA, &block);
+        benchmark_record(
+            &ctx->stats[BenchmarkStatBlockWrite],
+            benchmark_elapsed_us(start),
+            error == MfClassicErrorNone);
+    }
+}
+
+/**
+ * @brief Transfer every sector of the band, one sector session each
+ * 
+ * @param ctx Benchmark context
+ * @param op Read or write
+ * @param data_only Only data blocks (no Block 0, no trailers), as write and verify do
+ * @param data Block source or destination
+ * @return true if every requested block was transferred
+ */
+static bool benchmark_card_transfer(
+    BenchmarkContext* ctx,
+    MiBandSectorSessionOp op,
+    bool data_only,
+    MfClassicData* data) {
+    const MiBandRetryPolicy* policy = &miband_nfc_get_profile(ctx->app)->retry;
+
+    MiBandSectorIter iter;
+    miband_sector_iter_init(&iter, ctx->type);
+    while(miband_sector_iter_next(&iter)) {
+        if(ctx->abort_requested) return false;
+
+        MiBandSectorSessionRequest request = {
+            .op = op,
+            .sector = iter.sector,
+            .key = benchmark_key,
+            .key_type = MfClassicKeyTypeA,
+            .block_mask = data_only ? iter.data_mask : iter.full_mask,
+            .blocks = data->block,
+        };
+        MiBandSectorSessionResult result;
+        if(!miband_sector_session_transfer(
+               ctx->app->nfc, &request, policy->max_attempts, &result)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Time full card read, write-back and verify passes
+ * 
+ * @return Error text, NULL if the band could be read
+ */
+static const char* benchmark_card_ops(BenchmarkContext* ctx) {
+    MiBandNfcApp* app = ctx->app;
+    ctx->card->type = ctx->type;
+    ctx->readback->type = ctx->type;
+
+    progress_tracker_set_status(app->progress, "Full card read");
+    for(size_t round = 0; round < BENCHMARK_ROUNDS && !ctx->abort_requested; round++) {
+        uint32_t start = furi_get_tick();
+        bool success = benchmark_card_transfer(ctx, MiBandSectorSessionOpRead, false, ctx->card);
+        benchmark_record(&ctx->stats[BenchmarkStatCardRead], furi_get_tick() - start, success);
+    }
+    progress_tracker_update(app->progress, BenchmarkStepCardRead + 1);
+    if(ctx->stats[BenchmarkStatCardRead].count == 0) return "Full card read\nfailed";
+
+    progress_tracker_set_status(app->progress, "Full card write");
+    for(size_t round = 0; round < BENCHMARK_ROUNDS && !ctx->abort_requested; round++) {
+        uint32_t start = furi_get_tick();
+        bool success = benchmark_card_transfer(ctx, MiBandSectorSessionOpWrite, true, ctx->card);
+        benchmark_record(&ctx->stats[BenchmarkStatCardWrite], furi_get_tick() - start, success);
+    }
+    progress_tracker_update(app->progress, BenchmarkStepCardWrite + 1);
+
+    progress_tracker_set_status(app->progress, "Full card verify");
+    for(size_t round = 0; round < BENCHMARK_ROUNDS && !ctx->abort_requested; round++) {
+        uint32_t start = furi_get_tick();
+        bool success =
+            benchmark_card_transfer(ctx, MiBandSectorSessionOpRead, true, ctx->readback) &&
+            miband_block_diff_collect(ctx->card, ctx->readback, NULL, 0) == 0;
+        benchmark_record(&ctx->stats[BenchmarkStatCardVerify], furi_get_tick() - start, success);
+    }
+    progress_tracker_update(app->progress, BenchmarkStepCardVerify + 1);
+    return NULL;
+}
+
+/**
+ * @brief Time saving and parsing the card just read as a reference dump
+ */
+static void benchmark_storage_ops(BenchmarkContext* ctx) {
+    MiBandNfcApp* app = ctx->app;
+    progress_tracker_set_status(app->progress, "Dump save/load");
+
+    // Every block and key present, so the reference dump is a full one
+    memset(ctx->card->block_read_mask, 0xFF, sizeof(ctx->card->block_read_mask));
+    ctx->card->key_a_mask = UINT64_MAX;
+    ctx->card->key_b_mask = UINT64_MAX;
+
+    NfcDevice* device = nfc_device_alloc();
+    nfc_device_set_data(device, NfcProtocolMfClassic, ctx->card);
+
+    for(size_t round = 0; round < BENCHMARK_ROUNDS && !ctx->abort_requested; round++) {
+        uint32_t start = furi_get_tick();
+        bool success = nfc_device_save(device, BENCHMARK_DUMP_PATH);
+        benchmark_record(&ctx->stats[BenchmarkStatDumpSave], furi_get_tick() - start, success);
+    }
+
+    if(ctx->stats[BenchmarkStatDumpSave].count > 0) {
+        for(size_t round = 0; round < BENCHMARK_ROUNDS && !ctx->abort_requested; round++) {
+            uint32_t start = furi_get_tick();
+            bool success = nfc_device_load(device, BENCHMARK_DUMP_PATH);
+            benchmark_record(
+                &ctx->stats[BenchmarkStatDumpLoad], furi_get_tick() - start, success);
+        }
+    }
+
+    nfc_device_free(device);
+    storage_common_remove(app->storage, BENCHMARK_DUMP_PATH);
+    progress_tracker_update(app->progress, BenchmarkStepStorage + 1);
+}
+
+static bool benchmark_scan_callback(const char* path, const FileInfo* info, void* context) {
+    UNUSED(info);
+    BenchmarkContext* ctx = context;
+
+    MiBandNfcHeader header;
+    miband_nfc_header_read(ctx->scan_file, path, &header);
+    ctx->scan_files++;
+    return !ctx->abort_requested;
+}
+
+/**
+ * @brief Time the cold UID scan: tree walk plus one header read per dump
+ */
+static void benchmark_uid_scan(BenchmarkContext* ctx) {
+    MiBandNfcApp* app = ctx->app;
+    progress_tracker_set_status(app->progress, "UID scan of /ext/nfc");
+
+    for(size_t round = 0; round < BENCHMARK_ROUNDS && !ctx->abort_requested; round++) {
+        ctx->scan_files = 0;
+        uint32_t start = furi_get_tick();
+        // Same tree as the UID check walks
+        bool success = miband_dir_walk(
+            app->storage,
+            NFC_APP_FOLDER,
+            BACKUP_FOLDER,
+            NFC_APP_EXTENSION,
+            benchmark_scan_callback,
+            ctx);
+        benchmark_record(&ctx->stats[BenchmarkStatUidScan], furi_get_tick() - start, success);
+    }
+    progress_tracker_update(app->progress, BenchmarkStepUidScan + 1);
+}
+
+/**
+ * @brief Run the suite
+ * 
+ * @return Error text, NULL if every step ran
+ */
+static const char* benchmark_run(BenchmarkContext* ctx) {
+    MiBandNfcApp* app = ctx->app;
+
+    if(!benchmark_wait_card(ctx)) return NULL;
+    if(miband_card_io_detect_type(app->nfc, &ctx->type) != MfClassicErrorNone) {
+        return "Not a Mifare\nClassic band";
+    }
+
+    MfClassicKey key = benchmark_key;
+    MfClassicAuthContext auth_context;
+    if(miband_card_io_auth(app->nfc, 0, &key, MfClassicKeyTypeA, &auth_context) !=
+       MfClassicErrorNone) {
+        return "Needs a blank\nmagic band";
+    }
+
+    progress_tracker_reset(app->progress, BenchmarkStepCount, "Step");
+    progress_tracker_set_header(app->progress, "Benchmark");
+    progress_tracker_set_status(app->progress, "Auth, block read/write");
+    benchmark_block_ops(ctx);
+    progress_tracker_update(app->progress, BenchmarkStepBlock + 1);
+
+    const char* error = benchmark_card_ops(ctx);
+    if(error || ctx->abort_requested) return error;
+
+    benchmark_storage_ops(ctx);
+    benchmark_uid_scan(ctx);
+    return NULL;
+}
+
+static int32_t benchmark_worker_thread(void* context) {
+    BenchmarkContext* ctx = context;
+
+    ctx->error = benchmark_run(ctx);
+    ctx->done = true;
+    if(!ctx->abort_requested) {
+        view_dispatcher_send_custom_event(
+            ctx->app->view_dispatcher, MiBandNfcCustomEventBenchmarkDone);
+    }
+    return 0;
+}
+
+/**
+ * @brief Abort (if still running), join and free the benchmark worker
+ * 
+ * The worker checks the abort flag between samples and between sectors.
+ * 
+ * @param app Pointer to MiBandNfcApp instance
+ */
+static void benchmark_worker_stop(MiBandNfcApp* app) {
+    BenchmarkContext* ctx = app->benchmark_context;
+    if(!ctx) return;
+
+    if(ctx->thread) {
+        ctx->abort_requested = true;
+        furi_thread_join(ctx->thread);
+        furi_thread_free(ctx->thread);
+    }
+
+    mf_classic_free(ctx->card);
+    mf_classic_free(ctx->readback);
+    storage_file_free(ctx->scan_file);
+    furi_string_free(ctx->report);
+    free(ctx);
+    app->benchmark_context = NULL;
+}
+
+/**
+ * @brief Append one measurement to the report and the log
+ */
+static void benchmark_report_stat(MiBandNfcApp* app, BenchmarkContext* ctx, BenchmarkStatId id) {
+    const BenchmarkStat* stat = &ctx->stats[id];
+    if(stat->count == 0 && stat->failures == 0) return;
+
+    furi_string_cat_printf(
+        ctx->report,
+        "\n%s: %lu ok, %lu failed\n min %lu avg %lu max %lu %s\n",
+        stat_names[id],
+        stat->count,
+        stat->failures,
+        stat->min,
+        benchmark_avg(stat),
+        stat->max,
+        stat_units[id]);
+    miband_logger_log(
+        app->logger,
+        LogLevelInfo,
+        "Bench %s: %lu ok, %lu failed, min %lu avg %lu max %lu %s",
+        stat_names[id],
+        stat->count,
+        stat->failures,
+        stat->min,
+        benchmark_avg(stat),
+        stat->max,
+        stat_units[id]);
+}
+
+/**
+ * @brief Format, log and export the results, then show them
+ * 
+ * The numbers are logged even with logging turned off, the export is the
+ * point of the run.
+ * 
+ * @param app Pointer to MiBandNfcApp instance
+ * @param ctx Finished benchmark context
+ */
+static void benchmark_show_report(MiBandNfcApp* app, BenchmarkContext* ctx) {
+    miband_logger_set_enabled(app->logger, true);
+
+    const Version* firmware = furi_hal_version_get_firmware_version();
+    furi_string_printf(
+        ctx->report,
+        "App %s, FW %s (%s)\n%u sectors, profile %s\n",
+        FAP_VERSION,
+        version_get_version(firmware),
+        version_get_githash(firmware),
+        mf_classic_get_total_sectors_num(ctx->type),
+        miband_pipeline_get_profile_name(app->pipeline_profile));
+    miband_logger_log(
+        app->logger,
+        LogLevelInfo,
+        "Bench: app %s, fw %s (%s), %u sectors, profile %s",
+        FAP_VERSION,
+        version_get_version(firmware),
+        version_get_githash(firmware),
+        mf_classic_get_total_sectors_num(ctx->type),
+        miband_pipeline_get_profile_name(app->pipeline_profile));
+
+    if(ctx->error) {
+        furi_string_cat_printf(ctx->report, "\nStopped: %s\n", ctx->error);
+        miband_logger_log(app->logger, LogLevelWarning, "Bench stopped: %s", ctx->error);
+    }
+
+    for(size_t id = 0; id < BenchmarkStatCount; id++) {
+        benchmark_report_stat(app, ctx, id);
+    }
+
+    const BenchmarkStat* scan = &ctx->stats[BenchmarkStatUidScan];
+    if(scan->count > 0) {
+        // Slowest pass gives the lowest rate
+        uint32_t files = ctx->scan_files;
+        furi_string_cat_printf(
+            ctx->report,
+            " %lu files, %lu/%lu/%lu files/s\n",
+            files,
+            files * 1000 / MAX(scan->max, 1UL),
+            files * 1000 / MAX(benchmark_avg(scan), 1UL),
+            files * 1000 / MAX(scan->min, 1UL));
+        miband_logger_log(
+            app->logger,
+            LogLevelInfo,
+            "Bench UID scan: %lu files, min %lu avg %lu max %lu files/s",
+            files,
+            files * 1000 / MAX(scan->max, 1UL),
+            files * 1000 / MAX(benchmark_avg(scan), 1UL),
+            files * 1000 / MAX(scan->min, 1UL));
+    }
+
+    DateTime dt;
+    furi_hal_rtc_get_datetime(&dt);
+    FuriString* filename = furi_string_alloc_printf(
+        "bench_%04d%02d%02d_%02d%02d%02d.txt",
+        dt.year,
+        dt.month,
+        dt.day,
+        dt.hour,
+        dt.minute,
+        dt.second);
+    bool exported = miband_logger_export(app->logger, furi_string_get_cstr(filename));
+    furi_string_cat_printf(
+        ctx->report,
+        exported ? "\nExported to\nlogs/%s\n" : "\nExport of %s failed\n",
+        furi_string_get_cstr(filename));
+    furi_string_free(filename);
+
+    miband_logger_set_enabled(app->logger, app->enable_logging);
+
+    notification_message(app->notifications, &sequence_blink_stop);
+    notification_message(app->notifications, ctx->error ? &sequence_error : &sequence_success);
+
+    text_box_set_text(app->text_box, furi_string_get_cstr(ctx->report));
+    text_box_set_font(app->text_box, TextBoxFontText);
+    text_box_set_focus(app->text_box, TextBoxFocusStart);
+    view_dispatcher_switch_to_view(app->view_dispatcher, MiBandNfcViewIdAbout);
+}
+
+/**
+ * @brief Scene entry point
+ * 
+ * @param context Pointer to MiBandNfcApp instance
+ */
+void miband_nfc_scene_benchmark_on_enter(void* context) {
+    furi_assert(context);
+    MiBandNfcApp* app = context;
+
+    BenchmarkContext* ctx = malloc(sizeof(BenchmarkContext));
+    memset(ctx, 0, sizeof(BenchmarkContext));
+    ctx->app = app;
+    ctx->card = mf_classic_alloc();
+    ctx->readback = mf_classic_alloc();
+    ctx->scan_file = storage_file_alloc(app->storage);
+    ctx->report = furi_string_alloc();
+    app->benchmark_context = ctx;
+
+    progress_tracker_reset(app->progress, BenchmarkStepCount, "Step");
+    progress_tracker_set_header(app->progress, "Benchmark");
+    progress_tracker_set_status(app->progress, "Place blank magic band");
+    view_dispatcher_switch_to_view(app->view_dispatcher, MiBandNfcViewIdProgress);
+    notification_message(app->notifications, &sequence_blink_start_cyan);
+
+    ctx->thread = furi_thread_alloc_ex(
+        "MiBandBenchmark", BENCHMARK_WORKER_STACK_SIZE, benchmark_worker_thread, ctx);
+    furi_thread_start(ctx->thread);
+}
+
+/**
+ * @brief Scene event handler
+ * 
+ * @param context Pointer to MiBandNfcApp instance
+ * @param event Scene manager event
+ * @return true if event was consumed, false otherwise
+ */
+bool miband_nfc_scene_benchmark_on_event(void* context, SceneManagerEvent event) {
+    MiBandNfcApp* app = context;
+    bool consumed = false;
+
+    if(event.type == SceneManagerEventTypeCustom) {
+        if(event.event == MiBandNfcCustomEventBenchmarkDone) {
+            BenchmarkContext* ctx = app->benchmark_context;
+            if(ctx && ctx->done && ctx->thread) {
+                furi_thread_join(ctx->thread);
+                furi_thread_free(ctx->thread);
+                ctx->thread = NULL;
+                benchmark_show_report(app, ctx);
+            }
+            consumed = true;
+        }
+    } else if(event.type == SceneManagerEventTypeBack) {
+        // Aborts a run in progress; nothing is exported for it
+        scene_manager_previous_scene(app->scene_manager);
+        consumed = true;
+    }
+
+    return consumed;
+}
+
+/**
+ * @brief Scene exit handler
+ * 
+ * @param context Pointer to MiBandNfcApp instance
+ */
+void miband_nfc_scene_benchmark_on_exit(void* context) {
+    MiBandNfcApp* app = context;
+
+    // The TextBox points into the report, drop it before the context goes
+    text_box_reset(app->text_box);
+    benchmark_worker_stop(app);
+    notification_message(app->notifications, &sequence_blink_stop);
+}
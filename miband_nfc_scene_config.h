@@ -9,6 +9,9 @@ ADD_SCENE(miband_nfc, main_menu, MainMenu)
 // File selection - browse and select NFC dump files
 ADD_SCENE(miband_nfc, file_select, FileSelect)
 
+// Recent dumps - reopen a cached dump without the browser
+ADD_SCENE(miband_nfc, recent_dumps, RecentDumps)
+
 // Magic card emulation - emulate blank template with 0xFF keys
 ADD_SCENE(miband_nfc, magic_emulator, MagicEmulator)
 
@@ -24,6 +27,9 @@ ADD_SCENE(miband_nfc, writer, Writer)
 // Magic saver - convert and save dump with magic keys
 ADD_SCENE(miband_nfc, magic_saver, MagicSaver)
 
+// Magic folder - convert every dump of a folder on a worker thread
+ADD_SCENE(miband_nfc, magic_folder, MagicFolder)
+
 // Verify - read and compare data with original dump
 ADD_SCENE(miband_nfc, verify, Verify)
 
@@ -33,6 +39,12 @@ ADD_SCENE(miband_nfc, diff_viewer, DiffViewer)
 // UID Check - quick UID display with disk scanner (NEW)
 ADD_SCENE(miband_nfc, uid_check, UidCheck)
 
+// Stats - timing of the last backup/write/verify run
+ADD_SCENE(miband_nfc, stats, Stats)
+
+// Benchmark - fixed timing suite, listed in settings in Debug mode only
+ADD_SCENE(miband_nfc, benchmark, Benchmark)
+
 // About - display help and usage information
 ADD_SCENE(miband_nfc, about, About)
 
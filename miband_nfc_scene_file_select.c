@@ -7,6 +7,94 @@
 
 #define TAG "MiBandNfc"
 
+const char* miband_nfc_load_dump(MiBandNfcApp* app, bool* from_cache) {
+    furi_assert(app);
+
+    const char* path = furi_string_get_cstr(app->file_path);
+    if(from_cache) *from_cache = false;
+    app->is_valid_nfc_data = false;
+
+    if(miband_dump_cache_get(app->dump_cache, app->storage, path, app->mf_classic_data)) {
+        FURI_LOG_D(TAG, "Loaded from cache: %s", path);
+        if(app->logger) {
+            miband_logger_log(app->logger, LogLevelInfo, "MfClassic file loaded from cache");
+        }
+        if(from_cache) *from_cache = true;
+        app->is_valid_nfc_data = true;
+        return NULL;
+    }
+
+    if(app->dump_sidecar && miband_dump_sidecar_load(app->storage, path, app->mf_classic_data)) {
+        FURI_LOG_D(TAG, "Loaded from sidecar: %s", path);
+        miband_dump_cache_put(app->dump_cache, app->storage, path, app->mf_classic_data);
+        app->is_valid_nfc_data = true;
+        return NULL;
+    }
+
+    if(!nfc_device_load(app->nfc_device, path)) {
+        FURI_LOG_E(TAG, "Failed to load file: %s", path);
+        if(app->logger) {
+            miband_logger_log(app->logger, LogLevelError, "Failed to load file: %s", path);
+        }
+        return "Load failed";
+    }
+
+    if(nfc_device_get_protocol(app->nfc_device) != NfcProtocolMfClassic) {
+        FURI_LOG_W(TAG, "File is not Mifare Classic protocol.");
+        if(app->logger) {
+            miband_logger_log(app->logger, LogLevelWarning, "File is not MfClassic protocol");
+        }
+        return "Not MF Classic";
+    }
+
+    const MfClassicData* loaded_data = nfc_device_get_data(app->nfc_device, NfcProtocolMfClassic);
+    if(loaded_data == NULL) {
+        FURI_LOG_E(TAG, "Failed to get MfClassic data from loaded file");
+        return "Invalid data";
+    }
+
+    FURI_LOG_D(TAG, "Loaded file: %s", path);
+    if(app->logger) {
+        miband_logger_log(app->logger, LogLevelInfo, "MfClassic file loaded successfully");
+    }
+
+    mf_classic_copy(app->mf_classic_data, loaded_data);
+    miband_dump_cache_put(app->dump_cache, app->storage, path, loaded_data);
+    if(app->dump_sidecar) miband_dump_sidecar_save(app->storage, path, loaded_data);
+    app->is_valid_nfc_data = true;
+    return NULL;
+}
+
+void miband_nfc_start_operation(MiBandNfcApp* app) {
+    furi_assert(app);
+
+    switch(app->current_operation) {
+    case OperationTypeEmulateMagic:
+        scene_manager_next_scene(app->scene_manager, MiBandNfcSceneMagicEmulator);
+        break;
+    case OperationTypeWriteOriginal:
+        if(app->auto_backup_enabled) {
+            scene_manager_next_scene(app->scene_manager, MiBandNfcSceneBackup);
+        } else {
+            scene_manager_next_scene(app->scene_manager, MiBandNfcSceneWriter);
+        }
+        break;
+    case OperationTypeBatchWrite:
+        // One dump for many bands: no per-band backup
+        scene_manager_next_scene(app->scene_manager, MiBandNfcSceneWriter);
+        break;
+    case OperationTypeSaveMagic:
+        scene_manager_next_scene(app->scene_manager, MiBandNfcSceneMagicSaver);
+        break;
+    case OperationTypeVerify:
+        scene_manager_next_scene(app->scene_manager, MiBandNfcSceneVerify);
+        break;
+    default:
+        scene_manager_previous_scene(app->scene_manager);
+        break;
+    }
+}
+
 void miband_nfc_scene_file_select_on_enter(void* context) {
     furi_assert(context);
     MiBandNfcApp* app = context;
@@ -44,74 +132,22 @@ void miband_nfc_scene_file_select_on_enter(void* context) {
     popup_set_header(app->popup, "Loading...", 64, 4, AlignCenter, AlignTop);
     popup_set_text(app->popup, "Reading file", 64, 30, AlignCenter, AlignTop);
     view_dispatcher_switch_to_view(app->view_dispatcher, MiBandNfcViewIdScanner);
-    furi_delay_ms(100); // Show loading message
-
-    if(nfc_device_load(app->nfc_device, furi_string_get_cstr(app->file_path))) {
-        FURI_LOG_D(TAG, "Loaded file: %s", furi_string_get_cstr(app->file_path));
-
-        if(nfc_device_get_protocol(app->nfc_device) == NfcProtocolMfClassic) {
-            const MfClassicData* loaded_data =
-                nfc_device_get_data(app->nfc_device, NfcProtocolMfClassic);
-            if(app->logger) {
-                miband_logger_log(app->logger, LogLevelInfo, "MfClassic file loaded successfully");
-            }
-            if(loaded_data == NULL) {
-                FURI_LOG_E(TAG, "Failed to get MfClassic data from loaded file");
-                popup_set_text(app->popup, "Invalid data", 64, 30, AlignCenter, AlignTop);
-                furi_delay_ms(1000);
-                scene_manager_previous_scene(app->scene_manager);
-                return;
-            }
-
-            mf_classic_copy(app->mf_classic_data, loaded_data);
-            app->is_valid_nfc_data = true;
-
-            popup_set_text(app->popup, "File loaded!", 64, 30, AlignCenter, AlignTop);
-            furi_delay_ms(500);
-
-            switch(app->current_operation) {
-            case OperationTypeEmulateMagic:
-                scene_manager_next_scene(app->scene_manager, MiBandNfcSceneMagicEmulator);
-                break;
-            case OperationTypeWriteOriginal:
-                if(app->auto_backup_enabled) {
-                    scene_manager_next_scene(app->scene_manager, MiBandNfcSceneBackup);
-                } else {
-                    scene_manager_next_scene(app->scene_manager, MiBandNfcSceneWriter);
-                }
-                break;
-            case OperationTypeSaveMagic:
-                scene_manager_next_scene(app->scene_manager, MiBandNfcSceneMagicSaver);
-                break;
-            case OperationTypeVerify:
-                scene_manager_next_scene(app->scene_manager, MiBandNfcSceneVerify);
-                break;
-            default:
-                scene_manager_previous_scene(app->scene_manager);
-                break;
-            }
-        } else {
-            FURI_LOG_W(TAG, "File is not Mifare Classic protocol.");
-            if(app->logger) {
-                miband_logger_log(app->logger, LogLevelWarning, "File is not MfClassic protocol");
-            }
-            popup_set_text(app->popup, "Not MF Classic", 64, 30, AlignCenter, AlignTop);
-            furi_delay_ms(1000);
-            scene_manager_previous_scene(app->scene_manager);
-        }
-    } else {
-        FURI_LOG_E(TAG, "Failed to load file: %s", furi_string_get_cstr(app->file_path));
-        if(app->logger) {
-            miband_logger_log(
-                app->logger,
-                LogLevelError,
-                "Failed to load file: %s",
-                furi_string_get_cstr(app->file_path));
-        }
-        popup_set_text(app->popup, "Load failed", 64, 30, AlignCenter, AlignTop);
+
+    bool from_cache = false;
+    const char* error = miband_nfc_load_dump(app, &from_cache);
+    if(error) {
+        popup_set_text(app->popup, error, 64, 30, AlignCenter, AlignTop);
         furi_delay_ms(1000);
         scene_manager_previous_scene(app->scene_manager);
+        return;
+    }
+
+    if(!from_cache) {
+        popup_set_text(app->popup, "File loaded!", 64, 30, AlignCenter, AlignTop);
+        furi_delay_ms(500);
     }
+
+    miband_nfc_start_operation(app);
 }
 
 bool miband_nfc_scene_file_select_on_event(void* context, SceneManagerEvent event) {
@@ -4,20 +4,47 @@
  */
 
 #include "miband_nfc_i.h"
+#include <stdatomic.h>
 
 #define TAG "MiBandNfc"
 
+#define EMULATION_REFRESH_MS  500
+#define EMULATION_MAX_AUTHS   100 // Safety stop
+#define EMULATION_VIBRO_EVERY 5
+#define EMULATION_LOG_EVERY   10
+#define EMULATION_TEXT_SIZE   96
+
+/**
+ * @brief Last thing the listener saw, stored as a code so the callback never formats
+ */
+typedef enum {
+    EmulationActivityStarted,
+    EmulationActivityAuthPart,
+    EmulationActivityAuthComplete,
+    EmulationActivitySafetyStop,
+} EmulationActivity;
+
+/**
+ * @brief Emulation statistics
+ *
+ * The listener callback runs in the NFC worker's timing-critical context:
+ * it only bumps the atomic counters below, it never locks, allocates or
+ * formats. The periodic timer asks the GUI thread to render, which formats
+ * the popup text only when a value changed.
+ */
 typedef struct {
-    uint32_t auth_attempts;
-    uint32_t successful_auths;
-    uint32_t failed_auths;
-    uint32_t reader_connections;
-    uint32_t data_reads;
-    FuriString* last_activity;
-    FuriString* status_message;
-    bool is_active;
+    // Listener side
+    atomic_uint_fast32_t auth_attempts;
+    atomic_uint_fast8_t activity; // EmulationActivity
+    atomic_bool is_active;
+
+    // GUI side
+    uint32_t shown_auths;
+    EmulationActivity shown_activity;
+    bool shown;
+    uint8_t uid[4];
+    char text[EMULATION_TEXT_SIZE]; // Popup keeps the pointer
     FuriTimer* update_timer;
-    FuriMutex* mutex;
 } EmulationStats;
 
 static void emulation_stats_free(EmulationStats* stats) {
@@ -29,136 +56,90 @@ static void emulation_stats_free(EmulationStats* stats) {
         stats->update_timer = NULL;
     }
 
-    if(stats->mutex) {
-        if(furi_mutex_acquire(stats->mutex, 200) == FuriStatusOk) {
-            stats->is_active = false;
-
-            if(stats->last_activity) {
-                furi_string_free(stats->last_activity);
-                stats->last_activity = NULL;
-            }
-
-            if(stats->status_message) {
-                furi_string_free(stats->status_message);
-                stats->status_message = NULL;
-            }
-        }
-
-        furi_mutex_free(stats->mutex);
-        stats->mutex = NULL;
-    } else {
-        stats->is_active = false;
-
-        if(stats->last_activity) {
-            furi_string_free(stats->last_activity);
-            stats->last_activity = NULL;
-        }
-
-        if(stats->status_message) {
-            furi_string_free(stats->status_message);
-            stats->status_message = NULL;
-        }
-    }
-
     free(stats);
 }
 
 static void emulation_timer_callback(void* context) {
-    if(!context) return;
-
-    MiBandNfcApp* app = (MiBandNfcApp*)context;
-
-    if(!app || !app->popup || !app->view_dispatcher) {
-        return;
-    }
-
-    if(!app->is_emulating) {
-        return;
-    }
-
-    if(!app->emulation_stats) {
-        return;
-    }
+    MiBandNfcApp* app = context;
+    view_dispatcher_send_custom_event(app->view_dispatcher, MiBandNfcCustomEventEmulatorTick);
+}
 
-    EmulationStats* stats = (EmulationStats*)app->emulation_stats;
+/**
+ * @brief Refresh the popup from the counters, GUI thread only
+ *
+ * Returns right away when nothing changed since the last render; otherwise
+ * also fires the vibration and log milestones the callback used to.
+ */
+static void emulation_stats_render(MiBandNfcApp* app, EmulationStats* stats) {
+    uint32_t auths = atomic_load_explicit(&stats->auth_attempts, memory_order_relaxed);
+    EmulationActivity activity = atomic_load_explicit(&stats->activity, memory_order_relaxed);
 
-    if(!stats || !stats->mutex) {
+    if(stats->shown && auths == stats->shown_auths && activity == stats->shown_activity) {
         return;
     }
 
-    if(furi_mutex_acquire(stats->mutex, 50) != FuriStatusOk) {
-        return;
+    if(auths / EMULATION_VIBRO_EVERY > stats->shown_auths / EMULATION_VIBRO_EVERY) {
+        notification_message(app->notifications, &sequence_single_vibro);
     }
-
-    bool is_active = stats->is_active;
-    uint32_t auth_attempts = stats->auth_attempts;
-    uint32_t successful_auths = stats->successful_auths;
-    const char* last_activity = furi_string_get_cstr(stats->last_activity);
-    const char* status_message = furi_string_get_cstr(stats->status_message);
-
-    furi_mutex_release(stats->mutex);
-
-    if(!is_active) {
-        return;
+    if(app->logger && auths / EMULATION_LOG_EVERY > stats->shown_auths / EMULATION_LOG_EVERY) {
+        miband_logger_log(
+            app->logger, LogLevelDebug, "Magic emulation: %lu authentications completed", auths);
     }
-
-    FuriString* stats_text = furi_string_alloc();
-    if(!stats_text) return;
-
-    furi_string_printf(stats_text, "UID+0xFF template\n");
-    furi_string_cat_printf(stats_text, "Auth: %lu | OK %lu\n", auth_attempts, successful_auths);
-
-    if(last_activity) {
-        furi_string_cat_printf(stats_text, "%s\n", last_activity);
+    if(activity == EmulationActivitySafetyStop && stats->shown_activity != activity) {
+        FURI_LOG_W(TAG, "Too many auth attempts (%lu), stopping", auths);
+        if(app->logger) {
+            miband_logger_log(
+                app->logger,
+                LogLevelWarning,
+                "Magic emulation stopped: too many auth attempts (%lu)",
+                auths);
+        }
     }
 
-    if(status_message) {
-        furi_string_cat_printf(stats_text, "%s\n", status_message);
+    stats->shown = true;
+    stats->shown_auths = auths;
+    stats->shown_activity = activity;
+
+    const char* status;
+    switch(activity) {
+    case EmulationActivityAuthPart:
+        status = "Auth data collected";
+        break;
+    case EmulationActivityAuthComplete:
+        status = auths >= EMULATION_VIBRO_EVERY ? "Mi Band actively reading" :
+                                                  "Authentication successful";
+        break;
+    case EmulationActivitySafetyStop:
+        status = "Too many auths - stopped";
+        break;
+    default:
+        status = "Template ready";
+        break;
     }
 
-    furi_string_cat_str(stats_text, "Back=Stop");
-
-    popup_reset(app->popup);
-    popup_set_header(app->popup, "Magic Template Active", 64, 2, AlignCenter, AlignTop);
-    popup_set_text(app->popup, furi_string_get_cstr(stats_text), 2, 12, AlignLeft, AlignTop);
-    popup_set_icon(app->popup, 68, 20, &I_NFC_dolphin_emulation_51x64);
-
-    furi_string_free(stats_text);
+    snprintf(
+        stats->text,
+        sizeof(stats->text),
+        "UID %02X%02X%02X%02X\nAuth: %lu\n%s\nBack=Stop",
+        stats->uid[0],
+        stats->uid[1],
+        stats->uid[2],
+        stats->uid[3],
+        auths,
+        status);
+    popup_set_text(app->popup, stats->text, 2, 12, AlignLeft, AlignTop);
 }
 
 static EmulationStats* emulation_stats_alloc(MiBandNfcApp* app) {
     EmulationStats* stats = malloc(sizeof(EmulationStats));
-    if(!stats) return NULL;
-
     memset(stats, 0, sizeof(EmulationStats));
 
-    stats->auth_attempts = 0;
-    stats->successful_auths = 0;
-    stats->failed_auths = 0;
-    stats->reader_connections = 0;
-    stats->data_reads = 0;
-    stats->last_activity = furi_string_alloc();
-    stats->status_message = furi_string_alloc();
-    stats->is_active = true;
-    stats->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
-
-    if(!stats->last_activity || !stats->status_message || !stats->mutex) {
-        FURI_LOG_E(TAG, "Failed to allocate resources");
-        emulation_stats_free(stats);
-        return NULL;
-    }
+    atomic_init(&stats->auth_attempts, 0);
+    atomic_init(&stats->activity, EmulationActivityStarted);
+    atomic_init(&stats->is_active, true);
 
     stats->update_timer = furi_timer_alloc(emulation_timer_callback, FuriTimerTypePeriodic, app);
-    if(!stats->update_timer) {
-        FURI_LOG_E(TAG, "Failed to allocate timer");
-        emulation_stats_free(stats);
-        return NULL;
-    }
-
-    furi_timer_start(stats->update_timer, 1000);
-
-    furi_string_set_str(stats->status_message, "Template ready");
-    furi_string_set_str(stats->last_activity, "Emulation started");
+    furi_timer_start(stats->update_timer, EMULATION_REFRESH_MS);
 
     return stats;
 }
@@ -168,15 +149,6 @@ static void miband_nfc_magic_emulator_prepare_blank_template(MiBandNfcApp* app)
         return;
     }
 
-    EmulationStats* stats = (EmulationStats*)app->emulation_stats;
-    if(stats) {
-        if(furi_mutex_acquire(stats->mutex, 100) == FuriStatusOk) {
-            furi_string_set_str(stats->status_message, "Preparing template...");
-            furi_string_set_str(stats->last_activity, "Template generation");
-            furi_mutex_release(stats->mutex);
-        }
-    }
-
     uint8_t original_block0_data[16];
     memcpy(original_block0_data, app->mf_classic_data->block[0].data, 16);
 
@@ -185,7 +157,6 @@ static void miband_nfc_magic_emulator_prepare_blank_template(MiBandNfcApp* app)
 
     uint8_t bcc = uid[0] ^ uid[1] ^ uid[2] ^ uid[3];
 
-    size_t total_sectors = mf_classic_get_total_sectors_num(app->mf_classic_data->type);
     size_t total_blocks = mf_classic_get_total_block_num(app->mf_classic_data->type);
 
     for(size_t block_idx = 0; block_idx < total_blocks; block_idx++) {
@@ -194,41 +165,18 @@ static void miband_nfc_magic_emulator_prepare_blank_template(MiBandNfcApp* app)
 
     memcpy(app->mf_classic_data->block[0].data, uid, 4);
     app->mf_classic_data->block[0].data[4] = bcc;
-    app->mf_classic_data->block[0].data[5] = 0x08;
-    app->mf_classic_data->block[0].data[6] = 0x04;
+    // Manufacturer bytes: SAK and ATQA of the emulated size
+    bool is_4k = app->mf_classic_data->type == MfClassicType4k;
+    app->mf_classic_data->block[0].data[5] =
+        is_4k ? 0x18 : (app->mf_classic_data->type == MfClassicTypeMini ? 0x09 : 0x08);
+    app->mf_classic_data->block[0].data[6] = is_4k ? 0x02 : 0x04;
     app->mf_classic_data->block[0].data[7] = 0x00;
     memcpy(&app->mf_classic_data->block[0].data[8], &original_block0_data[8], 8);
 
-    for(size_t sector_idx = 0; sector_idx < total_sectors; sector_idx++) {
-        size_t sector_trailer_block_idx;
-        if(sector_idx < 32) {
-            sector_trailer_block_idx = sector_idx * 4 + 3;
-        } else {
-            sector_trailer_block_idx = 32 * 4 + (sector_idx - 32) * 16 + 15;
-        }
-
-        MfClassicBlock* sector_trailer = &app->mf_classic_data->block[sector_trailer_block_idx];
+    miband_magic_apply(app->mf_classic_data);
 
-        /* Construct a safe trailer. Note: access bits ideally should be calculated to be consistent */
-        memset(&sector_trailer->data[0], 0xFF, 6); /* Key A = FF..FF */
-        sector_trailer->data[6] = 0xFF; /* access byte 1 (example) */
-        sector_trailer->data[7] = 0x07; /* access byte 2 (example) */
-        sector_trailer->data[8] = 0x80; /* access byte 3 (example) */
-        sector_trailer->data[9] = 0x69; /* Key B first byte placeholder (if any) */
-        memset(&sector_trailer->data[10], 0xFF, 6); /* Key B = FF..FF */
-
-        FURI_BIT_SET(app->mf_classic_data->key_a_mask, sector_idx);
-        FURI_BIT_SET(app->mf_classic_data->key_b_mask, sector_idx);
-    }
-
-    if(stats) {
-        if(furi_mutex_acquire(stats->mutex, 100) == FuriStatusOk) {
-            furi_string_printf(
-                stats->status_message, "UID %02X%02X%02X%02X", uid[0], uid[1], uid[2], uid[3]);
-            furi_string_set_str(stats->last_activity, "Template ready");
-            furi_mutex_release(stats->mutex);
-        }
-    }
+    EmulationStats* stats = app->emulation_stats;
+    if(stats) memcpy(stats->uid, uid, sizeof(stats->uid));
 
     FURI_LOG_I(
         TAG,
@@ -242,90 +190,33 @@ static void miband_nfc_magic_emulator_prepare_blank_template(MiBandNfcApp* app)
 static NfcCommand miband_nfc_magic_emulator_callback(NfcGenericEvent event, void* context) {
     furi_assert(context);
     MiBandNfcApp* app = context;
+    EmulationStats* stats = app->emulation_stats;
 
-    if(!app || !app->emulation_stats) {
+    if(!stats || !atomic_load_explicit(&stats->is_active, memory_order_relaxed)) {
         return NfcCommandStop;
     }
+    if(event.protocol != NfcProtocolMfClassic) return NfcCommandContinue;
 
-    EmulationStats* stats = (EmulationStats*)app->emulation_stats;
+    const MfClassicListenerEvent* mfc_event = event.event_data;
 
-    if(!stats->mutex) {
-        return NfcCommandStop;
-    }
+    if(mfc_event->type == MfClassicListenerEventTypeAuthContextPartCollected) {
+        atomic_store_explicit(&stats->activity, EmulationActivityAuthPart, memory_order_relaxed);
 
-    if(furi_mutex_acquire(stats->mutex, 100) != FuriStatusOk) {
-        return NfcCommandContinue;
-    }
+    } else if(mfc_event->type == MfClassicListenerEventTypeAuthContextFullCollected) {
+        uint32_t auths =
+            atomic_fetch_add_explicit(&stats->auth_attempts, 1, memory_order_relaxed) + 1;
 
-    bool should_stop = false;
-
-    if(!stats->is_active) {
-        should_stop = true;
-    } else if(event.protocol == NfcProtocolMfClassic) {
-        const MfClassicListenerEvent* mfc_event = event.event_data;
-
-        if(mfc_event->type == MfClassicListenerEventTypeAuthContextPartCollected) {
-            if(stats->last_activity) {
-                furi_string_set_str(stats->last_activity, "Auth data collected");
-            }
-            FURI_LOG_D(TAG, "Blank template: Auth part collected");
-
-        } else if(mfc_event->type == MfClassicListenerEventTypeAuthContextFullCollected) {
-            stats->auth_attempts++;
-            stats->successful_auths++;
-
-            if(stats->last_activity) {
-                furi_string_printf(
-                    stats->last_activity, "Auth #%lu complete", stats->auth_attempts);
-            }
-
-            if(stats->status_message) {
-                furi_string_set_str(stats->status_message, "Authentication successful");
-            }
-
-            FURI_LOG_D(TAG, "Blank template: Auth complete #%lu", stats->auth_attempts);
-
-            if(stats->auth_attempts % 5 == 0) {
-                view_dispatcher_send_custom_event(
-                    app->view_dispatcher, MiBandNfcCustomEventCardDetected);
-            }
-
-            if(app->logger && stats->auth_attempts % 10 == 0) {
-                miband_logger_log(
-                    app->logger,
-                    LogLevelDebug,
-                    "Magic emulation: %lu authentications completed",
-                    stats->auth_attempts);
-            }
-
-            if(stats->auth_attempts > 100) {
-                if(stats->status_message) {
-                    furi_string_set_str(
-                        stats->status_message, "Too many auth attempts - stopping");
-                }
-                if(stats->last_activity) {
-                    furi_string_set_str(stats->last_activity, "Safety stop triggered");
-                }
-
-                FURI_LOG_W(TAG, "Too many auth attempts (%lu), stopping", stats->auth_attempts);
-
-                if(app->logger) {
-                    miband_logger_log(
-                        app->logger,
-                        LogLevelWarning,
-                        "Magic emulation stopped: too many auth attempts (%lu)",
-                        stats->auth_attempts);
-                }
-
-                stats->is_active = false;
-                should_stop = true;
-            }
+        if(auths > EMULATION_MAX_AUTHS) {
+            atomic_store_explicit(&stats->is_active, false, memory_order_relaxed);
+            atomic_store_explicit(
+                &stats->activity, EmulationActivitySafetyStop, memory_order_relaxed);
+            return NfcCommandStop;
         }
+        atomic_store_explicit(
+            &stats->activity, EmulationActivityAuthComplete, memory_order_relaxed);
     }
 
-    furi_mutex_release(stats->mutex);
-
-    return should_stop ? NfcCommandStop : NfcCommandContinue;
+    return NfcCommandContinue;
 }
 
 void miband_nfc_scene_magic_emulator_on_enter(void* context) {
@@ -344,14 +235,13 @@ void miband_nfc_scene_magic_emulator_on_enter(void* context) {
     }
 
     app->emulation_stats = emulation_stats_alloc(app);
-    if(!app->emulation_stats) {
-        FURI_LOG_E(TAG, "Failed to allocate emulation stats");
-        scene_manager_previous_scene(app->scene_manager);
-        return;
-    }
-
     miband_nfc_magic_emulator_prepare_blank_template(app);
 
+    popup_reset(app->popup);
+    popup_set_header(app->popup, "Magic Template Active", 64, 2, AlignCenter, AlignTop);
+    popup_set_icon(app->popup, 68, 20, &I_NFC_dolphin_emulation_51x64);
+    emulation_stats_render(app, app->emulation_stats);
+
     view_dispatcher_switch_to_view(app->view_dispatcher, MiBandNfcViewIdMagicEmulator);
 
     app->listener = nfc_listener_alloc(app->nfc, NfcProtocolMfClassic, app->mf_classic_data);
@@ -367,8 +257,6 @@ void miband_nfc_scene_magic_emulator_on_enter(void* context) {
 
     notification_message(app->notifications, &sequence_blink_start_cyan);
 
-    emulation_timer_callback(app);
-
     if(app->logger) {
         uint8_t* uid = app->mf_classic_data->block[0].data;
         miband_logger_log(
@@ -390,12 +278,8 @@ bool miband_nfc_scene_magic_emulator_on_event(void* context, SceneManagerEvent e
 
     if(event.type == SceneManagerEventTypeCustom) {
         switch(event.event) {
-        case MiBandNfcCustomEventCardDetected:
-            EmulationStats* stats = (EmulationStats*)app->emulation_stats;
-            if(stats) {
-                furi_string_set_str(stats->status_message, "Mi Band actively reading");
-                notification_message(app->notifications, &sequence_single_vibro);
-            }
+        case MiBandNfcCustomEventEmulatorTick:
+            if(app->emulation_stats) emulation_stats_render(app, app->emulation_stats);
             consumed = true;
             break;
         default:
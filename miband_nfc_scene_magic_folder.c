@@ -0,0 +1,317 @@
+/**
+ * @file miband_nfc_scene_magic_folder.c
+ * @brief Convert every dump of a folder to its _magic.nfc variant
+ * 
+ * The folder is picked by selecting any dump inside it. A worker thread
+ * lists the folder twice: once to count the dumps for the progress view,
+ * once to stream each of them through miband_magic_file_convert().
+ * 
+ * The job is resumable: a dump whose _magic.nfc is at least as recent as
+ * the dump itself is skipped, so running it again after an interruption
+ * (or after adding a few dumps) only converts what is missing.
+ */
+
+#include "miband_nfc_i.h"
+
+#define TAG "MiBandNfc"
+
+#define MAGIC_FOLDER_WORKER_STACK_SIZE 2048
+#define MAGIC_FOLDER_NAME_MAX          128
+#define MAGIC_FOLDER_RESULT_POPUP_MS   30000
+
+/**
+ * @brief Folder conversion state shared between the worker and the GUI thread
+ */
+typedef struct {
+    MiBandNfcApp* app;
+    FuriThread* thread;
+    FuriString* folder;
+
+    volatile bool abort_requested;
+    volatile bool done;
+    uint32_t files_total;
+    uint32_t files_converted;
+    uint32_t files_up_to_date;
+    uint32_t files_failed;
+
+    // Worker scratch, kept off the worker stack
+    char name[MAGIC_FOLDER_NAME_MAX];
+    FuriString* src_path;
+    FuriString* dst_path;
+} MagicFolderContext;
+
+/**
+ * @brief Check whether a directory entry is a dump to convert
+ */
+static bool magic_folder_is_source(const char* name, const FileInfo* info) {
+    if(name[0] == '.' || (info->flags & FSF_DIRECTORY)) return false;
+
+    size_t name_len = strlen(name);
+    size_t ext_len = strlen(NFC_APP_EXTENSION);
+    if(name_len <= ext_len || strcasecmp(&name[name_len - ext_len], NFC_APP_EXTENSION) != 0) {
+        return false;
+    }
+    return !miband_magic_file_is_magic(name);
+}
+
+/**
+ * @brief Check whether the magic variant is at least as recent as its source
+ */
+static bool magic_folder_is_up_to_date(Storage* storage, const char* src, const char* dst) {
+    uint32_t src_mtime = 0;
+    uint32_t dst_mtime = 0;
+    if(storage_common_timestamp(storage, dst, &dst_mtime) != FSE_OK) return false;
+    if(storage_common_timestamp(storage, src, &src_mtime) != FSE_OK) return false;
+    return dst_mtime >= src_mtime;
+}
+
+/**
+ * @brief List the folder, converting (or just counting) every dump
+ * 
+ * @param ctx Folder conversion context
+ * @param convert false for the counting pass
+ * @return Number of dumps seen
+ */
+static uint32_t magic_folder_pass(MagicFolderContext* ctx, bool convert) {
+    MiBandNfcApp* app = ctx->app;
+    File* dir = storage_file_alloc(app->storage);
+    FileInfo file_info;
+    uint32_t files = 0;
+
+    if(storage_dir_open(dir, furi_string_get_cstr(ctx->folder))) {
+        while(!ctx->abort_requested &&
+              storage_dir_read(dir, &file_info, ctx->name, sizeof(ctx->name))) {
+            if(!magic_folder_is_source(ctx->name, &file_info)) continue;
+            files++;
+            if(!convert) continue;
+
+            furi_string_printf(
+                ctx->src_path, "%s/%s", furi_string_get_cstr(ctx->folder), ctx->name);
+            miband_magic_file_output_path(furi_string_get_cstr(ctx->src_path), ctx->dst_path);
+            const char* src = furi_string_get_cstr(ctx->src_path);
+            const char* dst = furi_string_get_cstr(ctx->dst_path);
+
+            progress_tracker_set_status(app->progress, ctx->name);
+
+            if(magic_folder_is_up_to_date(app->storage, src, dst)) {
+                ctx->files_up_to_date++;
+            } else if(miband_magic_file_convert(app->storage, src, dst)) {
+                ctx->files_converted++;
+            } else {
+                ctx->files_failed++;
+                if(app->logger) {
+                    miband_logger_log(
+                        app->logger, LogLevelWarning, "Folder convert failed: %s", ctx->name);
+                }
+            }
+
+            progress_tracker_update(app->progress, MIN(files, ctx->files_total));
+        }
+    }
+
+    storage_dir_close(dir);
+    storage_file_free(dir);
+    return files;
+}
+
+static int32_t magic_folder_worker_thread(void* context) {
+    MagicFolderContext* ctx = context;
+    MiBandNfcApp* app = ctx->app;
+
+    ctx->files_total = magic_folder_pass(ctx, false);
+
+    progress_tracker_reset(app->progress, ctx->files_total, "File");
+    progress_tracker_set_header(app->progress, "Convert Folder");
+    magic_folder_pass(ctx, true);
+
+    FURI_LOG_I(
+        TAG,
+        "Folder convert: %lu converted, %lu up to date, %lu failed",
+        ctx->files_converted,
+        ctx->files_up_to_date,
+        ctx->files_failed);
+
+    ctx->done = true;
+    if(!ctx->abort_requested) {
+        view_dispatcher_send_custom_event(
+            app->view_dispatcher, MiBandNfcCustomEventFolderConvertDone);
+    }
+    return 0;
+}
+
+/**
+ * @brief Abort (if still running), join and free the conversion worker
+ * 
+ * The worker checks the abort flag between files, so the join waits for
+ * at most one conversion.
+ * 
+ * @param app Pointer to MiBandNfcApp instance
+ */
+static void magic_folder_worker_stop(MiBandNfcApp* app) {
+    MagicFolderContext* ctx = app->magic_folder_context;
+    if(!ctx) return;
+
+    if(ctx->thread) {
+        ctx->abort_requested = true;
+        furi_thread_join(ctx->thread);
+        furi_thread_free(ctx->thread);
+    }
+
+    furi_string_free(ctx->folder);
+    furi_string_free(ctx->src_path);
+    furi_string_free(ctx->dst_path);
+    free(ctx);
+    app->magic_folder_context = NULL;
+}
+
+static void magic_folder_popup_timeout_callback(void* context) {
+    MiBandNfcApp* app = context;
+    view_dispatcher_send_custom_event(app->view_dispatcher, MiBandNfcCustomEventPopupDone);
+}
+
+/**
+ * @brief Show the summary of a finished conversion
+ * 
+ * @param app Pointer to MiBandNfcApp instance
+ * @param ctx Finished conversion context
+ */
+static void magic_folder_show_result(MiBandNfcApp* app, MagicFolderContext* ctx) {
+    if(app->logger) {
+        miband_logger_log(
+            app->logger,
+            LogLevelInfo,
+            "Folder convert %s: %lu converted, %lu up to date, %lu failed",
+            furi_string_get_cstr(ctx->folder),
+            ctx->files_converted,
+            ctx->files_up_to_date,
+            ctx->files_failed);
+    }
+
+    popup_reset(app->popup);
+    if(ctx->files_total == 0) {
+        popup_set_header(app->popup, "Nothing to Convert", 64, 4, AlignCenter, AlignTop);
+        furi_string_set_str(app->temp_text_buffer, "No .nfc dumps\nin this folder");
+    } else {
+        popup_set_header(app->popup, "Folder Converted", 64, 4, AlignCenter, AlignTop);
+        furi_string_printf(
+            app->temp_text_buffer,
+            "%lu converted\n%lu up to date\n%lu failed",
+            ctx->files_converted,
+            ctx->files_up_to_date,
+            ctx->files_failed);
+    }
+    popup_set_text(
+        app->popup, furi_string_get_cstr(app->temp_text_buffer), 64, 20, AlignCenter, AlignTop);
+    popup_set_context(app->popup, app);
+    popup_set_callback(app->popup, magic_folder_popup_timeout_callback);
+    popup_set_timeout(app->popup, MAGIC_FOLDER_RESULT_POPUP_MS);
+    popup_enable_timeout(app->popup);
+    view_dispatcher_switch_to_view(app->view_dispatcher, MiBandNfcViewIdMagicEmulator);
+
+    notification_message(app->notifications, &sequence_blink_stop);
+    notification_message(
+        app->notifications, ctx->files_failed == 0 ? &sequence_success : &sequence_error);
+}
+
+/**
+ * @brief Scene entry point
+ * 
+ * Asks for a dump in the folder to convert and starts the worker.
+ * 
+ * @param context Pointer to MiBandNfcApp instance
+ */
+void miband_nfc_scene_magic_folder_on_enter(void* context) {
+    furi_assert(context);
+    MiBandNfcApp* app = context;
+
+    FuriString* selected = furi_string_alloc_set_str(NFC_APP_FOLDER);
+    DialogsFileBrowserOptions browser_options;
+    dialog_file_browser_set_basic_options(&browser_options, NFC_APP_EXTENSION, &I_Nfc_10px);
+    browser_options.base_path = NFC_APP_FOLDER;
+    browser_options.hide_dot_files = true;
+
+    // There is no folder picker: any dump of the folder selects the folder
+    if(!dialog_file_browser_show(app->dialogs, selected, selected, &browser_options)) {
+        furi_string_free(selected);
+        scene_manager_previous_scene(app->scene_manager);
+        return;
+    }
+
+    MagicFolderContext* ctx = malloc(sizeof(MagicFolderContext));
+    memset(ctx, 0, sizeof(MagicFolderContext));
+    ctx->app = app;
+    ctx->folder = selected;
+    ctx->src_path = furi_string_alloc();
+    ctx->dst_path = furi_string_alloc();
+    app->magic_folder_context = ctx;
+
+    size_t slash = furi_string_search_rchar(ctx->folder, '/');
+    if(slash != FURI_STRING_FAILURE) furi_string_left(ctx->folder, slash);
+
+    if(app->logger) {
+        miband_logger_log(
+            app->logger,
+            LogLevelInfo,
+            "Folder convert started: %s",
+            furi_string_get_cstr(ctx->folder));
+    }
+
+    progress_tracker_reset(app->progress, 0, "File");
+    progress_tracker_set_header(app->progress, "Convert Folder");
+    progress_tracker_set_status(app->progress, "Counting dumps...");
+    view_dispatcher_switch_to_view(app->view_dispatcher, MiBandNfcViewIdProgress);
+    notification_message(app->notifications, &sequence_blink_start_magenta);
+
+    ctx->thread = furi_thread_alloc_ex(
+        "MiBandMagicFolder", MAGIC_FOLDER_WORKER_STACK_SIZE, magic_folder_worker_thread, ctx);
+    furi_thread_start(ctx->thread);
+}
+
+/**
+ * @brief Scene event handler
+ * 
+ * @param context Pointer to MiBandNfcApp instance
+ * @param event Scene manager event
+ * @return true if event was consumed, false otherwise
+ */
+bool miband_nfc_scene_magic_folder_on_event(void* context, SceneManagerEvent event) {
+    MiBandNfcApp* app = context;
+    bool consumed = false;
+
+    if(event.type == SceneManagerEventTypeCustom) {
+        if(event.event == MiBandNfcCustomEventFolderConvertDone) {
+            MagicFolderContext* ctx = app->magic_folder_context;
+            if(ctx && ctx->done && ctx->thread) {
+                furi_thread_join(ctx->thread);
+                furi_thread_free(ctx->thread);
+                ctx->thread = NULL;
+                magic_folder_show_result(app, ctx);
+            }
+            consumed = true;
+        } else if(event.event == MiBandNfcCustomEventPopupDone) {
+            scene_manager_search_and_switch_to_another_scene(
+                app->scene_manager, MiBandNfcSceneMainMenu);
+            consumed = true;
+        }
+    } else if(event.type == SceneManagerEventTypeBack) {
+        // Stops after the dump being converted; the next run resumes from there
+        scene_manager_search_and_switch_to_another_scene(
+            app->scene_manager, MiBandNfcSceneMainMenu);
+        consumed = true;
+    }
+
+    return consumed;
+}
+
+/**
+ * @brief Scene exit handler
+ * 
+ * @param context Pointer to MiBandNfcApp instance
+ */
+void miband_nfc_scene_magic_folder_on_exit(void* context) {
+    MiBandNfcApp* app = context;
+
+    magic_folder_worker_stop(app);
+    notification_message(app->notifications, &sequence_blink_stop);
+    popup_reset(app->popup);
+}
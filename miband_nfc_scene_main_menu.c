@@ -25,6 +25,16 @@ void miband_nfc_scene_main_menu_on_enter(void* context) {
         miband_nfc_app_submenu_callback,
         app);
 
+    // Dumps parsed earlier in this session
+    if(miband_dump_cache_get_count(app->dump_cache) > 0) {
+        submenu_add_item(
+            app->submenu,
+            "Recent Dumps",
+            SubmenuIndexRecentDumps,
+            miband_nfc_app_submenu_callback,
+            app);
+    }
+
     // Emulation functions
     submenu_add_item(
         app->submenu,
@@ -41,6 +51,10 @@ void miband_nfc_scene_main_menu_on_enter(void* context) {
         miband_nfc_app_submenu_callback,
         app);
 
+    // Batch provisioning: one dump, many bands
+    submenu_add_item(
+        app->submenu, "Batch Write", SubmenuIndexBatchWrite, miband_nfc_app_submenu_callback, app);
+
     // Save magic dump
     submenu_add_item(
         app->submenu,
@@ -49,10 +63,26 @@ void miband_nfc_scene_main_menu_on_enter(void* context) {
         miband_nfc_app_submenu_callback,
         app);
 
+    // Convert a whole folder of dumps
+    submenu_add_item(
+        app->submenu,
+        "Convert Folder to Magic",
+        SubmenuIndexConvertFolder,
+        miband_nfc_app_submenu_callback,
+        app);
+
     // Verification
     submenu_add_item(
         app->submenu, "Verify Write", SubmenuIndexVerify, miband_nfc_app_submenu_callback, app);
 
+    // Timing of the last run
+    submenu_add_item(
+        app->submenu,
+        "Last Run Stats",
+        SubmenuIndexLastRunStats,
+        miband_nfc_app_submenu_callback,
+        app);
+
     // Settings
     submenu_add_item(
         app->submenu, "Settings >", SubmenuIndexSettings, miband_nfc_app_submenu_callback, app);
@@ -79,6 +109,11 @@ bool miband_nfc_scene_main_menu_on_event(void* context, SceneManagerEvent event)
             consumed = true;
             break;
 
+        case SubmenuIndexRecentDumps:
+            scene_manager_next_scene(app->scene_manager, MiBandNfcSceneRecentDumps);
+            consumed = true;
+            break;
+
         case SubmenuIndexEmulateNfcMagic:
             app->current_operation = OperationTypeEmulateMagic;
             scene_manager_next_scene(app->scene_manager, MiBandNfcSceneFileSelect);
@@ -92,18 +127,34 @@ bool miband_nfc_scene_main_menu_on_event(void* context, SceneManagerEvent event)
             consumed = true;
             break;
 
+        case SubmenuIndexBatchWrite:
+            app->current_operation = OperationTypeBatchWrite;
+            scene_manager_next_scene(app->scene_manager, MiBandNfcSceneFileSelect);
+            consumed = true;
+            break;
+
         case SubmenuIndexSaveMagic:
             app->current_operation = OperationTypeSaveMagic;
             scene_manager_next_scene(app->scene_manager, MiBandNfcSceneFileSelect);
             consumed = true;
             break;
 
+        case SubmenuIndexConvertFolder:
+            scene_manager_next_scene(app->scene_manager, MiBandNfcSceneMagicFolder);
+            consumed = true;
+            break;
+
         case SubmenuIndexVerify:
             app->current_operation = OperationTypeVerify;
             scene_manager_next_scene(app->scene_manager, MiBandNfcSceneFileSelect);
             consumed = true;
             break;
 
+        case SubmenuIndexLastRunStats:
+            scene_manager_next_scene(app->scene_manager, MiBandNfcSceneStats);
+            consumed = true;
+            break;
+
         case SubmenuIndexSettings:
             scene_manager_next_scene(app->scene_manager, MiBandNfcSceneSettings);
             consumed = true;
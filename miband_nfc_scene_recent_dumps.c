@@ -0,0 +1,171 @@
+/**
+ * @file miband_nfc_scene_recent_dumps.c
+ * @brief Reopen a recently parsed dump without the file browser
+ *
+ * Lists the dump cache, most recent first; picking a dump shows the
+ * operations to run on it. The dump is usually served from the cache, so
+ * the operation starts without a parse.
+ */
+
+#include "miband_nfc_i.h"
+
+#define TAG "MiBandNfc"
+
+enum {
+    RecentDumpsStateList,
+    RecentDumpsStateActions,
+};
+
+/**
+ * @brief Operation items, numbered after the dump items
+ */
+enum {
+    RecentDumpsIndexWrite = MIBAND_DUMP_CACHE_SIZE,
+    RecentDumpsIndexBatchWrite,
+    RecentDumpsIndexVerify,
+    RecentDumpsIndexEmulate,
+    RecentDumpsIndexSaveMagic,
+};
+
+static void recent_dumps_submenu_callback(void* context, uint32_t index) {
+    MiBandNfcApp* app = context;
+    view_dispatcher_send_custom_event(app->view_dispatcher, index);
+}
+
+static void recent_dumps_show_list(MiBandNfcApp* app) {
+    scene_manager_set_scene_state(
+        app->scene_manager, MiBandNfcSceneRecentDumps, RecentDumpsStateList);
+
+    submenu_reset(app->submenu);
+    submenu_set_header(app->submenu, "Recent Dumps");
+
+    size_t count = miband_dump_cache_get_count(app->dump_cache);
+    for(size_t i = 0; i < count; i++) {
+        const char* path = miband_dump_cache_get_path(app->dump_cache, i);
+        const char* name = strrchr(path, '/');
+        submenu_add_item(
+            app->submenu, name ? name + 1 : path, i, recent_dumps_submenu_callback, app);
+    }
+}
+
+static void recent_dumps_show_actions(MiBandNfcApp* app) {
+    scene_manager_set_scene_state(
+        app->scene_manager, MiBandNfcSceneRecentDumps, RecentDumpsStateActions);
+
+    submenu_reset(app->submenu);
+    const char* path = furi_string_get_cstr(app->file_path);
+    const char* name = strrchr(path, '/');
+    submenu_set_header(app->submenu, name ? name + 1 : path);
+
+    submenu_add_item(
+        app->submenu,
+        "Write Original Data",
+        RecentDumpsIndexWrite,
+        recent_dumps_submenu_callback,
+        app);
+    submenu_add_item(
+        app->submenu,
+        "Batch Write",
+        RecentDumpsIndexBatchWrite,
+        recent_dumps_submenu_callback,
+        app);
+    submenu_add_item(
+        app->submenu, "Verify Write", RecentDumpsIndexVerify, recent_dumps_submenu_callback, app);
+    submenu_add_item(
+        app->submenu,
+        "Emulate Magic Card",
+        RecentDumpsIndexEmulate,
+        recent_dumps_submenu_callback,
+        app);
+    submenu_add_item(
+        app->submenu,
+        "Save Magic Dump",
+        RecentDumpsIndexSaveMagic,
+        recent_dumps_submenu_callback,
+        app);
+}
+
+static void recent_dumps_run(MiBandNfcApp* app, OperationType operation) {
+    app->current_operation = operation;
+
+    const char* error = miband_nfc_load_dump(app, NULL);
+    if(error) {
+        // The file changed into something unreadable or is gone
+        FURI_LOG_W(TAG, "Recent dump unavailable: %s", error);
+        popup_reset(app->popup);
+        popup_set_header(app->popup, "Cannot Open", 64, 4, AlignCenter, AlignTop);
+        popup_set_text(app->popup, error, 64, 30, AlignCenter, AlignTop);
+        view_dispatcher_switch_to_view(app->view_dispatcher, MiBandNfcViewIdScanner);
+        furi_delay_ms(1000);
+
+        if(miband_dump_cache_get_count(app->dump_cache) == 0) {
+            scene_manager_previous_scene(app->scene_manager);
+            return;
+        }
+        recent_dumps_show_list(app);
+        view_dispatcher_switch_to_view(app->view_dispatcher, MiBandNfcViewIdMainMenu);
+        return;
+    }
+
+    miband_nfc_start_operation(app);
+}
+
+void miband_nfc_scene_recent_dumps_on_enter(void* context) {
+    furi_assert(context);
+    MiBandNfcApp* app = context;
+
+    if(miband_dump_cache_get_count(app->dump_cache) == 0) {
+        scene_manager_previous_scene(app->scene_manager);
+        return;
+    }
+
+    recent_dumps_show_list(app);
+    view_dispatcher_switch_to_view(app->view_dispatcher, MiBandNfcViewIdMainMenu);
+}
+
+bool miband_nfc_scene_recent_dumps_on_event(void* context, SceneManagerEvent event) {
+    MiBandNfcApp* app = context;
+    bool consumed = false;
+
+    if(event.type == SceneManagerEventTypeCustom) {
+        consumed = true;
+
+        switch(event.event) {
+        case RecentDumpsIndexWrite:
+            recent_dumps_run(app, OperationTypeWriteOriginal);
+            break;
+        case RecentDumpsIndexBatchWrite:
+            recent_dumps_run(app, OperationTypeBatchWrite);
+            break;
+        case RecentDumpsIndexVerify:
+            recent_dumps_run(app, OperationTypeVerify);
+            break;
+        case RecentDumpsIndexEmulate:
+            recent_dumps_run(app, OperationTypeEmulateMagic);
+            break;
+        case RecentDumpsIndexSaveMagic:
+            recent_dumps_run(app, OperationTypeSaveMagic);
+            break;
+        default:
+            if(event.event < miband_dump_cache_get_count(app->dump_cache)) {
+                furi_string_set_str(
+                    app->file_path, miband_dump_cache_get_path(app->dump_cache, event.event));
+                recent_dumps_show_actions(app);
+            }
+            break;
+        }
+    } else if(event.type == SceneManagerEventTypeBack) {
+        if(scene_manager_get_scene_state(app->scene_manager, MiBandNfcSceneRecentDumps) ==
+           RecentDumpsStateActions) {
+            recent_dumps_show_list(app);
+            consumed = true;
+        }
+    }
+
+    return consumed;
+}
+
+void miband_nfc_scene_recent_dumps_on_exit(void* context) {
+    MiBandNfcApp* app = context;
+    submenu_reset(app->submenu);
+}
@@ -5,18 +5,79 @@
 
 #include "miband_nfc_i.h"
 
-#define TAG            "MiBandNfc"
-#define SETTINGS_PATH  EXT_PATH("apps_data/miband_nfc/settings.bin")
-#define SETTINGS_MAGIC 0x4D424E43 // "MBNC"
+#define TAG                   "MiBandNfc"
+#define SETTINGS_PATH         EXT_PATH("apps_data/miband_nfc/settings.bin")
+#define SETTINGS_LEGACY_MAGIC 0x4D424E43 // "MBNC", flat struct of the first releases
+#define SETTINGS_MAGIC        0x4D424E53 // "MBNS", sized header + records
+#define SETTINGS_VERSION      2 // Bump only for changes older readers must reject
 
+/**
+ * @brief Settings file of the first releases, read for migration only
+ */
 typedef struct {
     uint32_t magic;
     bool auto_backup_enabled;
     bool verify_after_write;
     bool show_detailed_progress;
     bool enable_logging;
+    uint8_t rf_profile; // Appended field, absent in older settings files
+    uint8_t uid_check_first_match; // Appended, lands in the padding of older files
+    uint8_t write_checkpoint_file; // Appended, lands in the padding of older files
+    uint8_t dump_sidecar; // Appended, lands in the padding of older files
+} MiBandSettingsLegacy;
+
+#define SETTINGS_LEGACY_SIZE offsetof(MiBandSettingsLegacy, rf_profile)
+
+/**
+ * @brief File header: every record after it carries its size
+ *
+ * Followed by one MiBandSettings record of settings_size bytes, then
+ * profile_count MiBandPipelineProfile records of profile_size bytes. A
+ * reader takes the fields it knows, keeps defaults for the ones a shorter
+ * record lacks and skips the tail of a longer one.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t settings_size;
+    uint8_t profile_count;
+    uint8_t reserved;
+    uint16_t profile_size;
+} MiBandSettingsHeader;
+
+/**
+ * @brief App-wide settings record, append new fields at the end
+ */
+typedef struct {
+    uint8_t auto_backup_enabled;
+    uint8_t show_detailed_progress;
+    uint8_t enable_logging;
+    uint8_t uid_check_first_match;
+    uint8_t write_checkpoint_file;
+    uint8_t dump_sidecar;
+    uint8_t pipeline_profile;
 } MiBandSettings;
 
+typedef union {
+    MiBandSettingsHeader header;
+    MiBandSettingsLegacy legacy;
+} MiBandSettingsFileStart;
+
+void miband_settings_set_defaults(MiBandNfcApp* app) {
+    furi_assert(app);
+
+    app->auto_backup_enabled = true;
+    app->show_detailed_progress = true;
+    app->enable_logging = true;
+    app->uid_check_first_match = false;
+    app->write_checkpoint_file = false;
+    app->dump_sidecar = false;
+    app->pipeline_profile = MiBandPipelineProfileBalanced;
+    for(size_t i = 0; i < MiBandPipelineProfileCount; i++) {
+        miband_pipeline_profile_init(&app->pipeline_profiles[i], i);
+    }
+}
+
 bool miband_settings_save(MiBandNfcApp* app) {
     if(!app || !app->storage) {
         FURI_LOG_E(TAG, "Invalid app or storage");
@@ -28,12 +89,21 @@ bool miband_settings_save(MiBandNfcApp* app) {
     storage_simply_mkdir(storage, EXT_PATH("apps_data"));
     storage_simply_mkdir(storage, EXT_PATH("apps_data/miband_nfc"));
 
-    MiBandSettings settings = {
+    MiBandSettingsHeader header = {
         .magic = SETTINGS_MAGIC,
+        .version = SETTINGS_VERSION,
+        .settings_size = sizeof(MiBandSettings),
+        .profile_count = MiBandPipelineProfileCount,
+        .profile_size = sizeof(MiBandPipelineProfile),
+    };
+    MiBandSettings settings = {
         .auto_backup_enabled = app->auto_backup_enabled,
-        .verify_after_write = app->verify_after_write,
         .show_detailed_progress = app->show_detailed_progress,
         .enable_logging = app->enable_logging,
+        .uid_check_first_match = app->uid_check_first_match,
+        .write_checkpoint_file = app->write_checkpoint_file,
+        .dump_sidecar = app->dump_sidecar,
+        .pipeline_profile = app->pipeline_profile,
     };
 
     File* file = storage_file_alloc(storage);
@@ -45,8 +115,10 @@ bool miband_settings_save(MiBandNfcApp* app) {
     bool success = false;
 
     if(storage_file_open(file, SETTINGS_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
-        success = storage_file_write(file, &settings, sizeof(MiBandSettings)) ==
-                  sizeof(MiBandSettings);
+        size_t profiles_size = sizeof(app->pipeline_profiles);
+        success = storage_file_write(file, &header, sizeof(header)) == sizeof(header) &&
+                  storage_file_write(file, &settings, sizeof(settings)) == sizeof(settings) &&
+                  storage_file_write(file, app->pipeline_profiles, profiles_size) == profiles_size;
         storage_file_close(file);
         FURI_LOG_I(TAG, "Settings saved: %s", success ? "OK" : "FAIL");
     } else {
@@ -57,13 +129,46 @@ bool miband_settings_save(MiBandNfcApp* app) {
     return success;
 }
 
+/**
+ * @brief Read a sized record into a default-filled struct
+ *
+ * @return false if the file ends inside the record
+ */
+static bool settings_read_record(File* file, void* record, size_t size, size_t file_size) {
+    size_t to_read = MIN(size, file_size);
+    if(storage_file_read(file, record, to_read) != to_read) return false;
+    if(file_size > size) return storage_file_seek(file, file_size - size, false);
+    return true;
+}
+
+/**
+ * @brief Map the first settings file onto a Balanced profile carrying its choices
+ */
+static void settings_migrate_legacy(MiBandNfcApp* app, const MiBandSettingsLegacy* legacy) {
+    MiBandPipelineProfile* balanced = &app->pipeline_profiles[MiBandPipelineProfileBalanced];
+
+    app->auto_backup_enabled = legacy->auto_backup_enabled;
+    app->show_detailed_progress = legacy->show_detailed_progress;
+    app->enable_logging = legacy->enable_logging;
+    app->uid_check_first_match = legacy->uid_check_first_match == 1;
+    app->write_checkpoint_file = legacy->write_checkpoint_file == 1;
+    app->dump_sidecar = legacy->dump_sidecar == 1;
+    app->pipeline_profile = MiBandPipelineProfileBalanced;
+
+    balanced->fused_verify = legacy->verify_after_write;
+    if(legacy->rf_profile == MiBandRfProfileRobust) {
+        balanced->retry = *miband_retry_get_policy(MiBandRfProfileRobust);
+    }
+    FURI_LOG_I(TAG, "Settings migrated from the first format");
+}
+
 bool miband_settings_load(MiBandNfcApp* app) {
     if(!app || !app->storage) {
         FURI_LOG_E(TAG, "Invalid app or storage");
         return false;
     }
     Storage* storage = app->storage;
-    MiBandSettings settings;
+    MiBandSettingsFileStart start = {0};
     bool success = false;
 
     File* file = storage_file_alloc(storage);
@@ -71,24 +176,74 @@ bool miband_settings_load(MiBandNfcApp* app) {
         FURI_LOG_E(TAG, "Failed to alloc file");
         return false;
     }
-    if(storage_file_open(file, SETTINGS_PATH, FSAM_READ, FSOM_OPEN_EXISTING)) {
-        if(storage_file_read(file, &settings, sizeof(MiBandSettings)) == sizeof(MiBandSettings)) {
-            if(settings.magic == SETTINGS_MAGIC) {
-                app->auto_backup_enabled = settings.auto_backup_enabled;
-                app->verify_after_write = settings.verify_after_write;
-                app->show_detailed_progress = settings.show_detailed_progress;
-                app->enable_logging = settings.enable_logging;
-                success = true;
-                FURI_LOG_I(TAG, "Settings loaded successfully");
-            } else {
-                FURI_LOG_W(TAG, "Invalid settings magic");
-            }
-        }
-        storage_file_close(file);
-    } else {
+    if(!storage_file_open(file, SETTINGS_PATH, FSAM_READ, FSOM_OPEN_EXISTING)) {
         FURI_LOG_I(TAG, "No settings file found, using defaults");
+        storage_file_free(file);
+        return false;
     }
 
+    do {
+        size_t read = storage_file_read(file, &start, sizeof(start));
+
+        if(read >= SETTINGS_LEGACY_SIZE && start.legacy.magic == SETTINGS_LEGACY_MAGIC) {
+            settings_migrate_legacy(app, &start.legacy);
+            success = true;
+            break;
+        }
+        if(read != sizeof(start.header) || start.header.magic != SETTINGS_MAGIC) {
+            FURI_LOG_W(TAG, "Invalid settings magic");
+            break;
+        }
+        if(start.header.version > SETTINGS_VERSION) {
+            FURI_LOG_W(TAG, "Settings version %u not supported", start.header.version);
+            break;
+        }
+
+        // Records load over the defaults, the app only takes a complete file
+        MiBandSettings settings = {
+            .auto_backup_enabled = app->auto_backup_enabled,
+            .show_detailed_progress = app->show_detailed_progress,
+            .enable_logging = app->enable_logging,
+            .uid_check_first_match = app->uid_check_first_match,
+            .write_checkpoint_file = app->write_checkpoint_file,
+            .dump_sidecar = app->dump_sidecar,
+            .pipeline_profile = app->pipeline_profile,
+        };
+        if(!settings_read_record(file, &settings, sizeof(settings), start.header.settings_size)) {
+            break;
+        }
+
+        MiBandPipelineProfile profiles[MiBandPipelineProfileCount];
+        memcpy(profiles, app->pipeline_profiles, sizeof(profiles));
+        size_t count = MIN(start.header.profile_count, (size_t)MiBandPipelineProfileCount);
+        size_t profile_size = start.header.profile_size;
+        size_t loaded = 0;
+        for(; loaded < count; loaded++) {
+            if(!settings_read_record(file, &profiles[loaded], sizeof(profiles[0]), profile_size)) {
+                break;
+            }
+            miband_pipeline_profile_sanitize(&profiles[loaded]);
+        }
+        if(loaded != count) {
+            FURI_LOG_W(TAG, "Settings truncated at profile %zu", loaded);
+            break;
+        }
+
+        app->auto_backup_enabled = settings.auto_backup_enabled == 1;
+        app->show_detailed_progress = settings.show_detailed_progress == 1;
+        app->enable_logging = settings.enable_logging == 1;
+        app->uid_check_first_match = settings.uid_check_first_match == 1;
+        app->write_checkpoint_file = settings.write_checkpoint_file == 1;
+        app->dump_sidecar = settings.dump_sidecar == 1;
+        app->pipeline_profile = settings.pipeline_profile < MiBandPipelineProfileCount ?
+                                    settings.pipeline_profile :
+                                    MiBandPipelineProfileBalanced;
+        memcpy(app->pipeline_profiles, profiles, sizeof(profiles));
+        success = true;
+        FURI_LOG_I(TAG, "Settings loaded successfully");
+    } while(false);
+
+    storage_file_close(file);
     storage_file_free(file);
     return success;
 }
@@ -116,9 +271,21 @@ void miband_nfc_scene_settings_on_enter(void* context) {
         app);
     furi_string_free(backup_text);
 
+    // Pipeline profile, the two toggles below edit the active one
+    MiBandPipelineProfile* profile = miband_nfc_get_profile(app);
+    FuriString* profile_text = furi_string_alloc_printf(
+        "Profile: %s", miband_pipeline_get_profile_name(app->pipeline_profile));
+    submenu_add_item(
+        app->submenu,
+        furi_string_get_cstr(profile_text),
+        SettingsIndexPipelineProfile,
+        settings_submenu_callback,
+        app);
+    furi_string_free(profile_text);
+
     // Verify after write toggle
     FuriString* verify_text =
-        furi_string_alloc_printf("Verify After Write: %s", app->verify_after_write ? "ON" : "OFF");
+        furi_string_alloc_printf("Verify After Write: %s", profile->fused_verify ? "ON" : "OFF");
     submenu_add_item(
         app->submenu,
         furi_string_get_cstr(verify_text),
@@ -127,6 +294,17 @@ void miband_nfc_scene_settings_on_enter(void* context) {
         app);
     furi_string_free(verify_text);
 
+    // Delta write toggle
+    FuriString* delta_text =
+        furi_string_alloc_printf("Delta Write: %s", profile->delta_write ? "ON" : "OFF");
+    submenu_add_item(
+        app->submenu,
+        furi_string_get_cstr(delta_text),
+        SettingsIndexDeltaWrite,
+        settings_submenu_callback,
+        app);
+    furi_string_free(delta_text);
+
     // Show detailed progress toggle
     FuriString* progress_text = furi_string_alloc_printf(
         "Detailed Progress: %s", app->show_detailed_progress ? "ON" : "OFF");
@@ -149,6 +327,39 @@ void miband_nfc_scene_settings_on_enter(void* context) {
         app);
     furi_string_free(logging_text);
 
+    // Quick UID Check mode
+    FuriString* uid_mode_text = furi_string_alloc_printf(
+        "UID Check: %s", app->uid_check_first_match ? "First Match" : "All Matches");
+    submenu_add_item(
+        app->submenu,
+        furi_string_get_cstr(uid_mode_text),
+        SettingsIndexUidFirstMatch,
+        settings_submenu_callback,
+        app);
+    furi_string_free(uid_mode_text);
+
+    // Write checkpoint persistence
+    FuriString* resume_text = furi_string_alloc_printf(
+        "Resume File: %s", app->write_checkpoint_file ? "ON" : "OFF");
+    submenu_add_item(
+        app->submenu,
+        furi_string_get_cstr(resume_text),
+        SettingsIndexResumeFile,
+        settings_submenu_callback,
+        app);
+    furi_string_free(resume_text);
+
+    // Binary copies of parsed dumps
+    FuriString* sidecar_text =
+        furi_string_alloc_printf("Binary Cache: %s", app->dump_sidecar ? "ON" : "OFF");
+    submenu_add_item(
+        app->submenu,
+        furi_string_get_cstr(sidecar_text),
+        SettingsIndexDumpSidecar,
+        settings_submenu_callback,
+        app);
+    furi_string_free(sidecar_text);
+
     // Export logs
     size_t log_count = miband_logger_get_count(app->logger);
     FuriString* export_text = furi_string_alloc_printf("Export Logs (%zu entries)", log_count);
@@ -164,6 +375,12 @@ void miband_nfc_scene_settings_on_enter(void* context) {
     submenu_add_item(
         app->submenu, "Clear Logs", SettingsIndexClearLogs, settings_submenu_callback, app);
 
+    // Timing suite for comparing releases, kept out of sight of regular users
+    if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug)) {
+        submenu_add_item(
+            app->submenu, "Benchmark", SettingsIndexBenchmark, settings_submenu_callback, app);
+    }
+
     // Back button
     submenu_add_item(
         app->submenu, "< Back to Menu", SettingsIndexBack, settings_submenu_callback, app);
@@ -194,21 +411,58 @@ bool miband_nfc_scene_settings_on_event(void* context, SceneManagerEvent event)
             consumed = true;
             break;
 
-        case SettingsIndexVerifyAfterWrite:
-            app->verify_after_write = !app->verify_after_write;
+        case SettingsIndexPipelineProfile:
+            app->pipeline_profile = (app->pipeline_profile + 1) % MiBandPipelineProfileCount;
+            progress_tracker_set_redraw_ms(app->progress, miband_nfc_get_profile(app)->redraw_ms);
             miband_settings_save(app);
             if(app->logger) {
                 miband_logger_log(
                     app->logger,
                     LogLevelInfo,
-                    "Verify after write %s",
-                    app->verify_after_write ? "enabled" : "disabled");
+                    "Pipeline profile set to %s",
+                    miband_pipeline_get_profile_name(app->pipeline_profile));
+            }
+            miband_nfc_scene_settings_on_exit(app);
+            miband_nfc_scene_settings_on_enter(app);
+            consumed = true;
+            break;
+
+        case SettingsIndexVerifyAfterWrite: {
+            MiBandPipelineProfile* profile = miband_nfc_get_profile(app);
+            profile->fused_verify = !profile->fused_verify;
+            miband_settings_save(app);
+            if(app->logger) {
+                miband_logger_log(
+                    app->logger,
+                    LogLevelInfo,
+                    "Verify after write %s (%s)",
+                    profile->fused_verify ? "enabled" : "disabled",
+                    miband_pipeline_get_profile_name(app->pipeline_profile));
             }
             // Refresh scene
             miband_nfc_scene_settings_on_exit(app);
             miband_nfc_scene_settings_on_enter(app);
             consumed = true;
             break;
+        }
+
+        case SettingsIndexDeltaWrite: {
+            MiBandPipelineProfile* profile = miband_nfc_get_profile(app);
+            profile->delta_write = !profile->delta_write;
+            miband_settings_save(app);
+            if(app->logger) {
+                miband_logger_log(
+                    app->logger,
+                    LogLevelInfo,
+                    "Delta write %s (%s)",
+                    profile->delta_write ? "enabled" : "disabled",
+                    miband_pipeline_get_profile_name(app->pipeline_profile));
+            }
+            miband_nfc_scene_settings_on_exit(app);
+            miband_nfc_scene_settings_on_enter(app);
+            consumed = true;
+            break;
+        }
 
         case SettingsIndexShowProgress:
             app->show_detailed_progress = !app->show_detailed_progress;
@@ -236,6 +490,35 @@ bool miband_nfc_scene_settings_on_event(void* context, SceneManagerEvent event)
             consumed = true;
             break;
 
+        case SettingsIndexUidFirstMatch:
+            app->uid_check_first_match = !app->uid_check_first_match;
+            miband_settings_save(app);
+            miband_nfc_scene_settings_on_exit(app);
+            miband_nfc_scene_settings_on_enter(app);
+            consumed = true;
+            break;
+
+        case SettingsIndexDumpSidecar:
+            app->dump_sidecar = !app->dump_sidecar;
+            miband_settings_save(app);
+            miband_nfc_scene_settings_on_exit(app);
+            miband_nfc_scene_settings_on_enter(app);
+            consumed = true;
+            break;
+
+        case SettingsIndexResumeFile:
+            app->write_checkpoint_file = !app->write_checkpoint_file;
+            miband_settings_save(app);
+            if(app->write_checkpoint_file) {
+                miband_write_checkpoint_save(&app->write_checkpoint, app->storage);
+            } else {
+                storage_common_remove(app->storage, MIBAND_WRITE_CHECKPOINT_PATH);
+            }
+            miband_nfc_scene_settings_on_exit(app);
+            miband_nfc_scene_settings_on_enter(app);
+            consumed = true;
+            break;
+
         case SettingsIndexExportLogs: {
             DateTime dt;
             furi_hal_rtc_get_datetime(&dt);
@@ -282,6 +565,11 @@ bool miband_nfc_scene_settings_on_event(void* context, SceneManagerEvent event)
             consumed = true;
             break;
 
+        case SettingsIndexBenchmark:
+            scene_manager_next_scene(app->scene_manager, MiBandNfcSceneBenchmark);
+            consumed = true;
+            break;
+
         case SettingsIndexBack:
             scene_manager_previous_scene(app->scene_manager);
             consumed = true;
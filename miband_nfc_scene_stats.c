@@ -0,0 +1,57 @@
+/**
+ * @file miband_nfc_scene_stats.c
+ * @brief Timing statistics of the last backup/write/verify run
+ * 
+ * Shows the per-phase counters, latencies and histograms collected by
+ * miband_op_stats in a scrollable TextBox. The same numbers are written to
+ * the log when the run ends.
+ */
+
+#include "miband_nfc_i.h"
+
+/**
+ * @brief Scene entry point
+ * 
+ * @param context Pointer to MiBandNfcApp instance
+ */
+void miband_nfc_scene_stats_on_enter(void* context) {
+    furi_assert(context);
+    MiBandNfcApp* app = context;
+
+    // TextBox keeps the pointer, temp_text_buffer outlives the scene
+    miband_op_stats_format(&app->op_stats, app->temp_text_buffer);
+    text_box_set_text(app->text_box, furi_string_get_cstr(app->temp_text_buffer));
+    text_box_set_font(app->text_box, TextBoxFontText);
+    text_box_set_focus(app->text_box, TextBoxFocusStart);
+
+    view_dispatcher_switch_to_view(app->view_dispatcher, MiBandNfcViewIdAbout);
+}
+
+/**
+ * @brief Scene event handler
+ * 
+ * @param context Pointer to MiBandNfcApp instance
+ * @param event Scene manager event
+ * @return true if event was consumed, false otherwise
+ */
+bool miband_nfc_scene_stats_on_event(void* context, SceneManagerEvent event) {
+    MiBandNfcApp* app = context;
+    bool consumed = false;
+
+    if(event.type == SceneManagerEventTypeBack) {
+        scene_manager_previous_scene(app->scene_manager);
+        consumed = true;
+    }
+
+    return consumed;
+}
+
+/**
+ * @brief Scene exit handler
+ * 
+ * @param context Pointer to MiBandNfcApp instance
+ */
+void miband_nfc_scene_stats_on_exit(void* context) {
+    MiBandNfcApp* app = context;
+    text_box_reset(app->text_box);
+}
@@ -1,33 +1,41 @@
 /**
  * @file miband_nfc_scene_uid_check.c
- * @brief UID checker with dynamic allocation and worker thread
+ * @brief UID checker with indexed lookup and worker thread
+ *
+ * The worker answers from the cached UID index first, then refreshes the
+ * index. Every match is pushed to the scene through a message queue as
+ * soon as it is found, so the report fills in while the scan runs.
+ *
+ * At most one update event is pending in the view dispatcher at a time: its
+ * queue is small and a blocked worker could never be joined on exit.
  */
 
 #include "miband_nfc_i.h"
+#include <stdatomic.h>
 
-#define TAG              "MiBandNfc"
-#define INITIAL_CAPACITY 5
-#define GROW_FACTOR      2
-#define MAX_SCAN_TIME_MS 15000 // 15 secondi max
+#define TAG                "MiBandNfc"
+#define RESULTS_MAX        64
+#define RESULTS_ARENA_SIZE 4096
 
 // ==================== PRIVATE STRUCTURES ====================
 
+// Matching paths, interned in a fixed arena
 typedef struct {
-    char filename[64];
-    char path[128];
-} FoundFile;
-
-typedef struct {
-    FoundFile* files;
+    MiBandPathArena* arena;
+    const char* paths[RESULTS_MAX];
     size_t count;
-    size_t capacity;
-} DynamicFileArray;
+} ResultList;
 
 // Struttura PRIVATA - definita solo qui
 typedef struct UidCheckContext {
     Storage* storage;
-    uint8_t target_uid[4];
-    DynamicFileArray* results;
+    ViewDispatcher* view_dispatcher;
+    uint8_t target_uid[MIBAND_UID_INDEX_UID_MAX];
+    size_t target_uid_len;
+    bool first_match; // Stop at the first matching dump
+    size_t index_entries; // UID index entries kept in RAM, from the pipeline profile
+    ResultList* results; // Written by the worker only
+    FuriMessageQueue* matches; // Worker -> scene, one interned path per match
     MfClassicBlock block0;
 
     // Status
@@ -35,6 +43,16 @@ typedef struct UidCheckContext {
     volatile bool scan_aborted;
     volatile uint32_t files_checked;
     volatile uint32_t files_total;
+    volatile uint32_t files_parsed;
+    atomic_bool update_pending; // Set by the worker, cleared by the event handler
+
+    // Report, owned by the scene. Double buffered: the text box keeps
+    // pointing at the previous text until it is handed the new one.
+    FuriString* matches_text;
+    size_t matches_shown;
+    bool final_shown; // Report text already carries the end of the scan
+    FuriString* report[2];
+    uint8_t report_idx;
 
     // Thread control
     FuriThread* thread;
@@ -45,208 +63,135 @@ typedef struct UidCheckContext {
 
 // ==================== PRIVATE FUNCTIONS ====================
 
-static DynamicFileArray* dynamic_array_alloc(void) {
-    DynamicFileArray* arr = malloc(sizeof(DynamicFileArray));
-    if(!arr) return NULL;
+static ResultList* result_list_alloc(void) {
+    ResultList* list = malloc(sizeof(ResultList));
+    if(!list) return NULL;
 
-    arr->files = malloc(sizeof(FoundFile) * INITIAL_CAPACITY);
-    if(!arr->files) {
-        free(arr);
-        return NULL;
+    list->arena = miband_path_arena_alloc(RESULTS_ARENA_SIZE);
+    list->count = 0;
+    return list;
+}
+
+static void result_list_free(ResultList* list) {
+    if(list) {
+        miband_path_arena_free(list->arena);
+        free(list);
     }
+}
+
+/**
+ * @brief Add a path, returns the stored copy or NULL if full or already listed
+ */
+static const char* result_list_add(ResultList* list, const char* path) {
+    if(list->count >= RESULTS_MAX) return NULL;
 
-    arr->count = 0;
-    arr->capacity = INITIAL_CAPACITY;
+    size_t stored_count = miband_path_arena_get_count(list->arena);
+    const char* stored = miband_path_arena_intern(list->arena, path);
+    if(!stored || miband_path_arena_get_count(list->arena) == stored_count) return NULL;
 
-    FURI_LOG_I(TAG, "Array allocated: capacity=%zu", arr->capacity);
-    return arr;
+    list->paths[list->count++] = stored;
+    return stored;
 }
 
-static void dynamic_array_free(DynamicFileArray* arr) {
-    if(arr) {
-        if(arr->files) free(arr->files);
-        free(arr);
+static void uid_check_context_free(UidCheckContext* ctx) {
+    result_list_free(ctx->results);
+    if(ctx->matches) furi_message_queue_free(ctx->matches);
+    if(ctx->matches_text) furi_string_free(ctx->matches_text);
+    for(size_t i = 0; i < COUNT_OF(ctx->report); i++) {
+        if(ctx->report[i]) furi_string_free(ctx->report[i]);
     }
+    free(ctx);
 }
 
-static bool dynamic_array_grow(DynamicFileArray* arr) {
-    size_t new_capacity = arr->capacity * GROW_FACTOR;
+// ==================== WORKER THREAD ====================
 
-    // Limite di sicurezza: max 500 file
-    if(new_capacity > 500) {
-        FURI_LOG_W(TAG, "Array max capacity reached");
-        return false;
-    }
+static void uid_check_notify(UidCheckContext* ctx) {
+    // The pending update will pick up this change too
+    if(atomic_exchange(&ctx->update_pending, true)) return;
+    view_dispatcher_send_custom_event(ctx->view_dispatcher, MiBandNfcCustomEventUidCheckUpdate);
+}
 
-    FoundFile* new_files = realloc(arr->files, sizeof(FoundFile) * new_capacity);
-    if(!new_files) {
-        FURI_LOG_E(TAG, "Array grow failed");
-        return false;
-    }
+static bool uid_check_stop_requested(UidCheckContext* ctx) {
+    return ctx->scan_aborted || (ctx->first_match && ctx->results->count > 0);
+}
 
-    arr->files = new_files;
-    arr->capacity = new_capacity;
+static bool
+    uid_check_progress_callback(uint32_t files_seen, uint32_t files_parsed, void* context) {
+    UidCheckContext* ctx = context;
+    ctx->files_checked = files_seen;
+    ctx->files_parsed = files_parsed;
 
-    FURI_LOG_I(TAG, "Array grown: capacity=%zu", arr->capacity);
-    return true;
+    // No redraw per tick: it would scroll the match list back to the top
+    return !uid_check_stop_requested(ctx);
 }
 
-static bool dynamic_array_add(DynamicFileArray* arr, const char* filename, const char* path) {
-    if(arr->count >= arr->capacity) {
-        if(!dynamic_array_grow(arr)) {
-            return false;
-        }
-    }
+static void uid_check_match_callback(const char* path, void* context) {
+    UidCheckContext* ctx = context;
+    if(uid_check_stop_requested(ctx)) return;
 
-    // Limita esplicitamente la lunghezza
-    strncpy(
-        arr->files[arr->count].filename, filename, sizeof(arr->files[arr->count].filename) - 1);
-    arr->files[arr->count].filename[sizeof(arr->files[arr->count].filename) - 1] = '\0';
+    const char* stored = result_list_add(ctx->results, path);
+    if(!stored) return;
 
-    strncpy(arr->files[arr->count].path, path, sizeof(arr->files[arr->count].path) - 1);
-    arr->files[arr->count].path[sizeof(arr->files[arr->count].path) - 1] = '\0';
+    FURI_LOG_I(TAG, "*** MATCH: %s ***", stored);
 
-    arr->count++;
-    return true;
+    // Sized for RESULTS_MAX entries, never blocks
+    if(furi_message_queue_put(ctx->matches, &stored, 0) != FuriStatusOk) {
+        FURI_LOG_W(TAG, "Match queue full");
+    }
+    uid_check_notify(ctx);
 }
 
-// ==================== WORKER THREAD ====================
-
 static int32_t uid_check_worker_thread(void* context) {
     UidCheckContext* ctx = (UidCheckContext*)context;
 
     FURI_LOG_I(TAG, "Worker started");
 
-    // Usa variabili locali solo quando necessario
-    File* dir = storage_file_alloc(ctx->storage);
-    if(!dir) {
-        FURI_LOG_E(TAG, "Worker: Failed to alloc dir");
-        ctx->scan_complete = true;
-        return -1;
-    }
-
-    if(!storage_dir_open(dir, NFC_APP_FOLDER)) {
-        FURI_LOG_E(TAG, "Worker: Failed to open dir");
-        storage_file_free(dir);
-        ctx->scan_complete = true;
-        return -1;
-    }
-
-    FileInfo file_info;
-    char name[128]; // Ridotto
-    uint32_t start_time = furi_get_tick();
-
-    // Prima passata: conta i file totali
-    ctx->files_total = 0;
-    while(storage_dir_read(dir, &file_info, name, sizeof(name))) {
-        if(ctx->scan_aborted) break;
-        if(name[0] == '.') continue;
-        if(file_info.flags & FSF_DIRECTORY) continue;
-
-        size_t name_len = strlen(name);
-        if(name_len < 4) continue;
-        if(strcasecmp(&name[name_len - 4], ".nfc") != 0) continue;
-        ctx->files_total++;
-
-        // Yield ogni 10 file
-        if(ctx->files_total % 10 == 0) {
-            furi_delay_ms(10);
+    MiBandUidIndex* index = miband_uid_index_alloc(ctx->storage);
+    miband_uid_index_set_max_entries(index, ctx->index_entries);
+    // Every band gets a fresh auto-backup, it would always be the first match
+    miband_uid_index_set_skip_folder(index, BACKUP_FOLDER);
+    miband_uid_index_load(index);
+
+    // Instant answer: dumps already indexed and unchanged since
+    miband_uid_index_find(
+        index, ctx->target_uid, ctx->target_uid_len, true, uid_check_match_callback, ctx);
+
+    // Then refresh the index, new and modified dumps are reported as parsed
+    if(!uid_check_stop_requested(ctx)) {
+        miband_uid_index_watch(
+            index, ctx->target_uid, ctx->target_uid_len, uid_check_match_callback, ctx);
+        if(!miband_uid_index_update(index, NFC_APP_FOLDER, uid_check_progress_callback, ctx)) {
+            FURI_LOG_W(TAG, "Worker: index update incomplete");
         }
+        miband_uid_index_watch(index, NULL, 0, NULL, NULL);
     }
 
-    FURI_LOG_I(TAG, "Found %lu .nfc files", ctx->files_total);
-
-    // Torna all'inizio
-    storage_dir_close(dir);
-    if(!storage_dir_open(dir, NFC_APP_FOLDER)) {
-        FURI_LOG_E(TAG, "Worker: Failed to reopen dir");
-        storage_file_free(dir);
-        ctx->scan_complete = true;
-        return -1;
-    }
-
-    // Seconda passata: scansiona
-    ctx->files_checked = 0;
-    FuriString* full_path = furi_string_alloc_set_str(NFC_APP_FOLDER);
-    size_t base_path_len = furi_string_size(full_path);
-
-    while(storage_dir_read(dir, &file_info, name, sizeof(name))) {
-        // Check abort
-        if(ctx->scan_aborted) {
-            FURI_LOG_W(TAG, "Worker aborted by user");
-            break;
-        }
-
-        // Check timeout
-        if(furi_get_tick() - start_time > MAX_SCAN_TIME_MS) {
-            FURI_LOG_W(TAG, "Worker timeout");
-            break;
-        }
-
-        if(name[0] == '.') continue;
-        if(file_info.flags & FSF_DIRECTORY) continue;
-
-        size_t name_len = strlen(name);
-        if(name_len < 4) continue;
-        if(strcasecmp(&name[name_len - 4], ".nfc") != 0) continue;
-
-        ctx->files_checked++;
-
-        // Ricicla il FuriString invece di crearne uno nuovo
-        furi_string_set_strn(full_path, furi_string_get_cstr(full_path), base_path_len);
-        furi_string_cat_str(full_path, "/");
-        furi_string_cat_str(full_path, name);
-
-        // Yield ogni 2 file invece di 3
-        if(ctx->files_checked % 2 == 0) {
-            furi_delay_ms(30);
-        }
-
-        NfcDevice* temp_device = nfc_device_alloc();
-        if(!temp_device) {
-            FURI_LOG_E(TAG, "Worker: Failed to alloc device");
-            continue;
-        }
-
-        bool loaded = nfc_device_load(temp_device, furi_string_get_cstr(full_path));
-
-        if(loaded && nfc_device_get_protocol(temp_device) == NfcProtocolMfClassic) {
-            const MfClassicData* data = nfc_device_get_data(temp_device, NfcProtocolMfClassic);
-
-            if(data && memcmp(data->block[0].data, ctx->target_uid, 4) == 0) {
-                FURI_LOG_I(TAG, "*** MATCH: %s ***", name);
-
-                if(!dynamic_array_add(ctx->results, name, furi_string_get_cstr(full_path))) {
-                    FURI_LOG_W(TAG, "Cannot add more files");
-                }
-            }
-        }
-
-        nfc_device_free(temp_device);
-        furi_delay_ms(10); // Ridotto da 5 a 10ms
-    }
+    // Dumps past the RAM limit are scanned without being indexed
+    ctx->files_total = MAX((uint32_t)miband_uid_index_get_count(index), ctx->files_checked);
+    miband_uid_index_free(index);
 
     FURI_LOG_I(
         TAG,
-        "Worker done: %lu/%lu files, %zu matches",
+        "Worker done: %lu files, %lu parsed, %zu matches",
         ctx->files_checked,
-        ctx->files_total,
+        ctx->files_parsed,
         ctx->results->count);
 
-    furi_string_free(full_path);
-    storage_dir_close(dir);
-    storage_file_free(dir);
-
     ctx->scan_complete = true;
+    uid_check_notify(ctx);
     return 0;
 }
 
 // ==================== REPORT GENERATION ====================
 
-static FuriString* generate_report(UidCheckContext* ctx) {
-    FuriString* report = furi_string_alloc();
-    if(!report) return NULL;
+static const char* uid_check_status(UidCheckContext* ctx) {
+    if(!ctx->scan_complete) return "Scanning...";
+    if(ctx->first_match && ctx->matches_shown > 0) return "Stopped at first match";
+    if(ctx->scan_aborted) return "Aborted";
+    return "Done";
+}
 
+static void generate_report(UidCheckContext* ctx, FuriString* report) {
     furi_string_printf(
         report,
         "Card UID Check\n"
@@ -257,7 +202,9 @@ static FuriString* generate_report(UidCheckContext* ctx) {
         "ATQA: %02X %02X\n\n"
         "Scan Results:\n"
         "-------------\n"
+        "%s\n"
         "Files checked: %lu\n"
+        "Re-indexed: %lu\n"
         "Matches: %zu\n\n",
         ctx->block0.data[0],
         ctx->block0.data[1],
@@ -267,21 +214,47 @@ static FuriString* generate_report(UidCheckContext* ctx) {
         ctx->block0.data[5],
         ctx->block0.data[6],
         ctx->block0.data[7],
+        uid_check_status(ctx),
         ctx->files_checked,
-        ctx->results->count);
+        ctx->files_parsed,
+        ctx->matches_shown);
 
-    if(ctx->results->count == 0) {
-        furi_string_cat_str(report, "No matching files\n\n");
-    } else {
+    if(ctx->matches_shown > 0) {
         furi_string_cat_str(report, "Matching files:\n");
-        furi_string_cat_printf(report, "%zu file(s):\n\n", ctx->results->count);
-        for(size_t i = 0; i < ctx->results->count; i++) {
-            furi_string_cat_printf(report, "%zu. %s\n", i + 1, ctx->results->files[i].path);
+        furi_string_cat(report, ctx->matches_text);
+    } else if(ctx->scan_complete) {
+        furi_string_cat_str(report, "No matching files\n");
+    }
+
+    if(ctx->scan_complete) furi_string_cat_str(report, "\nPress Back");
+}
+
+/**
+ * @brief Pull the matches queued by the worker and redraw the report
+ *
+ * A new text resets the text box scroll, so the report is only redrawn when
+ * a match came in or the scan ended, unless forced.
+ */
+static void uid_check_update_report(MiBandNfcApp* app, UidCheckContext* ctx, bool force) {
+    size_t matches_before = ctx->matches_shown;
+    const char* path;
+    while(furi_message_queue_get(ctx->matches, &path, 0) == FuriStatusOk) {
+        ctx->matches_shown++;
+        furi_string_cat_printf(ctx->matches_text, "%zu. %s\n", ctx->matches_shown, path);
+        if(ctx->matches_shown == 1) {
+            notification_message(app->notifications, &sequence_single_vibro);
         }
     }
 
-    furi_string_cat_str(report, "\nPress Back");
-    return report;
+    bool finished = ctx->scan_complete && !ctx->final_shown;
+    if(!force && !finished && ctx->matches_shown == matches_before) return;
+    ctx->final_shown = ctx->scan_complete;
+
+    ctx->report_idx ^= 1;
+    FuriString* report = ctx->report[ctx->report_idx];
+    generate_report(ctx, report);
+
+    text_box_set_text(app->text_box_report, furi_string_get_cstr(report));
 }
 
 // ==================== SCENE HANDLERS ====================
@@ -312,7 +285,7 @@ void miband_nfc_scene_uid_check_on_enter(void* context) {
 
     for(int i = 0; i < 12 && !read_ok; i++) {
         furi_delay_ms(250);
-        if(iso14443_3a_poller_sync_read(app->nfc, &iso_data) == Iso14443_3aErrorNone &&
+        if(miband_card_io_activate(app->nfc, &iso_data) == Iso14443_3aErrorNone &&
            iso_data.uid_len >= 4) {
             read_ok = true;
             FURI_LOG_I(
@@ -368,15 +341,16 @@ void miband_nfc_scene_uid_check_on_enter(void* context) {
 
     // Inizializza tutti i campi a 0
     memset(uid_ctx, 0, sizeof(UidCheckContext));
+    atomic_init(&uid_ctx->update_pending, false);
 
     uid_ctx->app_ref = app; // Solo per riferimento, NON per chiamare funzioni!
     app->uid_check_context = uid_ctx; // Salva nell'app
 
-    uid_ctx->results = dynamic_array_alloc();
+    uid_ctx->results = result_list_alloc();
     if(!uid_ctx->results) {
         // LOG: Alloc array fallita
         if(app->logger) {
-            miband_logger_log(app->logger, LogLevelError, "Failed to allocate dynamic array");
+            miband_logger_log(app->logger, LogLevelError, "Failed to allocate result list");
         }
         free(uid_ctx);
         app->uid_check_context = NULL; // IMPORTANTE: resetta il puntatore
@@ -387,11 +361,15 @@ void miband_nfc_scene_uid_check_on_enter(void* context) {
     }
 
     uid_ctx->storage = app->storage;
-    memcpy(uid_ctx->target_uid, iso_data.uid, 4);
-    uid_ctx->scan_complete = false;
-    uid_ctx->scan_aborted = false;
-    uid_ctx->files_checked = 0;
-    uid_ctx->files_total = 0;
+    uid_ctx->view_dispatcher = app->view_dispatcher;
+    uid_ctx->target_uid_len = MIN(iso_data.uid_len, (size_t)MIBAND_UID_INDEX_UID_MAX);
+    memcpy(uid_ctx->target_uid, iso_data.uid, uid_ctx->target_uid_len);
+    uid_ctx->first_match = app->uid_check_first_match;
+    uid_ctx->index_entries = miband_nfc_get_profile(app)->uid_index_entries;
+    uid_ctx->matches = furi_message_queue_alloc(RESULTS_MAX, sizeof(const char*));
+    uid_ctx->matches_text = furi_string_alloc();
+    uid_ctx->report[0] = furi_string_alloc();
+    uid_ctx->report[1] = furi_string_alloc();
 
     memcpy(uid_ctx->block0.data, iso_data.uid, 4);
     uid_ctx->block0.data[4] = iso_data.uid[0] ^ iso_data.uid[1] ^ iso_data.uid[2] ^
@@ -400,92 +378,51 @@ void miband_nfc_scene_uid_check_on_enter(void* context) {
     uid_ctx->block0.data[6] = iso_data.atqa[0];
     uid_ctx->block0.data[7] = iso_data.atqa[1];
 
-    // STEP 3: Launch worker
-    popup_set_text(app->popup, "Scanning...\n\nInitializing", 64, 22, AlignCenter, AlignTop);
-
-    uid_ctx->thread =
-        furi_thread_alloc_ex("UidCheckWorker", 2048, uid_check_worker_thread, uid_ctx);
-
-    furi_thread_start(uid_ctx->thread);
-
-    // STEP 4: Poll worker with UI updates
-    uint32_t last_update = furi_get_tick();
-    uint32_t last_count = 0;
-
-    while(!uid_ctx->scan_complete) {
-        uint32_t now = furi_get_tick();
-
-        // Forza update se counter cambia O ogni 300ms
-        if((uid_ctx->files_checked != last_count) || (now - last_update > 300)) {
-            FuriString* msg = furi_string_alloc_printf(
-                "Scanning...\n\n%lu / %lu files\n%zu matches",
-                uid_ctx->files_checked,
-                uid_ctx->files_total > 0 ? uid_ctx->files_total : uid_ctx->files_checked,
-                uid_ctx->results->count);
-
-            popup_reset(app->popup);
-            popup_set_header(app->popup, "UID Check", 64, 4, AlignCenter, AlignTop);
-            popup_set_text(app->popup, furi_string_get_cstr(msg), 64, 18, AlignCenter, AlignTop);
-            furi_string_free(msg);
-
-            last_update = now;
-            last_count = uid_ctx->files_checked;
-        }
-
-        furi_delay_ms(50); // Ridotto da 100 a 50ms per UI più responsive
-    }
-
-    furi_thread_join(uid_ctx->thread);
-    furi_thread_free(uid_ctx->thread);
-
-    // LOG: Scan completato
-    if(app->logger) {
-        miband_logger_log(
-            app->logger,
-            LogLevelInfo,
-            "UID Check complete: %lu files scanned, %zu matches found",
-            uid_ctx->files_checked,
-            uid_ctx->results->count);
-    }
-
-    // STEP 5: Generate report
-    FuriString* report = generate_report(uid_ctx);
-    if(!report) {
-        // LOG: Report fallito
-        if(app->logger) {
-            miband_logger_log(app->logger, LogLevelError, "Failed to generate report");
-        }
-        dynamic_array_free(uid_ctx->results);
-        free(uid_ctx);
-        app->uid_check_context = NULL; // IMPORTANTE: resetta
-        popup_set_text(app->popup, "Error", 64, 22, AlignCenter, AlignTop);
-        furi_delay_ms(1500);
-        scene_manager_previous_scene(app->scene_manager);
-        return;
-    }
-
-    furi_string_set(app->temp_text_buffer, report);
-    furi_string_free(report);
-
-    dynamic_array_free(uid_ctx->results);
-    free(uid_ctx);
-    app->uid_check_context = NULL; // IMPORTANTE: resetta dopo free
-
+    // STEP 3: Show the report, it fills in as the worker finds matches
     popup_reset(app->popup);
-
     text_box_reset(app->text_box_report);
-    text_box_set_text(app->text_box_report, furi_string_get_cstr(app->temp_text_buffer));
     text_box_set_font(app->text_box_report, TextBoxFontText);
     text_box_set_focus(app->text_box_report, TextBoxFocusStart);
-
+    uid_check_update_report(app, uid_ctx, true);
     view_dispatcher_switch_to_view(app->view_dispatcher, MiBandNfcViewIdUidReport);
 
-    FURI_LOG_I(TAG, "=== UID CHECK DONE ===");
+    // STEP 4: Launch worker
+    uid_ctx->thread =
+        furi_thread_alloc_ex("UidCheckWorker", 2048, uid_check_worker_thread, uid_ctx);
+    furi_thread_start(uid_ctx->thread);
 }
 
 bool miband_nfc_scene_uid_check_on_event(void* context, SceneManagerEvent event) {
     MiBandNfcApp* app = context;
 
+    if(event.type == SceneManagerEventTypeCustom &&
+       event.event == MiBandNfcCustomEventUidCheckUpdate) {
+        UidCheckContext* uid_ctx = (UidCheckContext*)app->uid_check_context;
+        if(!uid_ctx) return true;
+
+        // Cleared first, so whatever the worker does from here on sends a new event
+        atomic_store(&uid_ctx->update_pending, false);
+        uid_check_update_report(app, uid_ctx, false);
+
+        if(uid_ctx->scan_complete && uid_ctx->thread) {
+            furi_thread_join(uid_ctx->thread);
+            furi_thread_free(uid_ctx->thread);
+            uid_ctx->thread = NULL;
+
+            // LOG: Scan completato
+            if(app->logger) {
+                miband_logger_log(
+                    app->logger,
+                    LogLevelInfo,
+                    "UID Check complete: %lu files scanned, %zu matches found",
+                    uid_ctx->files_checked,
+                    uid_ctx->matches_shown);
+            }
+            FURI_LOG_I(TAG, "=== UID CHECK DONE ===");
+        }
+        return true;
+    }
+
     if(event.type == SceneManagerEventTypeBack) {
         // Abort scan if running - usa il puntatore salvato nell'app
         if(app->uid_check_context) {
@@ -505,32 +442,26 @@ bool miband_nfc_scene_uid_check_on_event(void* context, SceneManagerEvent event)
 void miband_nfc_scene_uid_check_on_exit(void* context) {
     MiBandNfcApp* app = context;
 
+    // The text box points into the context report buffers
+    text_box_reset(app->text_box_report);
+
     // Cleanup usando il puntatore salvato nell'app
     if(app->uid_check_context) {
         UidCheckContext* uid_ctx = (UidCheckContext*)app->uid_check_context;
 
-        if(!uid_ctx->scan_complete) {
+        // Aspetta che il thread termini
+        if(uid_ctx->thread) {
             uid_ctx->scan_aborted = true;
-
-            // Aspetta che il thread termini
-            if(uid_ctx->thread) {
-                furi_thread_join(uid_ctx->thread);
-                furi_thread_free(uid_ctx->thread);
-                uid_ctx->thread = NULL;
-            }
+            furi_thread_join(uid_ctx->thread);
+            furi_thread_free(uid_ctx->thread);
+            uid_ctx->thread = NULL;
         }
 
         // Libera memoria
-        if(uid_ctx->results) {
-            dynamic_array_free(uid_ctx->results);
-            uid_ctx->results = NULL;
-        }
-
-        free(uid_ctx);
+        uid_check_context_free(uid_ctx);
         app->uid_check_context = NULL; // IMPORTANTE: resetta
     }
 
     notification_message(app->notifications, &sequence_blink_stop);
     popup_reset(app->popup);
-    text_box_reset(app->text_box_report);
 }
@@ -100,42 +100,20 @@ static void verify_tracker_init(void) {
 /**
  * @brief Update verification UI with current progress
  * 
- * Displays progress bar, statistics, and current operation status.
+ * Shows the current operation and the sector progress on the shared
+ * progress view; redraws are throttled by the tracker.
  * 
  * @param app Pointer to MiBandNfcApp instance
- * @param header Header text for the popup
+ * @param header Header text for the progress view
  */
 static void update_verify_ui(MiBandNfcApp* app, const char* header) {
-    furi_string_reset(app->temp_text_buffer);
-
-    if(verify_tracker.total_sectors > 0) {
-        uint32_t progress_percent =
-            verify_tracker.reading_complete ?
-                100 :
-                (verify_tracker.current_sector * 100) / verify_tracker.total_sectors;
-
-        furi_string_printf(
-            app->temp_text_buffer,
-            "Sector %lu/%lu\n[",
-            verify_tracker.current_sector,
-            verify_tracker.total_sectors);
-
-        for(uint32_t i = 0; i < 16; i++) {
-            if(i < (progress_percent / 6)) {
-                furi_string_cat_str(app->temp_text_buffer, "=");
-            } else {
-                furi_string_cat_str(app->temp_text_buffer, " ");
-            }
-        }
-        furi_string_cat_printf(app->temp_text_buffer, "] %lu%%", progress_percent);
-    } else {
-        furi_string_set_str(app->temp_text_buffer, "Initializing...");
-    }
-
-    popup_reset(app->popup);
-    popup_set_header(app->popup, header, 64, 4, AlignCenter, AlignTop);
-    popup_set_text(
-        app->popup, furi_string_get_cstr(app->temp_text_buffer), 64, 28, AlignCenter, AlignCenter);
+    progress_tracker_set_header(app->progress, header);
+    progress_tracker_set_status(
+        app->progress, furi_string_get_cstr(verify_tracker.current_operation));
+    progress_tracker_update(
+        app->progress,
+        verify_tracker.reading_complete ? verify_tracker.total_sectors :
+                                          verify_tracker.current_sector);
 }
 /**
  * @brief Read a sector using multiple key strategies
@@ -159,6 +137,7 @@ static bool read_sector_with_keys(
     uint8_t blocks_in_sector) {
     MfClassicError error;
     MfClassicAuthContext auth_context;
+    const MiBandRetryPolicy* policy = &miband_nfc_get_profile(app)->retry;
     MfClassicSectorTrailer* sec_tr =
         mf_classic_get_sector_trailer_by_sector(app->mf_classic_data, sector);
 
@@ -167,54 +146,48 @@ static bool read_sector_with_keys(
         return false;
     }
 
-    // Build list of keys to try
-    MfClassicKey keys_to_try[3];
-    MfClassicKeyType key_types[3];
-    int keys_count = 0;
-
-    // STRATEGY: Try dump keys first, then magic keys as fallback
-
-    // 1. Try Key A from dump
-    if(mf_classic_is_key_found(app->mf_classic_data, sector, MfClassicKeyTypeA)) {
-        memcpy(keys_to_try[keys_count].data, sec_tr->key_a.data, 6);
-        key_types[keys_count] = MfClassicKeyTypeA;
-        keys_count++;
-    }
-
-    // 2. Try Key B from dump
-    if(mf_classic_is_key_found(app->mf_classic_data, sector, MfClassicKeyTypeB)) {
-        memcpy(keys_to_try[keys_count].data, sec_tr->key_b.data, 6);
-        key_types[keys_count] = MfClassicKeyTypeB;
-        keys_count++;
-    }
-
-    // 3. Try magic key 0xFF as fallback
-    memset(keys_to_try[keys_count].data, 0xFF, 6);
-    key_types[keys_count] = MfClassicKeyTypeA;
-    keys_count++;
+    // Build list of keys to try: the key that last worked on this card goes
+    // first, then dump keys, then magic keys as fallback
+    MfClassicKey keys_to_try[MIBAND_AUTH_CACHE_MAX_CANDIDATES];
+    MfClassicKeyType key_types[MIBAND_AUTH_CACHE_MAX_CANDIDATES];
+    int keys_count = miband_auth_cache_get_candidates(
+        app->auth_cache, app->mf_classic_data, sector, false, keys_to_try, key_types);
 
-    // Try each key in order
+    // Try each key in order, the session auth tells whether it works
     for(int key_idx = 0; key_idx < keys_count; key_idx++) {
         verify_tracker.auth_attempts++;
 
-        error = mf_classic_poller_sync_auth(
-            app->nfc, first_block, &keys_to_try[key_idx], key_types[key_idx], &auth_context);
-
-        if(error != MfClassicErrorNone) {
+        // Read the whole sector in one auth session
+        MiBandSectorSessionRequest request = {
+            .op = MiBandSectorSessionOpRead,
+            .sector = sector,
+            .key = keys_to_try[key_idx],
+            .key_type = key_types[key_idx],
+            .block_mask = miband_sector_session_full_mask(sector),
+            .blocks = app->target_data->block,
+            .auth_cache = app->auth_cache,
+        };
+        MiBandSectorSessionResult session_result;
+        miband_sector_session_transfer(app->nfc, &request, policy->max_attempts, &session_result);
+
+        if(!session_result.authenticated) {
             continue; // Try next key
         }
 
         verify_tracker.auth_successes++;
         FURI_LOG_D(TAG, "Sector %zu: Auth OK with key %d", sector, key_idx);
 
-        // Read all blocks in the sector
+        // Fall back to per-block reads for whatever the session missed
         bool all_blocks_read = true;
         for(uint8_t block_in_sector = 0; block_in_sector < blocks_in_sector; block_in_sector++) {
             size_t block_idx = first_block + block_in_sector;
 
+            if(session_result.done_mask & (1U << block_in_sector)) continue;
+
             // Re-authenticate every 2 blocks for stability
             if(block_in_sector > 0 && block_in_sector % 2 == 0) {
-                error = mf_classic_poller_sync_auth(
+                error = miband_auth_cache_auth(
+                    app->auth_cache,
                     app->nfc,
                     first_block,
                     &keys_to_try[key_idx],
@@ -224,31 +197,31 @@ static bool read_sector_with_keys(
                 if(error != MfClassicErrorNone) {
                     FURI_LOG_W(TAG, "Re-auth failed at block %zu", block_idx);
                     all_blocks_read = false;
-                    miband_logger_log(
-                        app->logger, LogLevelError, "Auth failed on sector %zu", sector);
+                    miband_logger_event(
+                        app->logger,
+                        LogLevelError,
+                        MiBandLogEventAuthFailed,
+                        sector,
+                        block_idx,
+                        key_types[key_idx],
+                        error);
 
                     break;
                 }
             }
 
-            // Read block with retry logic
-            bool block_read = false;
-            for(int retry = 0; retry < 3 && !block_read; retry++) {
-                if(retry > 0) furi_delay_ms(50);
-
-                error = mf_classic_poller_sync_read_block(
+            // Read block, retrying timeouts per pipeline profile
+            MiBandRetry retry;
+            miband_retry_init(&retry, policy);
+            do {
+                error = miband_op_stats_read_block(
                     app->nfc,
                     block_idx,
                     &keys_to_try[key_idx],
                     key_types[key_idx],
                     &app->target_data->block[block_idx]);
-
-                if(error == MfClassicErrorNone) {
-                    block_read = true;
-                } else if(error != MfClassicErrorTimeout) {
-                    break; // Non-timeout error, stop retrying
-                }
-            }
+            } while(error != MfClassicErrorNone && miband_retry_next(&retry, error));
+            bool block_read = error == MfClassicErrorNone;
 
             if(!block_read) {
                 FURI_LOG_E(TAG, "Failed to read block %zu", block_idx);
@@ -260,9 +233,6 @@ static bool read_sector_with_keys(
         if(all_blocks_read) {
             FURI_BIT_SET(app->target_data->key_a_mask, sector);
             FURI_BIT_SET(app->target_data->key_b_mask, sector);
-            // view_port_update(view_dispatcher_get_current_view(app->view_dispatcher));
-            furi_delay_ms(10);
-
             return true;
         }
     }
@@ -285,40 +255,49 @@ static bool miband_verify_read_card(MiBandNfcApp* app) {
     }
 
     verify_tracker.total_sectors = mf_classic_get_total_sectors_num(app->mf_classic_data->type);
+    progress_tracker_reset(app->progress, verify_tracker.total_sectors, "Sector");
 
     furi_string_set_str(verify_tracker.current_operation, "Initializing read");
     update_verify_ui(app, "Reading Mi Band");
 
     mf_classic_reset(app->target_data);
+    app->target_snapshot_valid = false;
     app->target_data->type = app->mf_classic_data->type;
 
+    // Keys cached by the writer stay valid if the same band is still in the field
+    miband_card_session_refresh(app->card_session, app->nfc);
+    miband_auth_cache_reset_stats(app->auth_cache);
+
     bool overall_success = true;
 
-    for(size_t sector = 0; sector < verify_tracker.total_sectors; sector++) {
+    MiBandSectorIter iter;
+    miband_sector_iter_init(&iter, app->target_data->type);
+    while(miband_sector_iter_next(&iter)) {
+        size_t sector = iter.sector;
         verify_tracker.current_sector = sector;
 
         furi_string_printf(verify_tracker.current_operation, "Reading sector %zu", sector);
 
         // CHIAMALO PIÙ SPESSO - ogni settore
         update_verify_ui(app, "Reading Mi Band");
-        furi_delay_ms(50);
-
-        uint8_t first_block = mf_classic_get_first_block_num_of_sector(sector);
-        uint8_t blocks_in_sector = mf_classic_get_blocks_num_in_sector(sector);
 
-        bool sector_success = read_sector_with_keys(app, sector, first_block, blocks_in_sector);
+        bool sector_success =
+            read_sector_with_keys(app, sector, iter.first_block, iter.blocks_in_sector);
 
         if(sector_success) {
             verify_tracker.sectors_read++;
             furi_string_printf(verify_tracker.last_result, "Sector %zu OK", sector);
             update_verify_ui(app, "Reading Mi Band");
-            furi_delay_ms(50);
         } else {
             verify_tracker.sectors_failed++;
-            if(app->logger) {
-                miband_logger_log(
-                    app->logger, LogLevelError, "Verify: failed to read sector %zu", sector);
-            }
+            miband_logger_event(
+                app->logger,
+                LogLevelError,
+                MiBandLogEventReadFailed,
+                sector,
+                MIBAND_LOG_NONE,
+                MIBAND_LOG_NONE,
+                MfClassicErrorNone);
             overall_success = false;
             furi_string_printf(verify_tracker.error_details, "Sector %zu failed", sector);
             FURI_LOG_E(TAG, "Failed to read sector %zu", sector);
@@ -328,6 +307,15 @@ static bool miband_verify_read_card(MiBandNfcApp* app) {
     verify_tracker.current_sector = verify_tracker.total_sectors;
     verify_tracker.reading_complete = true;
 
+    if(app->logger) {
+        miband_logger_log(
+            app->logger,
+            LogLevelInfo,
+            "Verify: %lu auth attempts, %lu failed",
+            miband_auth_cache_get_attempts(app->auth_cache),
+            miband_auth_cache_get_failures(app->auth_cache));
+    }
+
     if(overall_success) {
         furi_string_set_str(verify_tracker.current_operation, "Read complete");
         furi_string_printf(
@@ -339,7 +327,7 @@ static bool miband_verify_read_card(MiBandNfcApp* app) {
     }
 
     update_verify_ui(app, "Read Complete");
-    furi_delay_ms(1000);
+    app->target_snapshot_valid = overall_success;
 
     return overall_success;
 }
@@ -367,6 +355,7 @@ static NfcCommand miband_verify_reader_callback(NfcGenericEvent event, void* con
     } else if(mfc_event->type == MfClassicPollerEventTypeRequestMode) {
         mfc_event->data->poller_mode.mode = MfClassicPollerModeRead;
         mf_classic_reset(app->target_data);
+        app->target_snapshot_valid = false;
         mfc_event->data->poller_mode.data = app->target_data;
 
     } else if(
@@ -405,16 +394,27 @@ void miband_nfc_scene_verify_on_enter(void* context) {
         app->scene_manager, MiBandNfcSceneVerify, MiBandNfcSceneVerifyStateCardSearch);
 
     popup_reset(app->popup);
-    popup_set_header(app->popup, "Verify Data", 64, 2, AlignCenter, AlignTop);
-    furi_string_set_str(verify_tracker.current_operation, "Place Mi Band near Flipper");
+    progress_tracker_reset(app->progress, 0, "Sector");
+    furi_string_set_str(verify_tracker.current_operation, "Place Mi Band nearby");
     update_verify_ui(app, "Verify Data");
 
-    view_dispatcher_switch_to_view(app->view_dispatcher, MiBandNfcViewIdScanner);
+    view_dispatcher_switch_to_view(app->view_dispatcher, MiBandNfcViewIdProgress);
     notification_message(app->notifications, &sequence_blink_start_cyan);
 
     mf_classic_reset(app->target_data);
+    app->target_snapshot_valid = false;
     app->target_data->type = app->mf_classic_data->type;
 
+    // Chained from the writer with the band still in place: read it right away
+    if(miband_card_session_is_active(app->card_session) &&
+       miband_card_session_refresh(app->card_session, app->nfc)) {
+        FURI_LOG_I(TAG, "Card session still active, skipping detection");
+        scene_manager_set_scene_state(
+            app->scene_manager, MiBandNfcSceneVerify, MiBandNfcSceneVerifyStateReading);
+        view_dispatcher_send_custom_event(app->view_dispatcher, MiBandNfcCustomEventPollerDone);
+        return;
+    }
+
     app->poller = nfc_poller_alloc(app->nfc, NfcProtocolMfClassic);
     nfc_poller_start(app->poller, miband_verify_reader_callback, app);
 }
@@ -452,7 +452,9 @@ bool miband_nfc_scene_verify_on_event(void* context, SceneManagerEvent event) {
             scene_manager_set_scene_state(
                 app->scene_manager, MiBandNfcSceneVerify, MiBandNfcSceneVerifyStateComparison);
 
+            miband_op_stats_begin(&app->op_stats, "Verify");
             bool read_success = miband_verify_read_card(app);
+            miband_op_stats_end(app->logger);
 
             if(!read_success) {
                 notification_message(app->notifications, &sequence_error);
@@ -462,8 +464,7 @@ bool miband_nfc_scene_verify_on_event(void* context, SceneManagerEvent event) {
                 bool has_card_uid = false;
 
                 for(int attempt = 0; attempt < 3; attempt++) {
-                    if(iso14443_3a_poller_sync_read(app->nfc, &card_iso_data) ==
-                       Iso14443_3aErrorNone) {
+                    if(miband_card_io_activate(app->nfc, &card_iso_data) == Iso14443_3aErrorNone) {
                         has_card_uid = true;
                         break;
                     }
@@ -579,44 +580,16 @@ bool miband_nfc_scene_verify_on_event(void* context, SceneManagerEvent event) {
             }
             furi_string_set_str(verify_tracker.current_operation, "Comparing data");
             update_verify_ui(app, "Comparing Data");
-            furi_delay_ms(500);
-
-            bool data_match = true;
-            int different_blocks = 0;
-            size_t total_blocks = mf_classic_get_total_block_num(app->mf_classic_data->type);
-
-            for(size_t i = 0; i < total_blocks; i++) {
-                verify_tracker.blocks_compared++;
-
-                if(i % 16 == 0) {
-                    furi_string_printf(
-                        verify_tracker.current_operation,
-                        "Comparing block %zu/%zu",
-                        i,
-                        total_blocks);
-                    update_verify_ui(app, "Comparing Data");
-                }
 
-                if(i == 0) {
-                    FURI_LOG_D(TAG, "Skipping Block 0 (UID block)");
-                    continue;
-                } else if(mf_classic_is_sector_trailer(i)) {
-                    FURI_LOG_D(TAG, "Skipping trailer block %zu", i);
-                    continue;
-                } else {
-                    if(memcmp(
-                           app->mf_classic_data->block[i].data,
-                           app->target_data->block[i].data,
-                           16) != 0) {
-                        data_match = false;
-                        different_blocks++;
-                        verify_tracker.blocks_different++;
-                        FURI_LOG_W(TAG, "Block %zu differs", i);
-                    }
-                }
-            }
+            // Block 0 and trailers are skipped, the diff viewer lists the blocks
+            verify_tracker.blocks_compared =
+                mf_classic_get_total_block_num(app->mf_classic_data->type);
+            int different_blocks =
+                miband_block_diff_collect(app->mf_classic_data, app->target_data, NULL, 0);
+            verify_tracker.blocks_different = different_blocks;
+            if(different_blocks > 0) FURI_LOG_W(TAG, "%d blocks differ", different_blocks);
 
-            if(data_match && different_blocks == 0) {
+            if(different_blocks == 0) {
                 // SUCCESS
                 notification_message(app->notifications, &sequence_success);
 
@@ -691,6 +664,7 @@ bool miband_nfc_scene_verify_on_event(void* context, SceneManagerEvent event) {
         case MiBandNfcCustomEventPollerFailed:
             notification_message(app->notifications, &sequence_error);
             furi_string_set_str(verify_tracker.error_details, "Card detection failed");
+            furi_string_set_str(verify_tracker.current_operation, "Card detection failed");
             update_verify_ui(app, "Detection Failed");
             furi_delay_ms(2000);
             scene_manager_search_and_switch_to_another_scene(
@@ -9,67 +9,523 @@
  * 3. Writes all data blocks and sector trailers
  * 4. Uses appropriate authentication keys (0xFF for magic cards, dump keys for rewrites)
  * 5. Provides real-time progress feedback
+ * 6. Optionally verifies each sector while it is still authenticated
+ * 7. Skips blocks the band already holds when a fresh snapshot of it exists
+ *
+ * The write itself runs on a dedicated worker thread so the GUI stays
+ * responsive: the worker reports progress and completion through custom
+ * events, and Back aborts it before the next block operation.
+ *
+ * In batch mode the loaded dump is written to one band after another: once
+ * a band is done the worker waits for it to leave the field, then the
+ * scanner restarts for the next one.
  */
 
 #include "miband_nfc_i.h"
-#include <nfc/protocols/mf_classic/mf_classic_poller_sync.h>
 
-#define TAG "MiBandNfc"
+#define TAG                      "MiBandNfc"
+#define WRITER_WORKER_STACK_SIZE (4 * 1024)
+#define WRITER_SUCCESS_POPUP_MS  2000
+#define WRITER_FAILURE_POPUP_MS  3000
+
+#define WRITER_BATCH_POLL_MS        100
+#define WRITER_BATCH_REMOVAL_MISSES 3 // Consecutive failed polls that mean "band removed"
+
+enum {
+    MiBandNfcSceneWriterStateWaiting,
+    MiBandNfcSceneWriterStateWriting,
+    MiBandNfcSceneWriterStateSuccess,
+    MiBandNfcSceneWriterStateFailed,
+};
+
+/**
+ * @brief Write pipeline stage, reported by the worker for the progress view
+ */
+typedef enum {
+    WriterStageDetecting,
+    WriterStageMagicKeys,
+    WriterStageOriginalKeys,
+    WriterStageWriting,
+} WriterStage;
+
+/**
+ * @brief Writer worker state shared between the worker and the GUI thread
+ *
+ * The worker only writes the volatile status fields. Progress goes straight
+ * to the app's ProgressTracker, whose view model is locked and throttled.
+ */
+typedef struct {
+    MiBandNfcApp* app;
+    FuriThread* thread;
+
+    volatile bool abort_requested;
+    volatile bool write_result;
+    volatile WriterStage stage;
+    const char* volatile failure_text;
+
+    bool verify; // Read back each data block right after writing it
+    volatile bool verify_failed;
+    volatile uint32_t blocks_rewritten;
+    char failure_details[48]; // Backing store for failure_text on verify errors
+
+    bool delta; // A snapshot of this band is in target_data: skip unchanged blocks
+    volatile uint32_t blocks_skipped;
+
+    bool batch; // Wait for the band to be removed once the write is done
+} WriterContext;
+
+static const char* const writer_stage_status[] = {
+    [WriterStageDetecting] = "Detecting card state...",
+    [WriterStageMagicKeys] = "Magic keys, writing...",
+    [WriterStageOriginalKeys] = "Original keys, rewriting...",
+    [WriterStageWriting] = "Writing...",
+};
+
+/**
+ * @brief Check whether the write must stop
+ *
+ * True when the user pressed Back or a block failed verification. Called
+ * before every block operation so Back takes effect quickly.
+ */
+static bool writer_abort_requested(WriterContext* ctx) {
+    if(ctx->abort_requested) {
+        FURI_LOG_W(TAG, "Write aborted by user");
+        return true;
+    }
+    return ctx->verify_failed;
+}
+
+/**
+ * @brief Record a block that still reads back different after a rewrite
+ */
+static void writer_report_mismatch(WriterContext* ctx, size_t block_idx) {
+    if(ctx->verify_failed) return;
+
+    snprintf(
+        ctx->failure_details,
+        sizeof(ctx->failure_details),
+        "Verify failed\nBlock %zu differs\nafter rewrite",
+        block_idx);
+    ctx->failure_text = ctx->failure_details;
+    ctx->verify_failed = true;
+
+    miband_logger_event(
+        ctx->app->logger,
+        LogLevelError,
+        MiBandLogEventVerifyMismatch,
+        mf_classic_get_sector_by_block(block_idx),
+        block_idx,
+        MIBAND_LOG_NONE,
+        MfClassicErrorNone);
+}
+
+/**
+ * @brief Publish a stage change to the progress view
+ *
+ * Only a change of stage touches the status line; sector progress goes
+ * through progress_tracker_update(), which throttles redraws.
+ */
+static void writer_report_stage(WriterContext* ctx, WriterStage stage) {
+    if(ctx->stage == stage) return;
+    ctx->stage = stage;
+    progress_tracker_set_status(ctx->app->progress, writer_stage_status[stage]);
+}
+
+/**
+ * @brief Check whether a key is the 0xFF magic key
+ */
+static bool writer_key_is_magic(const MfClassicKey* key) {
+    for(size_t i = 0; i < sizeof(key->data); i++) {
+        if(key->data[i] != 0xFF) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Cache the key just written into a sector trailer
+ *
+ * After the trailer write the card answers to the dump's Key A, so verify
+ * and later writes can authenticate at the first attempt.
+ */
+static void writer_cache_written_trailer(MiBandNfcApp* app, size_t sector, size_t trailer_idx) {
+    MfClassicKey written_key;
+    memcpy(
+        written_key.data,
+        app->mf_classic_data->block[trailer_idx].data,
+        sizeof(written_key.data));
+    miband_auth_cache_set(app->auth_cache, sector, &written_key, MfClassicKeyTypeA);
+}
+
+/**
+ * @brief Checkpoint a sector that is on the card
+ *
+ * With the resume file enabled the checkpoint is stored right away, so a
+ * write killed partway (app closed, battery, crash) still resumes after it.
+ */
+static void writer_checkpoint_sector(MiBandNfcApp* app, size_t sector) {
+    miband_write_checkpoint_commit(&app->write_checkpoint, sector);
+    if(app->write_checkpoint_file) {
+        miband_write_checkpoint_save(&app->write_checkpoint, app->storage);
+    }
+}
+
+/**
+ * @brief Record a sector whose trailer (the last block written) is on the card
+ *
+ * Caches the new key and checkpoints the sector, so a write interrupted
+ * later resumes after it.
+ */
+static void writer_commit_sector(MiBandNfcApp* app, size_t sector, size_t trailer_idx) {
+    writer_cache_written_trailer(app, sector, trailer_idx);
+    writer_checkpoint_sector(app, sector);
+}
+
+/**
+ * @brief Write blocks of one sector inside a single auth session
+ *
+ * Fast path for the sector writers: one auth handshake for the whole sector
+ * instead of one per block. Whatever is left unwritten goes through the
+ * per-block retry logic. The session auth is counted by the auth cache, and
+ * a key whose auth only timed out is retried with the profile's backoff.
+ *
+ * @param ctx Writer worker context
+ * @param sector Sector number to write
+ * @param block_mask Blocks to write, bit N = Nth block of the sector
+ * @param auth_key Authentication key to use
+ * @param key_type Key type (A or B)
+ * @param authenticated Output, false if no session got past the auth
+ * @return Mask of the blocks written
+ */
+static uint16_t writer_session_write(
+    WriterContext* ctx,
+    size_t sector,
+    uint16_t block_mask,
+    const MfClassicKey* auth_key,
+    MfClassicKeyType key_type,
+    bool* authenticated) {
+    MiBandNfcApp* app = ctx->app;
+
+    *authenticated = false;
+    if(writer_abort_requested(ctx)) return 0;
+
+    MiBandSectorSessionRequest request = {
+        .op = ctx->verify ? MiBandSectorSessionOpWriteVerify : MiBandSectorSessionOpWrite,
+        .sector = sector,
+        .key = *auth_key,
+        .key_type = key_type,
+        .block_mask = block_mask,
+        .blocks = app->mf_classic_data->block,
+        .auth_cache = app->auth_cache,
+    };
+    MiBandSectorSessionResult result;
+
+    const MiBandRetryPolicy* policy = &miband_nfc_get_profile(app)->retry;
+    MiBandRetry retry;
+    miband_retry_init(&retry, policy);
+
+    bool transferred;
+    do {
+        transferred =
+            miband_sector_session_transfer(app->nfc, &request, policy->max_attempts, &result);
+    } while(!result.authenticated && !writer_abort_requested(ctx) &&
+            miband_retry_next(&retry, result.error));
+
+    if(!transferred) {
+        FURI_LOG_W(
+            TAG,
+            "Sector %zu: session write stopped at block %u, falling back",
+            sector,
+            result.failed_block);
+    }
+
+    *authenticated = result.authenticated;
+    ctx->blocks_rewritten += result.rewrites;
+    if(result.mismatch_mask) {
+        uint8_t first_block = mf_classic_get_first_block_num_of_sector(sector);
+        writer_report_mismatch(ctx, first_block + __builtin_ctz(result.mismatch_mask));
+    }
+
+    return result.done_mask & block_mask;
+}
+
+/**
+ * @brief Write one block, retrying timeouts with the pipeline profile's backoff
+ *
+ * Each sync write activates and authenticates on its own, so no separate
+ * re-auth is needed between attempts.
+ *
+ * @param ctx Writer worker context
+ * @param block_idx Block to write
+ * @param auth_key Authentication key to use
+ * @param key_type Key type (A or B)
+ * @return MfClassicError of the last attempt
+ */
+static MfClassicError writer_write_block_with_retry(
+    WriterContext* ctx,
+    size_t block_idx,
+    MfClassicKey* auth_key,
+    MfClassicKeyType key_type) {
+    MiBandNfcApp* app = ctx->app;
+    MfClassicError error;
+    MiBandRetry retry;
+    miband_retry_init(&retry, &miband_nfc_get_profile(app)->retry);
+
+    do {
+        error = miband_op_stats_write_block(
+            app->nfc, block_idx, auth_key, key_type, &app->mf_classic_data->block[block_idx]);
+    } while(error != MfClassicErrorNone && !writer_abort_requested(ctx) &&
+            miband_retry_next(&retry, error));
+
+    return error;
+}
+
+/**
+ * @brief Authenticate a block, retrying timeouts with the pipeline profile's backoff
+ *
+ * @param ctx Writer worker context
+ * @param block_num Block to authenticate
+ * @param key Key to try
+ * @param key_type Key type (A or B)
+ * @return MfClassicError of the last attempt
+ */
+static MfClassicError writer_auth_with_retry(
+    WriterContext* ctx,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type) {
+    MiBandNfcApp* app = ctx->app;
+    MfClassicAuthContext auth_context;
+    MfClassicError error;
+    MiBandRetry retry;
+    miband_retry_init(&retry, &miband_nfc_get_profile(app)->retry);
+
+    do {
+        error = miband_auth_cache_auth(
+            app->auth_cache, app->nfc, block_num, key, key_type, &auth_context);
+    } while(error != MfClassicErrorNone && !writer_abort_requested(ctx) &&
+            miband_retry_next(&retry, error));
+
+    return error;
+}
+
+/**
+ * @brief Authenticate sector 0 and read Block 0, retrying timeouts
+ *
+ * Runs as a read session so the auth that tests the key also covers the
+ * read. A timeout opens a new session, as the failed exchange ends the
+ * crypto session.
+ *
+ * @param ctx Writer worker context
+ * @param key Key to try
+ * @param key_type Key type (A or B)
+ * @param block0 Output Block 0
+ * @return MfClassicError of the last attempt
+ */
+static MfClassicError writer_read_block0(
+    WriterContext* ctx,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicBlock* block0) {
+    MiBandNfcApp* app = ctx->app;
+    MiBandSectorSessionRequest request = {
+        .op = MiBandSectorSessionOpRead,
+        .sector = 0,
+        .key = *key,
+        .key_type = key_type,
+        .block_mask = 1U,
+        .blocks = block0,
+        .auth_cache = app->auth_cache,
+    };
+    MiBandSectorSessionResult result;
+    miband_sector_session_transfer(
+        app->nfc, &request, miband_nfc_get_profile(app)->retry.max_attempts, &result);
+
+    return result.error;
+}
+
+/**
+ * @brief Write a data block and, in write+verify mode, read it back
+ *
+ * Fallback counterpart of the session write+verify: a block that reads back
+ * different is rewritten once before the write is declared failed.
+ *
+ * @param ctx Writer worker context
+ * @param block_idx Data block to write
+ * @param auth_key Authentication key to use
+ * @param key_type Key type (A or B)
+ * @return true if the block was written (and verified when enabled)
+ */
+static bool writer_write_data_block(
+    WriterContext* ctx,
+    size_t block_idx,
+    MfClassicKey* auth_key,
+    MfClassicKeyType key_type) {
+    MiBandNfcApp* app = ctx->app;
+    const MfClassicBlock* expected = &app->mf_classic_data->block[block_idx];
+
+    for(uint8_t rewrite = 0;; rewrite++) {
+        if(writer_write_block_with_retry(ctx, block_idx, auth_key, key_type) !=
+           MfClassicErrorNone) {
+            return false;
+        }
+        if(!ctx->verify) return true;
+
+        MfClassicBlock readback;
+        if(miband_op_stats_read_block(app->nfc, block_idx, auth_key, key_type, &readback) !=
+           MfClassicErrorNone) {
+            return false;
+        }
+        if(memcmp(readback.data, expected->data, sizeof(readback.data)) == 0) return true;
+
+        if(rewrite == MIBAND_SECTOR_SESSION_VERIFY_REWRITES) break;
+        FURI_LOG_W(TAG, "Block %zu reads back different, rewriting", block_idx);
+        ctx->blocks_rewritten++;
+    }
+
+    writer_report_mismatch(ctx, block_idx);
+    return false;
+}
+
+/**
+ * @brief Check whether the snapshot in target_data was read from the band in the field
+ *
+ * The snapshot's Block 0 must start with the UID the auth cache is bound to.
+ */
+static bool writer_snapshot_matches_card(MiBandNfcApp* app) {
+    if(!app->target_snapshot_valid) return false;
+
+    size_t uid_len;
+    const uint8_t* uid = miband_auth_cache_get_uid(app->auth_cache, &uid_len);
+    return uid_len > 0 && memcmp(app->target_data->block[0].data, uid, uid_len) == 0;
+}
+
+/**
+ * @brief Check whether the band already holds the dump's sector trailer
+ *
+ * Key A cannot be read back, so the key that last authenticated the sector
+ * stands in for it. Access bits, GPB and Key B are compared with the snapshot;
+ * an unreadable Key B reads as zeros and forces the write.
+ */
+static bool writer_trailer_matches_card(MiBandNfcApp* app, size_t sector, size_t trailer_idx) {
+    MfClassicKey key;
+    MfClassicKeyType key_type;
+    if(!miband_auth_cache_get(app->auth_cache, sector, &key, &key_type) ||
+       key_type != MfClassicKeyTypeA) {
+        return false;
+    }
+
+    const uint8_t* expected = app->mf_classic_data->block[trailer_idx].data;
+    const uint8_t* found = app->target_data->block[trailer_idx].data;
+
+    return memcmp(key.data, expected, sizeof(key.data)) == 0 &&
+           memcmp(&found[sizeof(key.data)],
+                  &expected[sizeof(key.data)],
+                  MF_CLASSIC_BLOCK_SIZE - sizeof(key.data)) == 0;
+}
+
+/**
+ * @brief Get the blocks of a sector that need writing
+ *
+ * Every block except Block 0 in full mode. In delta mode, blocks identical to
+ * the snapshot are left out and counted as skipped.
+ *
+ * @param ctx Writer worker context
+ * @param sector Sector number
+ * @return Block mask, bit N = Nth block of the sector
+ */
+static uint16_t writer_sector_write_mask(WriterContext* ctx, size_t sector) {
+    MiBandNfcApp* app = ctx->app;
+    uint16_t mask = miband_sector_session_full_mask(sector);
+    if(sector == 0) mask &= ~1U; // Block 0 is never written
+
+    if(!ctx->delta) return mask;
+
+    uint8_t first_block = mf_classic_get_first_block_num_of_sector(sector);
+    uint8_t blocks_in_sector = mf_classic_get_blocks_num_in_sector(sector);
+    uint16_t trailer_bit = 1U << (blocks_in_sector - 1);
+
+    uint16_t write_mask =
+        miband_block_diff_sector(app->mf_classic_data, app->target_data, sector) & mask;
+    if(!writer_trailer_matches_card(app, sector, first_block + blocks_in_sector - 1)) {
+        write_mask |= trailer_bit;
+    }
+
+    ctx->blocks_skipped += __builtin_popcount(mask & ~write_mask);
+    return write_mask;
+}
 
 /**
  * @brief Write all blocks in a sector (excluding Block 0)
  * 
  * Helper function that writes all data blocks and the sector trailer
- * for a given sector. Uses retry logic for reliability.
+ * for a given sector in a single auth session. Blocks the session could not
+ * write fall back to per-block writes with retry logic. The session auth
+ * tests the key: if it never succeeds, nothing falls back and the caller
+ * moves on to its next key.
  * 
- * @param app Pointer to MiBandNfcApp instance
+ * @param ctx Writer worker context
  * @param sector Sector number to write
  * @param first_block First block index of the sector
  * @param blocks_in_sector Number of blocks in the sector
+ * @param write_mask Blocks to write, from writer_sector_write_mask()
  * @param auth_key Authentication key to use
  * @param key_type Key type (A or B)
  * @return true if all blocks written successfully, false otherwise
  */
 static bool write_sector_blocks(
-    MiBandNfcApp* app,
+    WriterContext* ctx,
     size_t sector,
     uint8_t first_block,
     uint8_t blocks_in_sector,
+    uint16_t write_mask,
     MfClassicKey* auth_key,
     MfClassicKeyType key_type) {
+    MiBandNfcApp* app = ctx->app;
     MfClassicError error;
     MfClassicAuthContext auth_context;
+    size_t trailer_idx = first_block + blocks_in_sector - 1;
+    uint16_t trailer_bit = 1U << (blocks_in_sector - 1);
+
+    // Fast path: whole sector in one auth session, which also tests the key
+    bool authenticated;
+    uint16_t written_mask =
+        writer_session_write(ctx, sector, write_mask, auth_key, key_type, &authenticated);
+    if(!authenticated) {
+        FURI_LOG_D(TAG, "Sector %zu: key rejected or card unreachable", sector);
+        return false;
+    }
+
+    // Blocks that need no write count as done
+    written_mask |= ~write_mask;
 
-    // Write all data blocks (excluding the trailer)
+    // Write remaining data blocks (excluding the trailer)
     for(uint8_t block_in_sector = 0; block_in_sector < (blocks_in_sector - 1); block_in_sector++) {
         size_t block_idx = first_block + block_in_sector;
 
+        if(written_mask & (1U << block_in_sector)) continue;
+        if(writer_abort_requested(ctx)) return false;
+
         // Re-authenticate before each block (except first)
         if(block_in_sector > 0) {
-            error = mf_classic_poller_sync_auth(
-                app->nfc, first_block, auth_key, key_type, &auth_context);
+            error = miband_auth_cache_auth(
+                app->auth_cache, app->nfc, first_block, auth_key, key_type, &auth_context);
             if(error != MfClassicErrorNone) {
                 FURI_LOG_E(TAG, "Re-auth failed for block %zu", block_idx);
-                miband_logger_log(app->logger, LogLevelError, "Auth failed on sector %zu", sector);
+                miband_logger_event(
+                    app->logger,
+                    LogLevelError,
+                    MiBandLogEventAuthFailed,
+                    sector,
+                    block_idx,
+                    key_type,
+                    error);
 
                 return false;
             }
         }
 
-        // Write block with retry logic (up to 3 attempts)
-        bool block_written = false;
-        for(int retry = 0; retry < 3 && !block_written; retry++) {
-            if(retry > 0) furi_delay_ms(100); // Delay between retries
-
-            error = mf_classic_poller_sync_write_block(
-                app->nfc, block_idx, auth_key, key_type, &app->mf_classic_data->block[block_idx]);
-
-            if(error == MfClassicErrorNone) {
-                block_written = true;
-            } else if(error != MfClassicErrorTimeout) {
-                break; // Non-timeout error, stop retrying
-            }
-        }
+        // Write block, retrying timeouts per pipeline profile
+        bool block_written = writer_write_data_block(ctx, block_idx, auth_key, key_type);
 
         if(!block_written) {
             FURI_LOG_E(TAG, "Failed to write block %zu", block_idx);
@@ -78,31 +534,13 @@ static bool write_sector_blocks(
     }
 
     // Write the sector trailer
-    size_t trailer_idx = first_block + blocks_in_sector - 1;
-    bool trailer_written = false;
-
-    for(int retry = 0; retry < 3 && !trailer_written; retry++) {
-        if(retry > 0) {
-            furi_delay_ms(100);
-            // Re-authenticate before retry
-            error = mf_classic_poller_sync_auth(
-                app->nfc, first_block, auth_key, key_type, &auth_context);
-            if(error != MfClassicErrorNone) {
-                FURI_LOG_E(TAG, "Re-auth failed for trailer");
-                miband_logger_log(app->logger, LogLevelError, "Auth failed on sector %zu", sector);
+    bool trailer_written = (written_mask & trailer_bit) != 0;
 
-                return false;
-            }
-        }
-
-        error = mf_classic_poller_sync_write_block(
-            app->nfc, trailer_idx, auth_key, key_type, &app->mf_classic_data->block[trailer_idx]);
+    if(!trailer_written) {
+        if(writer_abort_requested(ctx)) return false;
 
-        if(error == MfClassicErrorNone) {
-            trailer_written = true;
-        } else if(error != MfClassicErrorTimeout) {
-            break; // Non-timeout error, stop retrying
-        }
+        error = writer_write_block_with_retry(ctx, trailer_idx, auth_key, key_type);
+        trailer_written = error == MfClassicErrorNone;
     }
 
     if(!trailer_written) {
@@ -110,6 +548,8 @@ static bool write_sector_blocks(
         return false;
     }
 
+    writer_commit_sector(app, sector, trailer_idx);
+
     FURI_LOG_I(TAG, "Sector %zu: Write SUCCESS", sector);
     return true;
 }
@@ -123,11 +563,15 @@ static bool write_sector_blocks(
  * 3. Writes all sectors with appropriate authentication
  * 4. Provides progress feedback
  * 5. FIXED: Properly handles authentication with 0xFF keys for first write
+ *
+ * Runs on the writer worker thread: UI updates go through writer_report_stage().
  * 
- * @param app Pointer to MiBandNfcApp instance
+ * @param ctx Writer worker context
  * @return true if write successful, false otherwise
  */
-static bool miband_write_with_sync_approach(MiBandNfcApp* app) {
+static bool miband_write_with_sync_approach(WriterContext* ctx) {
+    MiBandNfcApp* app = ctx->app;
+
     if(!app->is_valid_nfc_data) {
         FURI_LOG_E(TAG, "No valid NFC data to write");
         return false;
@@ -137,8 +581,7 @@ static bool miband_write_with_sync_approach(MiBandNfcApp* app) {
         miband_logger_log(app->logger, LogLevelInfo, "Starting sync write approach");
     }
 
-    popup_set_text(app->popup, "Detecting card state...", 64, 24, AlignCenter, AlignTop);
-    furi_delay_ms(100);
+    writer_report_stage(ctx, WriterStageDetecting);
 
     MfClassicError error = MfClassicErrorNone;
     size_t total_blocks = mf_classic_get_total_block_num(app->mf_classic_data->type);
@@ -147,77 +590,125 @@ static bool miband_write_with_sync_approach(MiBandNfcApp* app) {
     FURI_LOG_I(
         TAG, "Starting sync write for %zu blocks in %zu sectors", total_blocks, total_sectors);
 
-    FuriString* progress_msg = furi_string_alloc();
     bool should_break = false;
     bool write_success = true;
 
-    // 1. Detect card type
+    // 1. Detect card type, once per card session
+    if(!miband_card_session_refresh(app->card_session, app->nfc)) {
+        FURI_LOG_E(TAG, "Card not present before write");
+        ctx->failure_text = "Card not detected\nCheck position";
+        return false;
+    }
+
     MfClassicType type = MfClassicType1k;
-    MfClassicError detect_error = mf_classic_poller_sync_detect_type(app->nfc, &type);
+    MfClassicError detect_error =
+        miband_card_session_get_type(app->card_session, app->nfc, &type);
     if(detect_error != MfClassicErrorNone) {
         FURI_LOG_E(TAG, "Card detection failed before write: %d", detect_error);
-        furi_string_free(progress_msg);
-        popup_set_text(
-            app->popup, "Card not detected\nCheck position", 64, 24, AlignCenter, AlignTop);
-        furi_delay_ms(2000);
+        ctx->failure_text = "Card not detected\nCheck position";
         return false;
     }
 
     FURI_LOG_I(TAG, "Card detected successfully, type: %d", type);
 
+    if(mf_classic_get_total_sectors_num(type) < total_sectors) {
+        FURI_LOG_E(TAG, "Card type %d is smaller than the dump", type);
+        ctx->failure_text = "Card too small\nfor this dump";
+        return false;
+    }
+
+    // Same band and dump as an interrupted write: skip the sectors already on it
+    size_t uid_len;
+    const uint8_t* uid = miband_card_session_get_uid(app->card_session, &uid_len);
+    if(miband_write_checkpoint_begin(
+           &app->write_checkpoint,
+           uid,
+           uid_len,
+           miband_write_checkpoint_dump_id(app->mf_classic_data))) {
+        uint32_t committed = miband_write_checkpoint_get_count(&app->write_checkpoint);
+        FURI_LOG_I(TAG, "Resuming write, %lu sectors already committed", committed);
+        if(app->logger) {
+            miband_logger_log(
+                app->logger,
+                LogLevelInfo,
+                "Resuming write: %lu sectors already committed",
+                committed);
+        }
+    }
+
     // 2. Detect if card has magic keys (0xFF) or original keys
     bool has_magic_keys = false;
     MfClassicKey test_key = {0};
     memset(test_key.data, 0xFF, sizeof(test_key.data));
-    MfClassicAuthContext test_auth;
+    MfClassicKeyType cached_type;
 
-    // Try to authenticate to sector 1 (block 4) with 0xFF keys
-    MfClassicError test_error =
-        mf_classic_poller_sync_auth(app->nfc, 4, &test_key, MfClassicKeyTypeA, &test_auth);
+    // The card session bound the key cache to this card; keys found by backup are reused
+    miband_auth_cache_reset_stats(app->auth_cache);
+
+    // Delta write when backup (or verify) just read this very band
+    const MiBandPipelineProfile* profile = miband_nfc_get_profile(app);
+    ctx->delta = profile->delta_write && writer_snapshot_matches_card(app);
+    if(ctx->delta) {
+        FURI_LOG_I(TAG, "Snapshot matches card, writing changed blocks only");
+    }
+
+    MfClassicError test_error;
+    MiBandCardKeyState key_state = miband_card_session_get_key_state(app->card_session);
+    if(key_state != MiBandCardKeysUnknown) {
+        // Backup or a previous write already told which keys the band uses
+        test_error = key_state == MiBandCardKeysMagic ? MfClassicErrorNone : MfClassicErrorAuth;
+    } else if(miband_auth_cache_get(app->auth_cache, 1, &test_key, &cached_type)) {
+        // Sector 1 key already known, no need for a test auth
+        test_error = writer_key_is_magic(&test_key) ? MfClassicErrorNone : MfClassicErrorAuth;
+    } else if(profile->skip_detection) {
+        // Profile trusts the band to be blank, the dump keys remain the fallback
+        test_error = MfClassicErrorNone;
+    } else {
+        // Try to authenticate to sector 1 (block 4) with 0xFF keys
+        test_error = writer_auth_with_retry(ctx, 4, &test_key, MfClassicKeyTypeA);
+    }
 
     if(test_error == MfClassicErrorNone) {
         has_magic_keys = true;
         FURI_LOG_I(TAG, "Mi Band has 0xFF magic keys - first write scenario");
-        popup_set_text(
-            app->popup, "Magic keys detected\nWriting...", 64, 24, AlignCenter, AlignTop);
+        writer_report_stage(ctx, WriterStageMagicKeys);
     } else {
         FURI_LOG_I(TAG, "Mi Band has original keys - rewrite scenario");
-        popup_set_text(
-            app->popup, "Original keys detected\nRewriting...", 64, 24, AlignCenter, AlignTop);
+        writer_report_stage(ctx, WriterStageOriginalKeys);
     }
 
-    furi_delay_ms(500);
-
     // 3. Write all sectors
-    for(size_t sector = 0; sector < total_sectors && !should_break; sector++) {
+    MiBandSectorIter iter;
+    miband_sector_iter_init(&iter, app->mf_classic_data->type);
+    while(!should_break && miband_sector_iter_next(&iter)) {
+        size_t sector = iter.sector;
+        if(writer_abort_requested(ctx)) {
+            write_success = false;
+            break;
+        }
+
         FURI_LOG_I(TAG, "Processing sector %zu...", sector);
 
         // Update progress display
-        furi_string_reset(progress_msg);
-        furi_string_printf(progress_msg, "Sector %zu/%zu\n\n", sector + 1, total_sectors);
-
-        uint32_t progress_percent = total_sectors > 0 ? ((sector + 1) * 100) / total_sectors : 0;
+        writer_report_stage(ctx, WriterStageWriting);
+        progress_tracker_update(app->progress, sector);
 
-        furi_string_cat_str(progress_msg, "[");
-        for(uint8_t i = 0; i < 20; i++) {
-            if(i < (progress_percent / 5)) {
-                furi_string_cat_str(progress_msg, "=");
-            } else if(i == (progress_percent / 5)) {
-                furi_string_cat_str(progress_msg, ">");
-            } else {
-                furi_string_cat_str(progress_msg, " ");
-            }
+        if(miband_write_checkpoint_is_committed(&app->write_checkpoint, sector)) {
+            FURI_LOG_I(TAG, "Sector %zu: committed by the interrupted write, skipped", sector);
+            continue;
         }
-        furi_string_cat_printf(progress_msg, "]\n%lu%%", progress_percent);
-
-        popup_set_text(
-            app->popup, furi_string_get_cstr(progress_msg), 64, 18, AlignCenter, AlignTop);
-        furi_delay_ms(50);
 
-        uint8_t first_block = mf_classic_get_first_block_num_of_sector(sector);
-        uint8_t blocks_in_sector = mf_classic_get_blocks_num_in_sector(sector);
+        uint8_t first_block = iter.first_block;
+        uint8_t blocks_in_sector = iter.blocks_in_sector;
         bool sector_written = false;
 
+        uint16_t write_mask = writer_sector_write_mask(ctx, sector);
+        if(write_mask == 0) {
+            FURI_LOG_I(TAG, "Sector %zu: unchanged, skipped", sector);
+            writer_checkpoint_sector(app, sector);
+            continue;
+        }
+
         MfClassicSectorTrailer* sec_tr =
             mf_classic_get_sector_trailer_by_sector(app->mf_classic_data, sector);
 
@@ -233,55 +724,48 @@ static bool miband_write_with_sync_approach(MiBandNfcApp* app) {
             bool block0_read = false;
             MfClassicKey auth_key_uid = {0};
 
+            // Try the cached key first
+            MfClassicKeyType cached_key_type;
+            if(miband_auth_cache_get(app->auth_cache, 0, &auth_key, &cached_key_type) &&
+               writer_read_block0(ctx, &auth_key, cached_key_type, &current_block0) ==
+                   MfClassicErrorNone) {
+                block0_read = true;
+                auth_key_type = cached_key_type;
+                FURI_LOG_I(TAG, "Block 0 read with cached key");
+            }
+
             // Try to read current Block 0 with 0xFF keys
             memset(auth_key_uid.data, 0xFF, sizeof(auth_key_uid.data));
-            error = mf_classic_poller_sync_auth(
-                app->nfc, 0, &auth_key_uid, MfClassicKeyTypeA, &auth_context);
-
-            if(error == MfClassicErrorNone) {
-                error = mf_classic_poller_sync_read_block(
-                    app->nfc, 0, &auth_key_uid, MfClassicKeyTypeA, &current_block0);
-                if(error == MfClassicErrorNone) {
-                    block0_read = true;
-                    auth_key_type = MfClassicKeyTypeA;
-                    memcpy(&auth_key, &auth_key_uid, sizeof(MfClassicKey));
-                    FURI_LOG_I(TAG, "Block 0 read with 0xFF keys");
-                }
+            if(!block0_read && !writer_abort_requested(ctx) &&
+               writer_read_block0(ctx, &auth_key_uid, MfClassicKeyTypeA, &current_block0) ==
+                   MfClassicErrorNone) {
+                block0_read = true;
+                auth_key_type = MfClassicKeyTypeA;
+                memcpy(&auth_key, &auth_key_uid, sizeof(MfClassicKey));
+                FURI_LOG_I(TAG, "Block 0 read with 0xFF keys");
             }
 
             // If 0xFF fails, try with dump Key A
-            if(!block0_read &&
+            if(!block0_read && !writer_abort_requested(ctx) &&
                mf_classic_is_key_found(app->mf_classic_data, 0, MfClassicKeyTypeA)) {
                 memcpy(auth_key.data, sec_tr->key_a.data, sizeof(auth_key.data));
-                error = mf_classic_poller_sync_auth(
-                    app->nfc, 0, &auth_key, MfClassicKeyTypeA, &auth_context);
-
-                if(error == MfClassicErrorNone) {
-                    error = mf_classic_poller_sync_read_block(
-                        app->nfc, 0, &auth_key, MfClassicKeyTypeA, &current_block0);
-                    if(error == MfClassicErrorNone) {
-                        block0_read = true;
-                        auth_key_type = MfClassicKeyTypeA;
-                        FURI_LOG_I(TAG, "Block 0 read with dump Key A");
-                    }
+                if(writer_read_block0(ctx, &auth_key, MfClassicKeyTypeA, &current_block0) ==
+                   MfClassicErrorNone) {
+                    block0_read = true;
+                    auth_key_type = MfClassicKeyTypeA;
+                    FURI_LOG_I(TAG, "Block 0 read with dump Key A");
                 }
             }
 
             // If Key A fails, try with dump Key B
-            if(!block0_read &&
+            if(!block0_read && !writer_abort_requested(ctx) &&
                mf_classic_is_key_found(app->mf_classic_data, 0, MfClassicKeyTypeB)) {
                 memcpy(auth_key.data, sec_tr->key_b.data, sizeof(auth_key.data));
-                error = mf_classic_poller_sync_auth(
-                    app->nfc, 0, &auth_key, MfClassicKeyTypeB, &auth_context);
-
-                if(error == MfClassicErrorNone) {
-                    error = mf_classic_poller_sync_read_block(
-                        app->nfc, 0, &auth_key, MfClassicKeyTypeB, &current_block0);
-                    if(error == MfClassicErrorNone) {
-                        block0_read = true;
-                        auth_key_type = MfClassicKeyTypeB;
-                        FURI_LOG_I(TAG, "Block 0 read with dump Key B");
-                    }
+                if(writer_read_block0(ctx, &auth_key, MfClassicKeyTypeB, &current_block0) ==
+                   MfClassicErrorNone) {
+                    block0_read = true;
+                    auth_key_type = MfClassicKeyTypeB;
+                    FURI_LOG_I(TAG, "Block 0 read with dump Key B");
                 }
             }
 
@@ -300,15 +784,34 @@ static bool miband_write_with_sync_approach(MiBandNfcApp* app) {
                 current_block0.data[2],
                 current_block0.data[3]);
 
-            // Write data blocks 1 and 2 of sector 0 (skip trailer block 3)
+            // Fast path: the rest of the sector in one auth session, Block 0 untouched.
+            // Blocks that need no write count as done.
+            bool authenticated;
+            uint16_t written_mask =
+                writer_session_write(
+                    ctx, sector, write_mask, &auth_key, auth_key_type, &authenticated) |
+                ~write_mask;
+
+            // Write the remaining data blocks of sector 0 (skip the trailer)
             for(uint8_t block_in_sector = 1; block_in_sector < (blocks_in_sector - 1);
                 block_in_sector++) {
                 size_t block_idx = first_block + block_in_sector;
 
+                if(written_mask & (1U << block_in_sector)) continue;
+                if(writer_abort_requested(ctx)) {
+                    write_success = false;
+                    break;
+                }
+
                 // Re-authenticate if needed
                 if(block_in_sector > 1) {
-                    error = mf_classic_poller_sync_auth(
-                        app->nfc, first_block, &auth_key, auth_key_type, &auth_context);
+                    error = miband_auth_cache_auth(
+                        app->auth_cache,
+                        app->nfc,
+                        first_block,
+                        &auth_key,
+                        auth_key_type,
+                        &auth_context);
                     if(error != MfClassicErrorNone) {
                         FURI_LOG_E(TAG, "Re-auth failed for block %zu", block_idx);
                         write_success = false;
@@ -316,25 +819,9 @@ static bool miband_write_with_sync_approach(MiBandNfcApp* app) {
                     }
                 }
 
-                // Write block with retry
-                bool block_written = false;
-                for(int retry = 0; retry < 3 && !block_written; retry++) {
-                    if(retry > 0) furi_delay_ms(100);
-
-                    error = mf_classic_poller_sync_write_block(
-                        app->nfc,
-                        block_idx,
-                        &auth_key,
-                        auth_key_type,
-                        &app->mf_classic_data->block[block_idx]);
-
-                    if(error == MfClassicErrorNone) {
-                        block_written = true;
-                        FURI_LOG_D(TAG, "Sector 0 Block %zu written (retry %d)", block_idx, retry);
-                    } else if(error != MfClassicErrorTimeout) {
-                        break;
-                    }
-                }
+                // Write block, retrying timeouts per pipeline profile
+                bool block_written =
+                    writer_write_data_block(ctx, block_idx, &auth_key, auth_key_type);
 
                 if(!block_written) {
                     FURI_LOG_E(TAG, "Failed to write sector 0 block %zu", block_idx);
@@ -343,34 +830,23 @@ static bool miband_write_with_sync_approach(MiBandNfcApp* app) {
                 }
             }
 
-            // Write sector 0 trailer (block 3)
+            // Write sector 0 trailer
             if(write_success) {
-                size_t trailer_idx = first_block + blocks_in_sector - 1;
+                size_t trailer_idx = iter.trailer_block;
                 FURI_LOG_D(TAG, "Writing sector 0 trailer block %zu", trailer_idx);
 
-                bool trailer_written = false;
-                for(int retry = 0; retry < 3 && !trailer_written; retry++) {
-                    if(retry > 0) {
-                        furi_delay_ms(100);
-                        error = mf_classic_poller_sync_auth(
-                            app->nfc, first_block, &auth_key, auth_key_type, &auth_context);
-                        if(error != MfClassicErrorNone) break;
-                    }
+                bool trailer_written = (written_mask & (1U << (blocks_in_sector - 1))) != 0;
 
-                    error = mf_classic_poller_sync_write_block(
-                        app->nfc,
-                        trailer_idx,
-                        &auth_key,
-                        auth_key_type,
-                        &app->mf_classic_data->block[trailer_idx]);
+                if(!trailer_written && !writer_abort_requested(ctx)) {
+                    error = writer_write_block_with_retry(
+                        ctx, trailer_idx, &auth_key, auth_key_type);
+                    trailer_written = error == MfClassicErrorNone;
+                }
 
-                    if(error == MfClassicErrorNone) {
-                        trailer_written = true;
-                        sector_written = true;
-                        FURI_LOG_I(TAG, "Sector 0 trailer written (retry %d)", retry);
-                    } else if(error != MfClassicErrorTimeout) {
-                        break;
-                    }
+                if(trailer_written) {
+                    sector_written = true;
+                    writer_commit_sector(app, sector, trailer_idx);
+                    FURI_LOG_I(TAG, "Sector 0 trailer written");
                 }
 
                 if(!trailer_written) {
@@ -382,7 +858,7 @@ static bool miband_write_with_sync_approach(MiBandNfcApp* app) {
             continue; // Skip to next sector
         }
 
-        // 3.2 Handle sectors 1-15
+        // 3.2 Handle the other sectors
         FURI_LOG_D(
             TAG,
             "Sector %zu: first_block=%d, blocks_in_sector=%d",
@@ -395,107 +871,119 @@ static bool miband_write_with_sync_approach(MiBandNfcApp* app) {
         // 2. If card has original keys -> use dump keys
         // 3. Fallback to 0xFF if everything fails
 
+        // Each option opens the sector's write session with its key: the
+        // session auth is the key test, a rejected key moves to the next one.
+
+        // OPTION 0: Try the key that last worked on this sector
+        MfClassicKeyType cached_key_type;
+        if(miband_auth_cache_get(app->auth_cache, sector, &auth_key, &cached_key_type)) {
+            sector_written = write_sector_blocks(
+                ctx,
+                sector,
+                first_block,
+                blocks_in_sector,
+                write_mask,
+                &auth_key,
+                cached_key_type);
+
+            if(sector_written) {
+                FURI_LOG_I(TAG, "Sector %zu written with cached key", sector);
+                continue;
+            }
+        }
+
         // OPTION 1: Try with magic keys (0xFF) if detected
-        if(has_magic_keys) {
+        if(has_magic_keys && !sector_written && !writer_abort_requested(ctx)) {
             FURI_LOG_I(TAG, "Sector %zu: Trying 0xFF keys (magic card)", sector);
 
             memset(auth_key.data, 0xFF, sizeof(auth_key.data));
-            error = mf_classic_poller_sync_auth(
-                app->nfc, first_block, &auth_key, MfClassicKeyTypeA, &auth_context);
-
-            if(error == MfClassicErrorNone) {
-                FURI_LOG_I(TAG, "Sector %zu: Auth with 0xFF successful", sector);
-                sector_written = write_sector_blocks(
-                    app, sector, first_block, blocks_in_sector, &auth_key, MfClassicKeyTypeA);
-
-                if(sector_written) {
-                    FURI_LOG_I(TAG, "Sector %zu written with 0xFF keys", sector);
-                    continue; // Move to next sector
-                }
-            } else {
-                FURI_LOG_W(TAG, "Sector %zu: Auth with 0xFF failed: %d", sector, error);
+            sector_written = write_sector_blocks(
+                ctx,
+                sector,
+                first_block,
+                blocks_in_sector,
+                write_mask,
+                &auth_key,
+                MfClassicKeyTypeA);
+
+            if(sector_written) {
+                FURI_LOG_I(TAG, "Sector %zu written with 0xFF keys", sector);
+                continue; // Move to next sector
             }
+            FURI_LOG_W(TAG, "Sector %zu: 0xFF keys failed", sector);
         }
 
         // OPTION 2: Try with dump keys (for rewrites)
-        if(!sector_written) {
+        if(!sector_written && !writer_abort_requested(ctx)) {
             FURI_LOG_I(TAG, "Sector %zu: Trying dump keys", sector);
 
             // Try Key A from dump
             if(mf_classic_is_key_found(app->mf_classic_data, sector, MfClassicKeyTypeA)) {
                 memcpy(auth_key.data, sec_tr->key_a.data, sizeof(auth_key.data));
                 auth_key_type = MfClassicKeyTypeA;
-
-                for(int retry = 0; retry < 2 && !sector_written; retry++) {
-                    if(retry > 0) {
-                        FURI_LOG_D(TAG, "Retry %d with dump Key A", retry);
-                        furi_delay_ms(200);
-                    }
-
-                    error = mf_classic_poller_sync_auth(
-                        app->nfc, first_block, &auth_key, auth_key_type, &auth_context);
-
-                    if(error == MfClassicErrorNone) {
-                        FURI_LOG_I(TAG, "Sector %zu: Auth with dump Key A", sector);
-                        sector_written = write_sector_blocks(
-                            app, sector, first_block, blocks_in_sector, &auth_key, auth_key_type);
-                        break;
-                    }
-                }
+                sector_written = write_sector_blocks(
+                    ctx,
+                    sector,
+                    first_block,
+                    blocks_in_sector,
+                    write_mask,
+                    &auth_key,
+                    auth_key_type);
+                if(sector_written) FURI_LOG_I(TAG, "Sector %zu written with dump Key A", sector);
             }
 
             // Try Key B from dump
-            if(!sector_written &&
+            if(!sector_written && !writer_abort_requested(ctx) &&
                mf_classic_is_key_found(app->mf_classic_data, sector, MfClassicKeyTypeB)) {
                 memcpy(auth_key.data, sec_tr->key_b.data, sizeof(auth_key.data));
                 auth_key_type = MfClassicKeyTypeB;
-
-                for(int retry = 0; retry < 2 && !sector_written; retry++) {
-                    if(retry > 0) {
-                        FURI_LOG_D(TAG, "Retry %d with dump Key B", retry);
-                        furi_delay_ms(200);
-                    }
-
-                    error = mf_classic_poller_sync_auth(
-                        app->nfc, first_block, &auth_key, auth_key_type, &auth_context);
-
-                    if(error == MfClassicErrorNone) {
-                        FURI_LOG_I(TAG, "Sector %zu: Auth with dump Key B", sector);
-                        sector_written = write_sector_blocks(
-                            app, sector, first_block, blocks_in_sector, &auth_key, auth_key_type);
-                        break;
-                    }
-                }
+                sector_written = write_sector_blocks(
+                    ctx,
+                    sector,
+                    first_block,
+                    blocks_in_sector,
+                    write_mask,
+                    &auth_key,
+                    auth_key_type);
+                if(sector_written) FURI_LOG_I(TAG, "Sector %zu written with dump Key B", sector);
             }
         }
 
         // OPTION 3: Last resort - try 0xFF even if not detected as magic
-        if(!sector_written && !has_magic_keys) {
+        if(!sector_written && !has_magic_keys && !writer_abort_requested(ctx)) {
             FURI_LOG_W(TAG, "Sector %zu: Last resort - trying 0xFF keys", sector);
 
             memset(auth_key.data, 0xFF, sizeof(auth_key.data));
             auth_key_type = MfClassicKeyTypeA;
-
-            error = mf_classic_poller_sync_auth(
-                app->nfc, first_block, &auth_key, auth_key_type, &auth_context);
-
-            if(error == MfClassicErrorNone) {
-                FURI_LOG_I(TAG, "Sector %zu: Auth with 0xFF (last resort)", sector);
-                sector_written = write_sector_blocks(
-                    app, sector, first_block, blocks_in_sector, &auth_key, auth_key_type);
+            sector_written = write_sector_blocks(
+                ctx,
+                sector,
+                first_block,
+                blocks_in_sector,
+                write_mask,
+                &auth_key,
+                auth_key_type);
+            if(sector_written) {
+                FURI_LOG_I(TAG, "Sector %zu written with 0xFF (last resort)", sector);
             }
         }
 
+        if(!sector_written && (ctx->abort_requested || ctx->verify_failed)) {
+            write_success = false;
+            break;
+        }
+
         // Check if sector was written successfully
         if(!sector_written) {
             FURI_LOG_E(TAG, "Sector %zu: ALL authentication methods FAILED", sector);
-            if(app->logger) {
-                miband_logger_log(
-                    app->logger,
-                    LogLevelError,
-                    "Failed to write sector %zu - all auth methods failed",
-                    sector);
-            }
+            miband_logger_event(
+                app->logger,
+                LogLevelError,
+                MiBandLogEventWriteFailed,
+                sector,
+                MIBAND_LOG_NONE,
+                MIBAND_LOG_NONE,
+                MfClassicErrorAuth);
 
             // Special debug for sector 1 (blocks 4-7)
             if(sector == 1) {
@@ -518,11 +1006,56 @@ static bool miband_write_with_sync_approach(MiBandNfcApp* app) {
         }
     }
 
-    // Cleanup
-    furi_string_free(progress_msg);
+    // The band no longer matches the snapshot
+    app->target_snapshot_valid = false;
+
+    // A complete write leaves nothing to resume. Sectors are stored as they commit,
+    // this last save only drops the file or a checkpoint of another band.
+    if(write_success) {
+        miband_write_checkpoint_clear(&app->write_checkpoint);
+    }
+    if(app->write_checkpoint_file) {
+        miband_write_checkpoint_save(&app->write_checkpoint, app->storage);
+    }
+
+    // On success the band now carries the dump keys; after a partial write nobody knows
+    if(write_success) {
+        const MfClassicSectorTrailer* trailer =
+            mf_classic_get_sector_trailer_by_sector(app->mf_classic_data, 1);
+        miband_card_session_set_key_state(
+            app->card_session, miband_card_session_classify_key(&trailer->key_a));
+    } else {
+        miband_card_session_set_key_state(app->card_session, MiBandCardKeysUnknown);
+    }
+
+    if(app->logger && ctx->delta) {
+        miband_logger_log(
+            app->logger,
+            LogLevelInfo,
+            "Delta write: %lu unchanged blocks skipped",
+            ctx->blocks_skipped);
+    }
+
+    if(app->logger && ctx->verify) {
+        miband_logger_log(
+            app->logger,
+            LogLevelInfo,
+            "Write+verify: %lu blocks rewritten after mismatch",
+            ctx->blocks_rewritten);
+    }
+
+    if(app->logger) {
+        miband_logger_log(
+            app->logger,
+            LogLevelInfo,
+            "Write: %lu auth attempts, %lu failed",
+            miband_auth_cache_get_attempts(app->auth_cache),
+            miband_auth_cache_get_failures(app->auth_cache));
+    }
 
     // Final result
     if(write_success) {
+        progress_tracker_update(app->progress, total_sectors);
         FURI_LOG_I(TAG, "Write operation COMPLETED SUCCESSFULLY");
         if(app->logger) {
             miband_logger_log(app->logger, LogLevelInfo, "Write operation completed successfully");
@@ -537,6 +1070,289 @@ static bool miband_write_with_sync_approach(MiBandNfcApp* app) {
     return write_success;
 }
 
+/**
+ * @brief Block until the band leaves the field (batch mode)
+ *
+ * @param ctx Writer worker context
+ * @return true if the band was removed, false if aborted
+ */
+static bool writer_wait_for_removal(WriterContext* ctx) {
+    Iso14443_3aData iso_data;
+    uint8_t misses = 0;
+
+    while(misses < WRITER_BATCH_REMOVAL_MISSES) {
+        if(ctx->abort_requested) return false;
+
+        if(miband_card_io_activate(ctx->app->nfc, &iso_data) == Iso14443_3aErrorNone) {
+            misses = 0;
+        } else {
+            misses++;
+        }
+        furi_delay_ms(WRITER_BATCH_POLL_MS);
+    }
+    return true;
+}
+
+/**
+ * @brief Writer worker thread entry point
+ * 
+ * Runs the whole sync write pipeline off the GUI thread and reports the
+ * outcome with a custom event. Nothing is reported after an abort, since
+ * the scene is already leaving. In batch mode the worker then stays alive
+ * until the band is removed.
+ * 
+ * @param context Pointer to WriterContext
+ * @return 0 on success, -1 on failure
+ */
+static int32_t writer_worker_thread(void* context) {
+    WriterContext* ctx = context;
+
+    FURI_LOG_I(TAG, "Writer worker started");
+    miband_op_stats_begin(&ctx->app->op_stats, "Write");
+    ctx->write_result = miband_write_with_sync_approach(ctx);
+    miband_op_stats_end(ctx->app->logger);
+    FURI_LOG_I(TAG, "Writer worker done: %s", ctx->write_result ? "OK" : "FAIL");
+
+    if(!ctx->abort_requested) {
+        view_dispatcher_send_custom_event(
+            ctx->app->view_dispatcher,
+            ctx->write_result ? MiBandNfcCustomEventWriterSuccess :
+                                MiBandNfcCustomEventWriterFailed);
+    }
+
+    if(ctx->batch && writer_wait_for_removal(ctx)) {
+        view_dispatcher_send_custom_event(
+            ctx->app->view_dispatcher, MiBandNfcCustomEventBatchCardRemoved);
+    }
+
+    return ctx->write_result ? 0 : -1;
+}
+
+/**
+ * @brief Allocate the writer context and start the worker thread
+ * 
+ * @param app Pointer to MiBandNfcApp instance
+ * @return true if the worker was started
+ */
+static bool writer_worker_start(MiBandNfcApp* app) {
+    WriterContext* ctx = malloc(sizeof(WriterContext));
+    if(!ctx) return false;
+
+    memset(ctx, 0, sizeof(WriterContext));
+    ctx->app = app;
+    ctx->stage = WriterStageDetecting;
+    ctx->verify = miband_nfc_get_profile(app)->fused_verify;
+    ctx->batch = app->current_operation == OperationTypeBatchWrite;
+    app->writer_context = ctx;
+
+    ctx->thread = furi_thread_alloc_ex(
+        "MiBandWriterWorker", WRITER_WORKER_STACK_SIZE, writer_worker_thread, ctx);
+    furi_thread_start(ctx->thread);
+    return true;
+}
+
+/**
+ * @brief Abort (if still running), join and free the writer worker
+ * 
+ * The worker checks the abort flag before every block operation, so the
+ * join returns within one RF round-trip.
+ * 
+ * @param app Pointer to MiBandNfcApp instance
+ */
+static void writer_worker_stop(MiBandNfcApp* app) {
+    WriterContext* ctx = app->writer_context;
+    if(!ctx) return;
+
+    if(ctx->thread) {
+        ctx->abort_requested = true;
+        furi_thread_join(ctx->thread);
+        furi_thread_free(ctx->thread);
+        ctx->thread = NULL;
+    }
+
+    free(ctx);
+    app->writer_context = NULL;
+}
+
+static void writer_popup_timeout_callback(void* context) {
+    MiBandNfcApp* app = context;
+    view_dispatcher_send_custom_event(app->view_dispatcher, MiBandNfcCustomEventPopupDone);
+}
+
+/**
+ * @brief Collect the backup the backup scene queued before this write
+ * 
+ * By the time a write is over the save has long finished, so the wait is a
+ * join on a stopped thread.
+ * 
+ * @param app Pointer to MiBandNfcApp instance
+ * @return false if a queued backup could not be saved
+ */
+static bool writer_collect_backup(MiBandNfcApp* app) {
+    MiBandBackupSaveResult result = miband_backup_saver_wait(app->backup_saver);
+    if(result == MiBandBackupSaveNone) return true;
+
+    const char* path = miband_backup_saver_get_path(app->backup_saver);
+    if(app->logger) {
+        if(result == MiBandBackupSaveOk) {
+            miband_logger_log(app->logger, LogLevelInfo, "Backup saved: %s", path);
+        } else {
+            miband_logger_log(app->logger, LogLevelError, "Failed to save backup: %s", path);
+        }
+    }
+    return result == MiBandBackupSaveOk;
+}
+
+/**
+ * @brief Show the final write result
+ * 
+ * The popup dismisses itself through a timeout callback instead of blocking
+ * the GUI thread; MiBandNfcCustomEventPopupDone then picks the next scene.
+ * 
+ * The popup text is copied into temp_text_buffer: the worker context it
+ * comes from is freed before the popup goes away.
+ * 
+ * @param app Pointer to MiBandNfcApp instance
+ * @param ctx Finished writer worker context (NULL if the worker never started)
+ * @param success Write outcome
+ */
+static void writer_show_result(MiBandNfcApp* app, WriterContext* ctx, bool success) {
+    bool backup_saved = writer_collect_backup(app);
+    popup_reset(app->popup);
+    view_dispatcher_switch_to_view(app->view_dispatcher, MiBandNfcViewIdWriter);
+
+    if(success) {
+        scene_manager_set_scene_state(
+            app->scene_manager, MiBandNfcSceneWriter, MiBandNfcSceneWriterStateSuccess);
+        if(app->logger) {
+            miband_logger_log(
+                app->logger,
+                LogLevelInfo,
+                "Write successful for: %s",
+                furi_string_get_cstr(app->file_path));
+        }
+        notification_message(app->notifications, &sequence_success);
+        popup_set_header(app->popup, "Write Success!", 64, 4, AlignCenter, AlignTop);
+        furi_string_set_str(
+            app->temp_text_buffer,
+            ctx && ctx->verify ? "Data written\nand verified" : "Data written\nsuccessfully");
+        if(ctx && ctx->delta) {
+            furi_string_cat_printf(
+                app->temp_text_buffer, "\n%lu blocks unchanged", ctx->blocks_skipped);
+        }
+        if(!backup_saved) furi_string_cat_str(app->temp_text_buffer, "\nBackup NOT saved!");
+        popup_set_text(
+            app->popup,
+            furi_string_get_cstr(app->temp_text_buffer),
+            64,
+            20,
+            AlignCenter,
+            AlignTop);
+        popup_set_icon(app->popup, 32, 24, &I_DolphinSuccess_91x55);
+        popup_set_timeout(app->popup, WRITER_SUCCESS_POPUP_MS);
+    } else {
+        scene_manager_set_scene_state(
+            app->scene_manager, MiBandNfcSceneWriter, MiBandNfcSceneWriterStateFailed);
+        if(app->logger) {
+            miband_logger_log(
+                app->logger,
+                LogLevelError,
+                "Write failed for: %s",
+                furi_string_get_cstr(app->file_path));
+        }
+        notification_message(app->notifications, &sequence_error);
+        // The failure text already fills the popup, the header carries the backup outcome
+        popup_set_header(
+            app->popup,
+            backup_saved ? "Write Failed" : "Write + Backup Failed",
+            64,
+            4,
+            AlignCenter,
+            AlignTop);
+        furi_string_set_str(
+            app->temp_text_buffer,
+            ctx && ctx->failure_text ? ctx->failure_text :
+                                       "Could not write\ndata to Mi Band\n\nCheck position");
+        popup_set_text(
+            app->popup,
+            furi_string_get_cstr(app->temp_text_buffer),
+            64,
+            20,
+            AlignCenter,
+            AlignTop);
+        popup_set_icon(app->popup, 40, 28, &I_WarningDolphinFlip_45x42);
+        popup_set_timeout(app->popup, WRITER_FAILURE_POPUP_MS);
+        FURI_LOG_E(TAG, "Write failed");
+    }
+
+    notification_message(app->notifications, &sequence_blink_stop);
+    popup_set_context(app->popup, app);
+    popup_set_callback(app->popup, writer_popup_timeout_callback);
+    popup_enable_timeout(app->popup);
+}
+
+/**
+ * @brief Show the result of one band in batch mode and count it
+ *
+ * The popup stays up until the band is removed, then the scanner restarts.
+ * Throughput is measured from the first band detected.
+ *
+ * @param app Pointer to MiBandNfcApp instance
+ * @param ctx Finished writer worker context
+ * @param success Write outcome for this band
+ */
+static void writer_show_batch_result(MiBandNfcApp* app, WriterContext* ctx, bool success) {
+    MiBandBatchStats* batch = &app->batch;
+    if(success) {
+        batch->bands_ok++;
+    } else {
+        batch->bands_failed++;
+    }
+    uint32_t bands = batch->bands_ok + batch->bands_failed;
+
+    size_t uid_len;
+    const uint8_t* uid = miband_auth_cache_get_uid(app->auth_cache, &uid_len);
+    FuriString* uid_text = furi_string_alloc();
+    for(size_t i = 0; i < uid_len; i++) {
+        furi_string_cat_printf(uid_text, "%02X", uid[i]);
+    }
+
+    const char* outcome = success ? (ctx->verify ? "OK, verified" : "OK") : "FAILED";
+    if(app->logger) {
+        miband_logger_log(
+            app->logger,
+            success ? LogLevelInfo : LogLevelError,
+            "Batch band #%lu %s: %s",
+            bands,
+            furi_string_get_cstr(uid_text),
+            outcome);
+    }
+
+    uint32_t elapsed_ms = furi_get_tick() - batch->start_tick;
+    uint32_t rate_x10 = elapsed_ms > 0 ? (uint32_t)((uint64_t)bands * 600000 / elapsed_ms) : 0;
+
+    furi_string_printf(
+        app->temp_text_buffer,
+        "#%lu %s %s\n%lu ok / %lu failed\n%lu.%lu bands/min\n\nRemove band",
+        bands,
+        furi_string_get_cstr(uid_text),
+        outcome,
+        batch->bands_ok,
+        batch->bands_failed,
+        rate_x10 / 10,
+        rate_x10 % 10);
+    furi_string_free(uid_text);
+
+    popup_reset(app->popup);
+    view_dispatcher_switch_to_view(app->view_dispatcher, MiBandNfcViewIdWriter);
+    popup_set_header(app->popup, "Batch Write", 64, 2, AlignCenter, AlignTop);
+    popup_set_text(
+        app->popup, furi_string_get_cstr(app->temp_text_buffer), 64, 14, AlignCenter, AlignTop);
+
+    notification_message(app->notifications, &sequence_blink_stop);
+    notification_message(app->notifications, success ? &sequence_success : &sequence_error);
+}
+
 /**
  * @brief Scanner callback for card detection
  * 
@@ -578,6 +1394,24 @@ static void miband_nfc_scene_writer_scan_callback(NfcScannerEvent event, void* c
     }
 }
 
+/**
+ * @brief Start waiting for the next band
+ * 
+ * @param app Pointer to MiBandNfcApp instance
+ */
+static void writer_start_scanner(MiBandNfcApp* app) {
+    scene_manager_set_scene_state(
+        app->scene_manager, MiBandNfcSceneWriter, MiBandNfcSceneWriterStateWaiting);
+    notification_message(app->notifications, &sequence_blink_start_cyan);
+
+    app->poller = NULL;
+    app->scanner = nfc_scanner_alloc(app->nfc);
+    nfc_scanner_start(app->scanner, miband_nfc_scene_writer_scan_callback, app);
+    app->is_scan_active = true;
+
+    FURI_LOG_I(TAG, "Waiting for Mi Band to be placed...");
+}
+
 /**
  * @brief Scene entry point
  * 
@@ -602,7 +1436,10 @@ void miband_nfc_scene_writer_on_enter(void* context) {
     }
     popup_reset(app->popup);
 
-    if(app->current_operation == OperationTypeWriteOriginal) {
+    if(app->current_operation == OperationTypeBatchWrite) {
+        memset(&app->batch, 0, sizeof(MiBandBatchStats));
+        popup_set_header(app->popup, "Batch Write", 64, 4, AlignCenter, AlignTop);
+    } else if(app->current_operation == OperationTypeWriteOriginal) {
         popup_set_header(app->popup, "Write Original Data", 64, 4, AlignCenter, AlignTop);
     } else {
         popup_set_header(app->popup, "Write Data", 64, 4, AlignCenter, AlignTop);
@@ -617,20 +1454,24 @@ void miband_nfc_scene_writer_on_enter(void* context) {
         AlignTop);
 
     view_dispatcher_switch_to_view(app->view_dispatcher, MiBandNfcViewIdWriter);
-    notification_message(app->notifications, &sequence_blink_start_cyan);
 
-    app->poller = NULL;
-    app->scanner = nfc_scanner_alloc(app->nfc);
-    nfc_scanner_start(app->scanner, miband_nfc_scene_writer_scan_callback, app);
-    app->is_scan_active = true;
+    // Chained from backup/verify with the band still in place, no need to scan again
+    if(app->current_operation != OperationTypeBatchWrite &&
+       miband_card_session_is_active(app->card_session) &&
+       miband_card_session_refresh(app->card_session, app->nfc)) {
+        FURI_LOG_I(TAG, "Card session still active, skipping scan");
+        view_dispatcher_send_custom_event(
+            app->view_dispatcher, MiBandNfcCustomEventCardDetected);
+        return;
+    }
 
-    FURI_LOG_I(TAG, "Waiting for Mi Band to be placed...");
+    writer_start_scanner(app);
 }
 
 /**
  * @brief Scene event handler
  * 
- * Handles card detection and write completion events.
+ * Handles card detection, worker progress and write completion events.
  * 
  * @param context Pointer to MiBandNfcApp instance
  * @param event Scene manager event
@@ -651,11 +1492,26 @@ bool miband_nfc_scene_writer_on_event(void* context, SceneManagerEvent event) {
                 app->scanner = NULL;
             }
 
-            popup_reset(app->popup);
-            popup_set_header(app->popup, "Writing Data", 64, 4, AlignCenter, AlignTop);
+            if(app->writer_context) {
+                // Duplicate detection event, worker already running
+                consumed = true;
+                break;
+            }
+
+            scene_manager_set_scene_state(
+                app->scene_manager, MiBandNfcSceneWriter, MiBandNfcSceneWriterStateWriting);
+            if(app->current_operation == OperationTypeBatchWrite && app->batch.start_tick == 0) {
+                app->batch.start_tick = furi_get_tick();
+            }
 
-            popup_set_text(app->popup, "Starting write...", 64, 18, AlignCenter, AlignTop);
-            furi_delay_ms(500);
+            progress_tracker_reset(
+                app->progress,
+                mf_classic_get_total_sectors_num(app->mf_classic_data->type),
+                "Sector");
+            progress_tracker_set_header(app->progress, "Writing Data");
+            progress_tracker_set_status(
+                app->progress, writer_stage_status[WriterStageDetecting]);
+            view_dispatcher_switch_to_view(app->view_dispatcher, MiBandNfcViewIdProgress);
 
             if(app->logger) {
                 miband_logger_log(app->logger, LogLevelInfo, "Card detected, starting write");
@@ -665,55 +1521,50 @@ bool miband_nfc_scene_writer_on_event(void* context, SceneManagerEvent event) {
             notification_message(app->notifications, &sequence_blink_start_magenta);
 
             FURI_LOG_I(TAG, "Starting write operation");
-            bool write_result = miband_write_with_sync_approach(app);
-
-            popup_reset(app->popup);
+            if(!writer_worker_start(app)) {
+                FURI_LOG_E(TAG, "Failed to start writer worker");
+                writer_show_result(app, NULL, false);
+            }
+            consumed = true;
+            break;
 
-            if(write_result) {
-                if(app->logger) {
-                    miband_logger_log(
-                        app->logger,
-                        LogLevelInfo,
-                        "Write successful for: %s",
-                        furi_string_get_cstr(app->file_path));
-                }
-                notification_message(app->notifications, &sequence_success);
-                popup_set_header(app->popup, "Write Success!", 64, 4, AlignCenter, AlignTop);
-                popup_set_text(
-                    app->popup, "Data written\nsuccessfully", 64, 20, AlignCenter, AlignTop);
-                popup_set_icon(app->popup, 32, 24, &I_DolphinSuccess_91x55);
-                furi_delay_ms(2000);
-
-                if(app->verify_after_write) {
-                    popup_set_text(app->popup, "Auto-verifying...", 64, 20, AlignCenter, AlignTop);
-                    furi_delay_ms(500);
-                    scene_manager_next_scene(app->scene_manager, MiBandNfcSceneVerify);
-                } else {
-                    scene_manager_search_and_switch_to_another_scene(
-                        app->scene_manager, MiBandNfcSceneMainMenu);
-                }
+        case MiBandNfcCustomEventWriterSuccess:
+        case MiBandNfcCustomEventWriterFailed: {
+            bool success = event.event == MiBandNfcCustomEventWriterSuccess;
+            WriterContext* ctx = app->writer_context;
+            if(ctx && ctx->batch) {
+                // Worker keeps running until the band is removed
+                writer_show_batch_result(app, ctx, success);
             } else {
-                if(app->logger) {
-                    miband_logger_log(
-                        app->logger,
-                        LogLevelError,
-                        "Write failed for: %s",
-                        furi_string_get_cstr(app->file_path));
-                }
-                notification_message(app->notifications, &sequence_error);
-                popup_set_header(app->popup, "Write Failed", 64, 4, AlignCenter, AlignTop);
-                popup_set_text(
-                    app->popup,
-                    "Could not write\ndata to Mi Band\n\nCheck position",
-                    64,
-                    20,
-                    AlignCenter,
-                    AlignTop);
-                popup_set_icon(app->popup, 40, 28, &I_WarningDolphinFlip_45x42);
-                FURI_LOG_E(TAG, "Write failed");
+                writer_show_result(app, ctx, success);
+                writer_worker_stop(app);
             }
+            consumed = true;
+            break;
+        }
+
+        case MiBandNfcCustomEventBatchCardRemoved:
+            writer_worker_stop(app);
+            popup_reset(app->popup);
+            popup_set_header(app->popup, "Batch Write", 64, 4, AlignCenter, AlignTop);
+            furi_string_printf(
+                app->temp_text_buffer,
+                "%lu ok / %lu failed\n\nPlace next band",
+                app->batch.bands_ok,
+                app->batch.bands_failed);
+            popup_set_text(
+                app->popup,
+                furi_string_get_cstr(app->temp_text_buffer),
+                64,
+                20,
+                AlignCenter,
+                AlignTop);
+            writer_start_scanner(app);
+            consumed = true;
+            break;
 
-            furi_delay_ms(3000);
+        case MiBandNfcCustomEventPopupDone:
+            // Verify after write already ran sector by sector during the write
             scene_manager_search_and_switch_to_another_scene(
                 app->scene_manager, MiBandNfcSceneMainMenu);
             consumed = true;
@@ -751,6 +1602,21 @@ bool miband_nfc_scene_writer_on_event(void* context, SceneManagerEvent event) {
             break;
         }
     } else if(event.type == SceneManagerEventTypeBack) {
+        if(app->writer_context) {
+            FURI_LOG_W(TAG, "Back pressed, aborting write");
+            if(app->logger) {
+                miband_logger_log(app->logger, LogLevelWarning, "Write aborted by user");
+            }
+            writer_worker_stop(app);
+        }
+        if(app->current_operation == OperationTypeBatchWrite && app->logger) {
+            miband_logger_log(
+                app->logger,
+                LogLevelInfo,
+                "Batch finished: %lu ok, %lu failed",
+                app->batch.bands_ok,
+                app->batch.bands_failed);
+        }
         scene_manager_search_and_switch_to_another_scene(
             app->scene_manager, MiBandNfcSceneMainMenu);
         consumed = true;
@@ -761,7 +1627,7 @@ bool miband_nfc_scene_writer_on_event(void* context, SceneManagerEvent event) {
 /**
  * @brief Scene exit handler
  * 
- * Stops scanner if active and cleans up resources.
+ * Stops the worker and scanner if active and cleans up resources.
  * 
  * @param context Pointer to MiBandNfcApp instance
  */
@@ -769,6 +1635,9 @@ void miband_nfc_scene_writer_on_exit(void* context) {
     furi_assert(context);
     MiBandNfcApp* app = context;
 
+    writer_worker_stop(app);
+    writer_collect_backup(app);
+
     // Aggiungere:
     if(app->poller) {
         nfc_poller_stop(app->poller);
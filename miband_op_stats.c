@@ -0,0 +1,213 @@
+/**
+ * @file miband_op_stats.c
+ * @brief Per-phase timing implementation
+ */
+
+#include "miband_op_stats.h"
+#include "miband_card_io.h"
+
+#define TAG "MiBandOpStats"
+
+// The summary is logged in one burst, the text queue must hold all of it
+_Static_assert(
+    1 + MiBandOpPhaseCount + MIBAND_OP_STATS_ERRORS <= MAX_LOG_TEXTS,
+    "Op stats summary overflows the log text queue");
+
+static MiBandOpStats* active_stats = NULL;
+
+static const char* const phase_names[MiBandOpPhaseCount] = {
+    [MiBandOpPhaseDetect] = "Detect",
+    [MiBandOpPhaseAuth] = "Auth",
+    [MiBandOpPhaseBlockRead] = "Read",
+    [MiBandOpPhaseBlockWrite] = "Write",
+    [MiBandOpPhaseSession] = "Session",
+};
+
+static const char* const bucket_names[MIBAND_OP_STATS_BUCKETS] = {
+    "<1",
+    "<2",
+    "<4",
+    "<8",
+    "<16",
+    "<32",
+    "<64",
+    "64+",
+};
+
+static uint8_t miband_op_stats_bucket(uint32_t ms) {
+    uint8_t bucket = 0;
+    while(ms > 0 && bucket < MIBAND_OP_STATS_BUCKETS - 1) {
+        ms >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+static uint32_t miband_op_stats_avg(const MiBandOpPhaseStats* phase) {
+    return phase->count ? phase->total_ms / phase->count : 0;
+}
+
+void miband_op_stats_begin(MiBandOpStats* stats, const char* operation) {
+    furi_assert(stats);
+
+    memset(stats, 0, sizeof(MiBandOpStats));
+    stats->operation = operation;
+    stats->start_tick = furi_get_tick();
+    active_stats = stats;
+}
+
+void miband_op_stats_end(MiBandLogger* logger) {
+    MiBandOpStats* stats = active_stats;
+    if(!stats) return;
+
+    active_stats = NULL;
+    stats->duration_ms = furi_get_tick() - stats->start_tick;
+
+    FURI_LOG_I(
+        TAG,
+        "%s: %lu ms, %lu ms delays",
+        stats->operation,
+        stats->duration_ms,
+        stats->delay_ms);
+    if(!logger) return;
+
+    miband_logger_log(
+        logger,
+        LogLevelInfo,
+        "%s stats: %lu ms, %lu ms in %lu delays",
+        stats->operation,
+        stats->duration_ms,
+        stats->delay_ms,
+        stats->delay_count);
+
+    for(size_t i = 0; i < MiBandOpPhaseCount; i++) {
+        const MiBandOpPhaseStats* phase = &stats->phases[i];
+        if(phase->count == 0) continue;
+
+        miband_logger_log(
+            logger,
+            LogLevelInfo,
+            "%s: %lu (%lu failed), avg %lu ms, max %lu ms",
+            phase_names[i],
+            phase->count,
+            phase->failures,
+            miband_op_stats_avg(phase),
+            phase->max_ms);
+    }
+
+    for(size_t i = 0; i < MIBAND_OP_STATS_ERRORS; i++) {
+        if(stats->retries[i] == 0) continue;
+        miband_logger_log(
+            logger, LogLevelInfo, "Retries after error %zu: %lu", i, stats->retries[i]);
+    }
+}
+
+uint32_t miband_op_stats_start(void) {
+    return furi_get_tick();
+}
+
+void miband_op_stats_record(MiBandOpPhase phase, uint32_t start_tick, MfClassicError error) {
+    furi_assert(phase < MiBandOpPhaseCount);
+
+    MiBandOpStats* stats = active_stats;
+    if(!stats) return;
+
+    uint32_t elapsed = furi_get_tick() - start_tick;
+    MiBandOpPhaseStats* phase_stats = &stats->phases[phase];
+
+    phase_stats->count++;
+    if(error != MfClassicErrorNone) phase_stats->failures++;
+    phase_stats->total_ms += elapsed;
+    if(elapsed > phase_stats->max_ms) phase_stats->max_ms = elapsed;
+    phase_stats->histogram[miband_op_stats_bucket(elapsed)]++;
+}
+
+MfClassicError miband_op_stats_read_block(
+    Nfc* nfc,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicBlock* data) {
+    uint32_t start = miband_op_stats_start();
+    MfClassicError error = miband_card_io_read_block(nfc, block_num, key, key_type, data);
+    miband_op_stats_record(MiBandOpPhaseBlockRead, start, error);
+    return error;
+}
+
+MfClassicError miband_op_stats_write_block(
+    Nfc* nfc,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicBlock* data) {
+    uint32_t start = miband_op_stats_start();
+    MfClassicError error = miband_card_io_write_block(nfc, block_num, key, key_type, data);
+    miband_op_stats_record(MiBandOpPhaseBlockWrite, start, error);
+    return error;
+}
+
+void miband_op_stats_retry(MfClassicError error) {
+    MiBandOpStats* stats = active_stats;
+    if(!stats) return;
+
+    size_t index = MIN((size_t)error, (size_t)MIBAND_OP_STATS_ERRORS - 1);
+    stats->retries[index]++;
+}
+
+void miband_op_stats_delay(uint32_t ms) {
+    MiBandOpStats* stats = active_stats;
+    if(stats) {
+        stats->delay_ms += ms;
+        stats->delay_count++;
+    }
+
+    furi_delay_ms(ms);
+}
+
+void miband_op_stats_format(const MiBandOpStats* stats, FuriString* text) {
+    furi_assert(stats);
+    furi_assert(text);
+
+    if(!stats->operation) {
+        furi_string_set_str(text, "No run yet.\n\nBackup, write or verify\na band first.");
+        return;
+    }
+
+    furi_string_printf(
+        text,
+        "%s: %lu ms\nDelays: %lu ms (%lu)\n",
+        stats->operation,
+        stats->duration_ms,
+        stats->delay_ms,
+        stats->delay_count);
+
+    for(size_t i = 0; i < MiBandOpPhaseCount; i++) {
+        const MiBandOpPhaseStats* phase = &stats->phases[i];
+        if(phase->count == 0) continue;
+
+        furi_string_cat_printf(
+            text,
+            "\n%s: %lu, %lu failed\navg %lu ms, max %lu ms\n",
+            phase_names[i],
+            phase->count,
+            phase->failures,
+            miband_op_stats_avg(phase),
+            phase->max_ms);
+
+        for(size_t bucket = 0; bucket < MIBAND_OP_STATS_BUCKETS; bucket++) {
+            if(phase->histogram[bucket] == 0) continue;
+            furi_string_cat_printf(
+                text, " %s:%lu", bucket_names[bucket], phase->histogram[bucket]);
+        }
+        furi_string_cat_str(text, "\n");
+    }
+
+    bool has_retries = false;
+    for(size_t i = 0; i < MIBAND_OP_STATS_ERRORS; i++) {
+        if(stats->retries[i] == 0) continue;
+        if(!has_retries) furi_string_cat_str(text, "\nRetries by error:\n");
+        has_retries = true;
+        furi_string_cat_printf(text, " err %zu: %lu\n", i, stats->retries[i]);
+    }
+    if(!has_retries) furi_string_cat_str(text, "\nNo retries\n");
+}
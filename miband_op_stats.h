@@ -0,0 +1,132 @@
+/**
+ * @file miband_op_stats.h
+ * @brief Per-phase timing of backup, write and verify runs
+ *
+ * One run is active at a time (the app drives a single card operation), so
+ * the NFC helpers report into the active run through free functions instead
+ * of a pointer threaded through every call. Outside a run every call is a
+ * no-op.
+ *
+ * Each phase keeps a count, failures, total/max latency and a log2 latency
+ * histogram; retries are counted by error code and every sleep taken during
+ * the run is summed.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <nfc/nfc.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
+#include "miband_logger.h"
+
+#define MIBAND_OP_STATS_BUCKETS 8 // <1, <2, <4, ... <64, >=64 ms
+#define MIBAND_OP_STATS_ERRORS  8 // Retries are counted per MfClassicError
+
+/**
+ * @brief Timed phases
+ */
+typedef enum {
+    MiBandOpPhaseDetect, /**< Anticollision and type detection */
+    MiBandOpPhaseAuth, /**< One auth handshake */
+    MiBandOpPhaseBlockRead, /**< One block read */
+    MiBandOpPhaseBlockWrite, /**< One block write */
+    MiBandOpPhaseSession, /**< One multi-block sector session */
+    MiBandOpPhaseCount,
+} MiBandOpPhase;
+
+/**
+ * @brief Statistics of one phase
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t failures;
+    uint32_t total_ms;
+    uint32_t max_ms;
+    uint32_t histogram[MIBAND_OP_STATS_BUCKETS];
+} MiBandOpPhaseStats;
+
+/**
+ * @brief Statistics of one run
+ */
+typedef struct {
+    const char* operation; // NULL until the first run
+    uint32_t start_tick;
+    uint32_t duration_ms;
+    MiBandOpPhaseStats phases[MiBandOpPhaseCount];
+    uint32_t retries[MIBAND_OP_STATS_ERRORS];
+    uint32_t delay_ms; // Time spent in furi_delay_ms during the run
+    uint32_t delay_count;
+} MiBandOpStats;
+
+/**
+ * @brief Start a run, clearing the previous numbers
+ *
+ * @param stats Run statistics to fill
+ * @param operation Operation name, e.g. "Write"; must be a literal
+ */
+void miband_op_stats_begin(MiBandOpStats* stats, const char* operation);
+
+/**
+ * @brief End the active run and write its summary to the log
+ *
+ * @param logger Logger for the summary, may be NULL
+ */
+void miband_op_stats_end(MiBandLogger* logger);
+
+/**
+ * @brief Take a start timestamp for miband_op_stats_record()
+ *
+ * @return Current tick
+ */
+uint32_t miband_op_stats_start(void);
+
+/**
+ * @brief Record one timed phase of the active run
+ *
+ * @param phase Phase
+ * @param start_tick Value of miband_op_stats_start() before the call
+ * @param error Outcome of the call
+ */
+void miband_op_stats_record(MiBandOpPhase phase, uint32_t start_tick, MfClassicError error);
+
+/**
+ * @brief Timed drop-in for mf_classic_poller_sync_read_block()
+ */
+MfClassicError miband_op_stats_read_block(
+    Nfc* nfc,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicBlock* data);
+
+/**
+ * @brief Timed drop-in for mf_classic_poller_sync_write_block()
+ */
+MfClassicError miband_op_stats_write_block(
+    Nfc* nfc,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicBlock* data);
+
+/**
+ * @brief Record a retry of the active run
+ *
+ * @param error Error that caused the retry
+ */
+void miband_op_stats_retry(MfClassicError error);
+
+/**
+ * @brief furi_delay_ms() that counts towards the active run
+ *
+ * @param ms Delay in milliseconds
+ */
+void miband_op_stats_delay(uint32_t ms);
+
+/**
+ * @brief Format a run for the stats screen
+ *
+ * @param stats Run statistics
+ * @param text Output, replaced
+ */
+void miband_op_stats_format(const MiBandOpStats* stats, FuriString* text);
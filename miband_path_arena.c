@@ -0,0 +1,64 @@
+/**
+ * @file miband_path_arena.c
+ * @brief Path arena implementation
+ */
+
+#include "miband_path_arena.h"
+
+/**
+ * @brief Path arena internal structure
+ */
+struct MiBandPathArena {
+    char* buffer;
+    size_t capacity;
+    size_t used;
+    size_t count;
+};
+
+MiBandPathArena* miband_path_arena_alloc(size_t capacity) {
+    furi_assert(capacity > 0);
+
+    MiBandPathArena* arena = malloc(sizeof(MiBandPathArena));
+    arena->buffer = malloc(capacity);
+    arena->capacity = capacity;
+    miband_path_arena_reset(arena);
+    return arena;
+}
+
+void miband_path_arena_free(MiBandPathArena* arena) {
+    if(!arena) return;
+
+    free(arena->buffer);
+    free(arena);
+}
+
+void miband_path_arena_reset(MiBandPathArena* arena) {
+    furi_assert(arena);
+    arena->used = 0;
+    arena->count = 0;
+}
+
+const char* miband_path_arena_intern(MiBandPathArena* arena, const char* path) {
+    furi_assert(arena);
+    furi_assert(path);
+
+    for(size_t offset = 0; offset < arena->used;) {
+        const char* stored = &arena->buffer[offset];
+        if(strcmp(stored, path) == 0) return stored;
+        offset += strlen(stored) + 1;
+    }
+
+    size_t size = strlen(path) + 1;
+    if(arena->used + size > arena->capacity) return NULL;
+
+    char* stored = &arena->buffer[arena->used];
+    memcpy(stored, path, size);
+    arena->used += size;
+    arena->count++;
+    return stored;
+}
+
+size_t miband_path_arena_get_count(const MiBandPathArena* arena) {
+    furi_assert(arena);
+    return arena->count;
+}
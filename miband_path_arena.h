@@ -0,0 +1,56 @@
+/**
+ * @file miband_path_arena.h
+ * @brief Fixed-size arena of interned path strings
+ *
+ * Paths are copied back to back into one preallocated buffer, so a result
+ * list costs exactly the bytes of its paths and never reallocates. Adding
+ * a path that is already stored returns the existing copy.
+ */
+
+#pragma once
+
+#include <furi.h>
+
+/**
+ * @brief Path arena structure
+ */
+typedef struct MiBandPathArena MiBandPathArena;
+
+/**
+ * @brief Create a path arena
+ *
+ * @param capacity Buffer size in bytes, terminators included
+ * @return Allocated MiBandPathArena instance
+ */
+MiBandPathArena* miband_path_arena_alloc(size_t capacity);
+
+/**
+ * @brief Free path arena, invalidating every returned path
+ *
+ * @param arena Path arena instance
+ */
+void miband_path_arena_free(MiBandPathArena* arena);
+
+/**
+ * @brief Drop every stored path
+ *
+ * @param arena Path arena instance
+ */
+void miband_path_arena_reset(MiBandPathArena* arena);
+
+/**
+ * @brief Store a path
+ *
+ * @param arena Path arena instance
+ * @param path Path to store
+ * @return Stored copy, valid until reset/free, or NULL if the arena is full
+ */
+const char* miband_path_arena_intern(MiBandPathArena* arena, const char* path);
+
+/**
+ * @brief Get the number of stored paths
+ *
+ * @param arena Path arena instance
+ * @return Number of distinct paths
+ */
+size_t miband_path_arena_get_count(const MiBandPathArena* arena);
@@ -0,0 +1,94 @@
+/**
+ * @file miband_pipeline.c
+ * @brief Dump-to-band pipeline profiles implementation
+ */
+
+#include "miband_pipeline.h"
+#include "miband_uid_index.h"
+#include "progress_tracker.h"
+
+#define TAG "MiBandPipeline"
+
+#define MIBAND_PIPELINE_ATTEMPTS_MAX    8
+#define MIBAND_PIPELINE_DELAY_MAX_MS    1000
+#define MIBAND_PIPELINE_REDRAW_MIN_MS   20
+#define MIBAND_PIPELINE_REDRAW_MAX_MS   1000
+#define MIBAND_PIPELINE_UID_ENTRIES_MIN 16
+
+static const char* const miband_pipeline_profile_names[MiBandPipelineProfileCount] = {
+    [MiBandPipelineProfileFastest] = "Fastest",
+    [MiBandPipelineProfileBalanced] = "Balanced",
+    [MiBandPipelineProfileSafest] = "Safest",
+};
+
+void miband_pipeline_profile_init(MiBandPipelineProfile* profile, MiBandPipelineProfileId id) {
+    furi_assert(profile);
+
+    memset(profile, 0, sizeof(MiBandPipelineProfile));
+    profile->redraw_ms = PROGRESS_TRACKER_REDRAW_MS;
+    profile->uid_index_entries = MIBAND_UID_INDEX_ENTRIES_MAX;
+
+    switch(id) {
+    case MiBandPipelineProfileFastest:
+        profile->retry = *miband_retry_get_policy(MiBandRfProfileFast);
+        profile->skip_detection = true;
+        profile->delta_write = true; // Only while the snapshot matches the band
+        profile->redraw_ms = 250; // Fewer GUI wakeups during the write
+        break;
+    case MiBandPipelineProfileSafest:
+        profile->retry = *miband_retry_get_policy(MiBandRfProfileRobust);
+        profile->fused_verify = true;
+        profile->uid_index_entries = MIBAND_UID_INDEX_ENTRIES_MAX / 2;
+        break;
+    default:
+        profile->retry = *miband_retry_get_policy(MiBandRfProfileFast);
+        break;
+    }
+}
+
+/**
+ * @brief Read a flag loaded from a file: anything but 1 is off
+ *
+ * Clears unchanged when the stored byte is neither 0 nor 1.
+ */
+static bool miband_pipeline_flag(const bool* flag, bool* unchanged) {
+    uint8_t raw;
+    memcpy(&raw, flag, sizeof(raw));
+    if(raw > 1) *unchanged = false;
+    return raw == 1;
+}
+
+bool miband_pipeline_profile_sanitize(MiBandPipelineProfile* profile) {
+    furi_assert(profile);
+
+    MiBandPipelineProfile checked = *profile;
+    MiBandRetryPolicy* retry = &checked.retry;
+
+    retry->max_attempts = CLAMP(retry->max_attempts, MIBAND_PIPELINE_ATTEMPTS_MAX, 1);
+    retry->max_delay_ms = MIN(retry->max_delay_ms, (uint32_t)MIBAND_PIPELINE_DELAY_MAX_MS);
+    retry->base_delay_ms = MIN(retry->base_delay_ms, retry->max_delay_ms);
+    checked.redraw_ms =
+        CLAMP(checked.redraw_ms, MIBAND_PIPELINE_REDRAW_MAX_MS, MIBAND_PIPELINE_REDRAW_MIN_MS);
+    checked.uid_index_entries = CLAMP(
+        checked.uid_index_entries, MIBAND_UID_INDEX_ENTRIES_MAX, MIBAND_PIPELINE_UID_ENTRIES_MIN);
+
+    // Field by field, the struct padding holds whatever the file had
+    bool unchanged = retry->max_attempts == profile->retry.max_attempts &&
+                     retry->base_delay_ms == profile->retry.base_delay_ms &&
+                     retry->max_delay_ms == profile->retry.max_delay_ms &&
+                     checked.redraw_ms == profile->redraw_ms &&
+                     checked.uid_index_entries == profile->uid_index_entries;
+
+    checked.skip_detection = miband_pipeline_flag(&profile->skip_detection, &unchanged);
+    checked.delta_write = miband_pipeline_flag(&profile->delta_write, &unchanged);
+    checked.fused_verify = miband_pipeline_flag(&profile->fused_verify, &unchanged);
+
+    if(!unchanged) FURI_LOG_W(TAG, "Profile out of range, clamped");
+    *profile = checked;
+    return unchanged;
+}
+
+const char* miband_pipeline_get_profile_name(MiBandPipelineProfileId id) {
+    if(id >= MiBandPipelineProfileCount) id = MiBandPipelineProfileBalanced;
+    return miband_pipeline_profile_names[id];
+}
@@ -0,0 +1,66 @@
+/**
+ * @file miband_pipeline.h
+ * @brief Dump-to-band pipeline profiles
+ *
+ * A profile gathers the speed/safety trade-offs of backup, write, verify
+ * and the UID check: retry policy, pre-write magic probe, delta write,
+ * in-session read-back, progress redraw rate and UID index size. Settings
+ * keep one record per profile and the active one, so operators switch from
+ * "Fastest" for known-good magic bands to "Safest" for worn ones without a
+ * rebuild.
+ *
+ * Records are stored raw in the settings file: append new fields at the end
+ * and give them a default in miband_pipeline_profile_init(), older files
+ * then load with that default.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include "miband_retry.h"
+
+/**
+ * @brief Built-in profiles
+ */
+typedef enum {
+    MiBandPipelineProfileFastest, // Known-good magic bands: no probe, no read-back
+    MiBandPipelineProfileBalanced, // Default, full write as in earlier releases
+    MiBandPipelineProfileSafest, // Worn bands: long backoff, full write, read-back
+    MiBandPipelineProfileCount,
+} MiBandPipelineProfileId;
+
+/**
+ * @brief Tunables of one profile
+ */
+typedef struct {
+    MiBandRetryPolicy retry; /**< Timeout retries and backoff of every card operation */
+    bool skip_detection; /**< Writer assumes 0xFF keys instead of probing sector 1 */
+    bool delta_write; /**< Writer skips blocks that match a fresh snapshot of the band */
+    bool fused_verify; /**< Writer reads every data block back inside its sector session */
+    uint16_t redraw_ms; /**< Minimum interval between progress redraws */
+    uint16_t uid_index_entries; /**< UID index entries kept in RAM by Quick UID Check */
+} MiBandPipelineProfile;
+
+/**
+ * @brief Fill a profile with its built-in values
+ *
+ * @param profile Profile to fill
+ * @param id Built-in profile, out of range falls back to Balanced
+ */
+void miband_pipeline_profile_init(MiBandPipelineProfile* profile, MiBandPipelineProfileId id);
+
+/**
+ * @brief Clamp a profile loaded from a file to values the engines accept
+ *
+ * @param profile Profile to check, fixed in place
+ * @return true if nothing had to be changed
+ */
+bool miband_pipeline_profile_sanitize(MiBandPipelineProfile* profile);
+
+/**
+ * @brief Get the display name of a built-in profile
+ *
+ * @param id Built-in profile
+ * @return Static name string
+ */
+const char* miband_pipeline_get_profile_name(MiBandPipelineProfileId id);
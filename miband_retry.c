@@ -0,0 +1,62 @@
+/**
+ * @file miband_retry.c
+ * @brief Shared retry/backoff policy implementation
+ */
+
+#include "miband_retry.h"
+#include "miband_op_stats.h"
+
+static const MiBandRetryPolicy miband_retry_policies[MiBandRfProfileCount] = {
+    [MiBandRfProfileFast] =
+        {
+            .max_attempts = 2,
+            .base_delay_ms = 10,
+            .max_delay_ms = 40,
+        },
+    [MiBandRfProfileRobust] =
+        {
+            .max_attempts = 4,
+            .base_delay_ms = 25,
+            .max_delay_ms = 200,
+        },
+};
+
+static const char* const miband_retry_profile_names[MiBandRfProfileCount] = {
+    [MiBandRfProfileFast] = "Fast",
+    [MiBandRfProfileRobust] = "Robust",
+};
+
+const MiBandRetryPolicy* miband_retry_get_policy(MiBandRfProfile profile) {
+    if(profile >= MiBandRfProfileCount) profile = MiBandRfProfileFast;
+    return &miband_retry_policies[profile];
+}
+
+const char* miband_retry_get_profile_name(MiBandRfProfile profile) {
+    if(profile >= MiBandRfProfileCount) profile = MiBandRfProfileFast;
+    return miband_retry_profile_names[profile];
+}
+
+void miband_retry_init(MiBandRetry* retry, const MiBandRetryPolicy* policy) {
+    furi_assert(retry);
+    furi_assert(policy);
+
+    retry->policy = policy;
+    retry->attempt = 1;
+    retry->delay_ms = policy->base_delay_ms;
+}
+
+bool miband_retry_next(MiBandRetry* retry, MfClassicError error) {
+    if(error != MfClassicErrorTimeout) return false;
+    if(retry->attempt >= retry->policy->max_attempts) return false;
+
+    miband_op_stats_retry(error);
+    miband_op_stats_delay(retry->delay_ms);
+
+    retry->attempt++;
+    retry->delay_ms *= 2;
+    if(retry->delay_ms > retry->policy->max_delay_ms) {
+        retry->delay_ms = retry->policy->max_delay_ms;
+    }
+
+    return true;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file miband_retry.h
+ * @brief Shared retry/backoff policy for card operations
+ *
+ * Block and auth retries only wait after MfClassicErrorTimeout: any other
+ * error means the card answered and waiting will not change the outcome.
+ * The delay starts from a small base and doubles on every timeout, capped
+ * by the policy. Success paths never sleep.
+ *
+ * Each pipeline profile (miband_pipeline.h) carries its own policy, built
+ * from one of the RF profile presets below.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
+
+/**
+ * @brief Built-in retry policy presets
+ */
+typedef enum {
+    MiBandRfProfileFast, // Few retries, short backoff
+    MiBandRfProfileRobust, // More retries, longer backoff for poor coupling
+    MiBandRfProfileCount,
+} MiBandRfProfile;
+
+/**
+ * @brief Retry policy parameters
+ */
+typedef struct {
+    uint8_t max_attempts; /**< Total attempts, including the first one */
+    uint32_t base_delay_ms; /**< Delay after the first timeout */
+    uint32_t max_delay_ms; /**< Upper bound of the exponential backoff */
+} MiBandRetryPolicy;
+
+/**
+ * @brief Retry state for one operation
+ */
+typedef struct {
+    const MiBandRetryPolicy* policy;
+    uint8_t attempt;
+    uint32_t delay_ms;
+} MiBandRetry;
+
+/**
+ * @brief Get the retry policy of an RF profile
+ *
+ * @param profile RF profile
+ * @return Policy (never NULL, falls back to the Fast profile)
+ */
+const MiBandRetryPolicy* miband_retry_get_policy(MiBandRfProfile profile);
+
+/**
+ * @brief Get the display name of an RF profile
+ *
+ * @param profile RF profile
+ * @return Profile name
+ */
+const char* miband_retry_get_profile_name(MiBandRfProfile profile);
+
+/**
+ * @brief Start a new retry sequence
+ *
+ * @param retry Retry state
+ * @param policy Policy to follow
+ */
+void miband_retry_init(MiBandRetry* retry, const MiBandRetryPolicy* policy);
+
+/**
+ * @brief Decide whether a failed attempt should be retried
+ *
+ * Sleeps for the current backoff delay on timeout, then doubles it.
+ *
+ * @param retry Retry state
+ * @param error Error of the attempt that just failed
+ * @return true if the operation should be attempted again
+ */
+bool miband_retry_next(MiBandRetry* retry, MfClassicError error);
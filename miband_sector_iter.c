@@ -0,0 +1,30 @@
+/**
+ * @file miband_sector_iter.c
+ * @brief Sector/block layout walk implementation
+ */
+
+#include "miband_sector_iter.h"
+
+void miband_sector_iter_init(MiBandSectorIter* iter, MfClassicType type) {
+    furi_assert(iter);
+
+    memset(iter, 0, sizeof(MiBandSectorIter));
+    iter->total_sectors = mf_classic_get_total_sectors_num(type);
+}
+
+bool miband_sector_iter_next(MiBandSectorIter* iter) {
+    furi_assert(iter);
+
+    uint8_t sector = iter->started ? iter->sector + 1 : 0;
+    if(sector >= iter->total_sectors) return false;
+
+    iter->started = true;
+    iter->sector = sector;
+    iter->first_block = mf_classic_get_first_block_num_of_sector(sector);
+    iter->blocks_in_sector = mf_classic_get_blocks_num_in_sector(sector);
+    iter->trailer_block = iter->first_block + iter->blocks_in_sector - 1;
+    iter->full_mask = (uint16_t)((1UL << iter->blocks_in_sector) - 1);
+    iter->data_mask = iter->full_mask & ~(1U << (iter->blocks_in_sector - 1));
+    if(sector == 0) iter->data_mask &= ~1U;
+    return true;
+}
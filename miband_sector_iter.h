@@ -0,0 +1,50 @@
+/**
+ * @file miband_sector_iter.h
+ * @brief Sector/block layout walk for every MfClassic size
+ *
+ * Mini (5 sectors), 1K (16) and 4K (40, the last 8 with 16 blocks) differ
+ * only in layout; the iterator hands out each sector's first block, block
+ * count, trailer and block masks from the mf_classic_get_* tables, so
+ * backup, write, verify and the magic transform walk any size the same way.
+ *
+ *     MiBandSectorIter iter;
+ *     miband_sector_iter_init(&iter, data->type);
+ *     while(miband_sector_iter_next(&iter)) {
+ *         ... iter.sector, iter.first_block, iter.trailer_block ...
+ *     }
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
+
+/**
+ * @brief Sector iterator, fields valid after miband_sector_iter_next() returned true
+ */
+typedef struct {
+    uint8_t total_sectors;
+    uint8_t sector;
+    uint8_t first_block;
+    uint8_t blocks_in_sector;
+    uint8_t trailer_block; // Absolute block number of the sector trailer
+    uint16_t full_mask; // Every block, bit N = Nth block of the sector
+    uint16_t data_mask; // Data blocks: no trailer, no Block 0
+    bool started;
+} MiBandSectorIter;
+
+/**
+ * @brief Start a walk over all sectors of a card type
+ *
+ * @param iter Iterator to initialize
+ * @param type Card type setting the layout
+ */
+void miband_sector_iter_init(MiBandSectorIter* iter, MfClassicType type);
+
+/**
+ * @brief Advance to the next sector
+ *
+ * @param iter Iterator
+ * @return true if the iterator holds a sector, false past the last one
+ */
+bool miband_sector_iter_next(MiBandSectorIter* iter);
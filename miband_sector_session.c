@@ -0,0 +1,174 @@
+/**
+ * @file miband_sector_session.c
+ * @brief Single-auth sector read/write implementation
+ */
+
+#include "miband_sector_session.h"
+#include "miband_card_io.h"
+#include "miband_op_stats.h"
+
+#define TAG "MiBandSectorSession"
+
+/**
+ * @brief State of one session, passed to the session callback
+ */
+typedef struct {
+    const MiBandSectorSessionRequest* request;
+    MiBandSectorSessionResult* result;
+} MiBandSectorSessionContext;
+
+/**
+ * @brief Read a just written data block back and rewrite it on mismatch
+ *
+ * Trailers are never read back: keys are not readable.
+ */
+static MfClassicError miband_sector_session_verify_block(
+    const MiBandCardIoSessionApi* api,
+    void* session,
+    const MiBandSectorSessionRequest* request,
+    MiBandSectorSessionResult* result,
+    uint8_t block_idx,
+    uint16_t block_bit) {
+    const MfClassicBlock* expected = &request->blocks[block_idx];
+    MfClassicBlock readback;
+
+    for(uint8_t rewrite = 0;; rewrite++) {
+        MfClassicError error = api->read_block(session, block_idx, &readback);
+        if(error != MfClassicErrorNone) return error;
+
+        if(memcmp(readback.data, expected->data, sizeof(readback.data)) == 0) return error;
+
+        if(rewrite == MIBAND_SECTOR_SESSION_VERIFY_REWRITES) break;
+
+        FURI_LOG_W(TAG, "Block %u reads back different, rewriting", block_idx);
+        result->rewrites++;
+        error = api->write_block(session, block_idx, &request->blocks[block_idx]);
+        if(error != MfClassicErrorNone) return error;
+    }
+
+    FURI_LOG_E(TAG, "Block %u still differs after rewrite", block_idx);
+    result->mismatch_mask |= block_bit;
+    return MfClassicErrorNone;
+}
+
+/**
+ * @brief Authenticate once and transfer every pending block of the sector
+ *
+ * Runs as the card I/O session callback, with the card activated (on hardware,
+ * on the NFC worker thread).
+ */
+static MfClassicError miband_sector_session_execute(
+    const MiBandCardIoSessionApi* api,
+    void* session,
+    void* context) {
+    MiBandSectorSessionContext* ctx = context;
+    const MiBandSectorSessionRequest* request = ctx->request;
+    MiBandSectorSessionResult* result = ctx->result;
+
+    uint8_t first_block = mf_classic_get_first_block_num_of_sector(request->sector);
+    uint8_t blocks_in_sector = mf_classic_get_blocks_num_in_sector(request->sector);
+    MfClassicKey key = request->key;
+
+    uint32_t start = miband_op_stats_start();
+    MfClassicError error = api->auth(session, first_block, &key, request->key_type);
+    miband_op_stats_record(MiBandOpPhaseAuth, start, error);
+    if(request->auth_cache) {
+        miband_auth_cache_record(
+            request->auth_cache, first_block, &request->key, request->key_type, error);
+    }
+    if(error != MfClassicErrorNone) {
+        result->failed_block = first_block;
+        return error;
+    }
+    result->authenticated = true;
+
+    for(uint8_t block_in_sector = 0; block_in_sector < blocks_in_sector; block_in_sector++) {
+        uint16_t block_bit = 1U << block_in_sector;
+        if(!(request->block_mask & block_bit) || (result->done_mask & block_bit)) continue;
+
+        uint8_t block_idx = first_block + block_in_sector;
+        if(request->op == MiBandSectorSessionOpRead) {
+            error = api->read_block(session, block_idx, &request->blocks[block_idx]);
+        } else {
+            error = api->write_block(session, block_idx, &request->blocks[block_idx]);
+        }
+
+        if(error == MfClassicErrorNone && request->op == MiBandSectorSessionOpWriteVerify &&
+           !mf_classic_is_sector_trailer(block_idx)) {
+            error = miband_sector_session_verify_block(
+                api, session, request, result, block_idx, block_bit);
+            if(result->mismatch_mask & block_bit) {
+                // Sector not committed: its trailer must not hand it the new keys
+                result->failed_block = block_idx;
+                api->halt(session);
+                return MfClassicErrorNone;
+            }
+        }
+
+        if(error != MfClassicErrorNone) {
+            // Crypto session is lost after a failed transfer
+            result->failed_block = block_idx;
+            return error;
+        }
+
+        result->done_mask |= block_bit;
+    }
+
+    api->halt(session);
+    return MfClassicErrorNone;
+}
+
+uint16_t miband_sector_session_full_mask(uint8_t sector) {
+    uint8_t blocks_in_sector = mf_classic_get_blocks_num_in_sector(sector);
+    return (uint16_t)((1UL << blocks_in_sector) - 1);
+}
+
+MfClassicError miband_sector_session_run(
+    Nfc* nfc,
+    const MiBandSectorSessionRequest* request,
+    MiBandSectorSessionResult* result) {
+    furi_assert(nfc);
+    furi_assert(request);
+    furi_assert(result);
+
+    MiBandSectorSessionContext ctx = {
+        .request = request,
+        .result = result,
+    };
+    MfClassicError error = miband_card_io_run_session(nfc, miband_sector_session_execute, &ctx);
+
+    result->sessions++;
+    result->error = error;
+    return error;
+}
+
+bool miband_sector_session_transfer(
+    Nfc* nfc,
+    const MiBandSectorSessionRequest* request,
+    uint8_t max_sessions,
+    MiBandSectorSessionResult* result) {
+    memset(result, 0, sizeof(MiBandSectorSessionResult));
+
+    while(result->sessions < max_sessions) {
+        uint32_t start = miband_op_stats_start();
+        MfClassicError error = miband_sector_session_run(nfc, request, result);
+        miband_op_stats_record(MiBandOpPhaseSession, start, error);
+        if((result->done_mask & request->block_mask) == request->block_mask) {
+            result->error = MfClassicErrorNone;
+            return true;
+        }
+
+        FURI_LOG_D(
+            TAG,
+            "Sector %u: session %u failed at block %u (error %d)",
+            request->sector,
+            result->sessions,
+            result->failed_block,
+            error);
+
+        if(result->mismatch_mask) break;
+        if(error == MfClassicErrorAuth || error == MfClassicErrorNotPresent) break;
+    }
+
+    return false;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file miband_sector_session.h
+ * @brief Single-auth sector read/write in one card I/O session
+ *
+ * Every mf_classic_poller_sync_* call activates the card, authenticates,
+ * transfers one block and halts. Transferring a whole sector that way costs
+ * one auth handshake per block (two when the caller re-authenticates first).
+ *
+ * A sector session authenticates once and streams all requested blocks of
+ * the sector inside the same crypto session. A new session (re-auth) is only
+ * opened when a transfer fails, resuming from the first block not yet done.
+ * The session auth doubles as the key test: callers try a key by opening a
+ * session with it and move to the next one on MfClassicErrorAuth.
+ *
+ * In write+verify mode every data block is read back right after it is
+ * written, still inside the session, and rewritten on mismatch.
+ *
+ * Sessions run through miband_card_io, on the async MfClassic poller on
+ * hardware and on the simulated card in the host harness.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <nfc/nfc.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
+#include "miband_auth_cache.h"
+
+/**
+ * @brief Sector session operation
+ */
+typedef enum {
+    MiBandSectorSessionOpRead,
+    MiBandSectorSessionOpWrite,
+    MiBandSectorSessionOpWriteVerify, /**< Write, then read back data blocks */
+} MiBandSectorSessionOp;
+
+/** Rewrites attempted for a data block that reads back different */
+#define MIBAND_SECTOR_SESSION_VERIFY_REWRITES 1
+
+/**
+ * @brief Sector session request
+ */
+typedef struct {
+    MiBandSectorSessionOp op;
+    uint8_t sector;
+    MfClassicKey key;
+    MfClassicKeyType key_type;
+    uint16_t block_mask; /**< Blocks to transfer, bit N = Nth block of the sector */
+    MfClassicBlock* blocks; /**< Block array indexed by absolute block number */
+    MiBandAuthCache* auth_cache; /**< Optional, counts the session auths and caches the key */
+} MiBandSectorSessionRequest;
+
+/**
+ * @brief Sector session result
+ */
+typedef struct {
+    MfClassicError error; /**< Error of the last session, MfClassicErrorNone if all done */
+    uint16_t done_mask; /**< Blocks transferred successfully */
+    uint8_t failed_block; /**< Absolute block number of the last failure */
+    uint8_t sessions; /**< Number of auth sessions opened */
+    bool authenticated; /**< At least one session got past the auth */
+    uint16_t mismatch_mask; /**< Write+verify: blocks still differing after rewrites */
+    uint8_t rewrites; /**< Write+verify: blocks rewritten after a mismatch */
+} MiBandSectorSessionResult;
+
+/**
+ * @brief Get the mask covering every block of a sector
+ *
+ * @param sector Sector number
+ * @return Block mask with one bit per block of the sector
+ */
+uint16_t miband_sector_session_full_mask(uint8_t sector);
+
+/**
+ * @brief Run one authenticated session over the requested blocks
+ *
+ * Blocks are transferred in ascending order, so the sector trailer is
+ * always written last. The session stops at the first failing block.
+ * A block that keeps reading back different in write+verify mode is flagged
+ * in mismatch_mask and also ends the session, so the sector trailer is not
+ * written over a sector whose data did not verify.
+ *
+ * @param nfc NFC instance
+ * @param request Session request
+ * @param result Result, done_mask is accumulated (not cleared)
+ * @return MfClassicError of the session
+ */
+MfClassicError miband_sector_session_run(
+    Nfc* nfc,
+    const MiBandSectorSessionRequest* request,
+    MiBandSectorSessionResult* result);
+
+/**
+ * @brief Transfer the requested blocks, re-authenticating only after errors
+ *
+ * Opens up to max_sessions sessions. Each new session resumes with the
+ * blocks not yet transferred, so timeouts are retried by re-authenticating.
+ * Stops immediately on an auth failure, since retrying with the same key
+ * cannot succeed (result->error is then MfClassicErrorAuth), and on a
+ * persistent verify mismatch, since the card already accepted the write.
+ *
+ * @param nfc NFC instance
+ * @param request Session request
+ * @param max_sessions Maximum number of sessions to open
+ * @param result Result (cleared on entry)
+ * @return true if every requested block was transferred
+ */
+bool miband_sector_session_transfer(
+    Nfc* nfc,
+    const MiBandSectorSessionRequest* request,
+    uint8_t max_sessions,
+    MiBandSectorSessionResult* result);
@@ -0,0 +1,480 @@
+/**
+ * @file miband_uid_index.c
+ * @brief Persistent UID -> dump file index implementation
+ */
+
+#include "miband_uid_index.h"
+#include "miband_nfc_header.h"
+#include "miband_dir_walker.h"
+
+#define TAG "MiBandUidIndex"
+
+#define MIBAND_UID_INDEX_TMP_PATH    EXT_PATH("apps_data/miband_nfc/uid_index.tmp")
+#define MIBAND_UID_INDEX_MAGIC       "MBUI"
+#define MIBAND_UID_INDEX_VERSION     1
+#define MIBAND_UID_INDEX_INITIAL_CAP 16
+#define MIBAND_UID_INDEX_EXTENSION   ".nfc"
+
+/**
+ * @brief On-disk index header
+ */
+typedef struct {
+    char magic[4];
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t count;
+} MiBandUidIndexHeader;
+
+/**
+ * @brief On-disk entry, followed by path_len bytes of path
+ */
+typedef struct {
+    uint32_t mtime;
+    uint32_t size;
+    uint16_t path_len;
+    uint8_t uid_len; /**< 0 for dumps without a MfClassic UID */
+    uint8_t uid[MIBAND_UID_INDEX_UID_MAX];
+    uint8_t reserved[3];
+} MiBandUidIndexRecord;
+
+typedef struct {
+    MiBandUidIndexRecord record;
+    FuriString* path;
+    bool seen;
+} MiBandUidIndexEntry;
+
+/**
+ * @brief UID index internal structure
+ */
+struct MiBandUidIndex {
+    Storage* storage;
+    MiBandUidIndexEntry* entries;
+    size_t count;
+    size_t capacity;
+    size_t max_entries;
+    const char* skip_folder;
+    bool dirty;
+
+    uint8_t watch_uid[MIBAND_UID_INDEX_UID_MAX];
+    size_t watch_uid_len;
+    MiBandUidIndexMatchCallback watch_callback;
+    void* watch_context;
+};
+
+MiBandUidIndex* miband_uid_index_alloc(Storage* storage) {
+    furi_assert(storage);
+
+    MiBandUidIndex* index = malloc(sizeof(MiBandUidIndex));
+    memset(index, 0, sizeof(MiBandUidIndex));
+    index->storage = storage;
+    index->max_entries = MIBAND_UID_INDEX_ENTRIES_MAX;
+    return index;
+}
+
+void miband_uid_index_set_max_entries(MiBandUidIndex* index, size_t max_entries) {
+    furi_assert(index);
+    index->max_entries = CLAMP(max_entries, (size_t)MIBAND_UID_INDEX_ENTRIES_MAX, (size_t)1);
+}
+
+void miband_uid_index_set_skip_folder(MiBandUidIndex* index, const char* folder) {
+    furi_assert(index);
+    index->skip_folder = folder;
+}
+
+/**
+ * @brief Check whether a path lies below the skipped folder
+ */
+static bool miband_uid_index_is_skipped(const MiBandUidIndex* index, const FuriString* path) {
+    if(!index->skip_folder) return false;
+
+    size_t skip_len = strlen(index->skip_folder);
+    return furi_string_size(path) > skip_len &&
+           furi_string_start_with_str(path, index->skip_folder) &&
+           furi_string_get_char(path, skip_len) == '/';
+}
+
+static void miband_uid_index_reset(MiBandUidIndex* index) {
+    for(size_t i = 0; i < index->count; i++) {
+        furi_string_free(index->entries[i].path);
+    }
+    index->count = 0;
+}
+
+void miband_uid_index_free(MiBandUidIndex* index) {
+    if(!index) return;
+
+    miband_uid_index_reset(index);
+    free(index->entries);
+    free(index);
+}
+
+static MiBandUidIndexEntry* miband_uid_index_add(MiBandUidIndex* index, const char* path) {
+    if(index->count >= index->max_entries) return NULL;
+
+    if(index->count >= index->capacity) {
+        size_t capacity = index->capacity ? index->capacity * 2 : MIBAND_UID_INDEX_INITIAL_CAP;
+        MiBandUidIndexEntry* entries =
+            realloc(index->entries, sizeof(MiBandUidIndexEntry) * capacity);
+        if(!entries) return NULL;
+        index->entries = entries;
+        index->capacity = capacity;
+    }
+
+    MiBandUidIndexEntry* entry = &index->entries[index->count++];
+    memset(entry, 0, sizeof(MiBandUidIndexEntry));
+    entry->path = furi_string_alloc_set_str(path);
+    return entry;
+}
+
+static void miband_uid_index_remove(MiBandUidIndex* index, size_t entry_idx) {
+    furi_string_free(index->entries[entry_idx].path);
+    index->count--;
+    if(entry_idx < index->count) {
+        memmove(
+            &index->entries[entry_idx],
+            &index->entries[entry_idx + 1],
+            sizeof(MiBandUidIndexEntry) * (index->count - entry_idx));
+    }
+}
+
+/**
+ * @brief Find an entry by path
+ *
+ * Directory listings come back in a stable order, so the search starts
+ * right after the previous hit and almost always succeeds on the first compare.
+ */
+static MiBandUidIndexEntry*
+    miband_uid_index_find_path(MiBandUidIndex* index, const char* path, size_t* hint) {
+    for(size_t n = 0; n < index->count; n++) {
+        size_t entry_idx = (*hint + n) % index->count;
+        if(furi_string_equal_str(index->entries[entry_idx].path, path)) {
+            *hint = entry_idx + 1;
+            return &index->entries[entry_idx];
+        }
+    }
+    return NULL;
+}
+
+bool miband_uid_index_load(MiBandUidIndex* index) {
+    furi_assert(index);
+
+    miband_uid_index_reset(index);
+    index->dirty = false;
+
+    File* file = storage_file_alloc(index->storage);
+    bool success = false;
+
+    do {
+        if(!storage_file_open(file, MIBAND_UID_INDEX_PATH, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            FURI_LOG_I(TAG, "No index yet");
+            break;
+        }
+
+        MiBandUidIndexHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(memcmp(header.magic, MIBAND_UID_INDEX_MAGIC, sizeof(header.magic)) != 0 ||
+           header.version != MIBAND_UID_INDEX_VERSION ||
+           header.count > MIBAND_UID_INDEX_ENTRIES_MAX) {
+            FURI_LOG_W(TAG, "Index format mismatch, rebuilding");
+            break;
+        }
+
+        // Entries past the RAM limit stay in the file until the next save
+        uint32_t to_load = MIN(header.count, (uint32_t)index->max_entries);
+        if(to_load < header.count) {
+            FURI_LOG_I(TAG, "Keeping %lu of %lu entries", to_load, header.count);
+        }
+
+        char path_buf[256];
+        uint32_t loaded = 0;
+        for(; loaded < to_load; loaded++) {
+            MiBandUidIndexRecord record;
+            if(storage_file_read(file, &record, sizeof(record)) != sizeof(record)) break;
+            if(record.path_len == 0 || record.path_len >= sizeof(path_buf) ||
+               record.uid_len > MIBAND_UID_INDEX_UID_MAX) {
+                break;
+            }
+            if(storage_file_read(file, path_buf, record.path_len) != record.path_len) break;
+            path_buf[record.path_len] = '\0';
+
+            MiBandUidIndexEntry* entry = miband_uid_index_add(index, path_buf);
+            if(!entry) break;
+            entry->record = record;
+        }
+
+        if(loaded != to_load) {
+            FURI_LOG_W(TAG, "Index truncated at entry %lu, rebuilding", loaded);
+            miband_uid_index_reset(index);
+            break;
+        }
+
+        success = true;
+    } while(false);
+
+    storage_file_close(file);
+    storage_file_free(file);
+
+    if(success) FURI_LOG_I(TAG, "Loaded %zu entries", index->count);
+    return success;
+}
+
+static void miband_uid_index_ensure_dir(Storage* storage) {
+    storage_common_mkdir(storage, EXT_PATH("apps_data"));
+    storage_common_mkdir(storage, EXT_PATH("apps_data/miband_nfc"));
+}
+
+bool miband_uid_index_save(MiBandUidIndex* index) {
+    furi_assert(index);
+    if(!index->dirty) return true;
+
+    miband_uid_index_ensure_dir(index->storage);
+
+    File* file = storage_file_alloc(index->storage);
+    bool success = false;
+
+    do {
+        if(!storage_file_open(file, MIBAND_UID_INDEX_TMP_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            FURI_LOG_E(TAG, "Cannot create index file");
+            break;
+        }
+
+        MiBandUidIndexHeader header = {
+            .version = MIBAND_UID_INDEX_VERSION,
+            .count = index->count,
+        };
+        memcpy(header.magic, MIBAND_UID_INDEX_MAGIC, sizeof(header.magic));
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        size_t written = 0;
+        for(; written < index->count; written++) {
+            MiBandUidIndexEntry* entry = &index->entries[written];
+            entry->record.path_len = furi_string_size(entry->path);
+            if(storage_file_write(file, &entry->record, sizeof(entry->record)) !=
+               sizeof(entry->record)) {
+                break;
+            }
+            const char* entry_path = furi_string_get_cstr(entry->path);
+            if(storage_file_write(file, entry_path, entry->record.path_len) !=
+               entry->record.path_len) {
+                break;
+            }
+        }
+        if(written != index->count) break;
+
+        success = true;
+    } while(false);
+
+    storage_file_close(file);
+    storage_file_free(file);
+
+    if(success) {
+        // Replace the old index only once the new one is complete
+        storage_common_remove(index->storage, MIBAND_UID_INDEX_PATH);
+        success = storage_common_rename(
+                      index->storage, MIBAND_UID_INDEX_TMP_PATH, MIBAND_UID_INDEX_PATH) == FSE_OK;
+    } else {
+        storage_common_remove(index->storage, MIBAND_UID_INDEX_TMP_PATH);
+    }
+
+    if(success) {
+        index->dirty = false;
+        FURI_LOG_I(TAG, "Saved %zu entries", index->count);
+    } else {
+        FURI_LOG_E(TAG, "Failed to save index");
+    }
+    return success;
+}
+
+/**
+ * @brief Read the UID of a dump into the record, header only
+ */
+static void miband_uid_index_parse(MiBandUidIndexRecord* record, const char* path, File* file) {
+    MiBandNfcHeader header;
+    record->uid_len = 0;
+
+    if(miband_nfc_header_read(file, path, &header) && header.uid_len <= MIBAND_UID_INDEX_UID_MAX) {
+        memcpy(record->uid, header.uid, header.uid_len);
+        record->uid_len = header.uid_len;
+    }
+}
+
+static bool miband_uid_index_matches(
+    const MiBandUidIndexRecord* record,
+    const uint8_t* uid,
+    size_t uid_len) {
+    return uid_len > 0 && record->uid_len == uid_len && memcmp(record->uid, uid, uid_len) == 0;
+}
+
+typedef struct {
+    MiBandUidIndex* index;
+    File* file;
+    MiBandUidIndexProgressCallback callback;
+    void* context;
+    uint32_t files_seen;
+    uint32_t files_parsed;
+    size_t hint;
+} MiBandUidIndexUpdate;
+
+static bool miband_uid_index_update_progress(MiBandUidIndexUpdate* update) {
+    if(update->callback &&
+       !update->callback(update->files_seen, update->files_parsed, update->context)) {
+        FURI_LOG_W(TAG, "Update aborted");
+        return false;
+    }
+    return true;
+}
+
+static bool miband_uid_index_update_file(const char* path, const FileInfo* info, void* context) {
+    MiBandUidIndexUpdate* update = context;
+    MiBandUidIndex* index = update->index;
+
+    update->files_seen++;
+
+    uint32_t mtime = 0;
+    storage_common_timestamp(index->storage, path, &mtime);
+
+    MiBandUidIndexEntry* entry = miband_uid_index_find_path(index, path, &update->hint);
+    if(!entry) {
+        entry = miband_uid_index_add(index, path);
+        if(!entry) {
+            // No room to keep it: parse every time so watch matches still fire
+            MiBandUidIndexRecord record;
+            miband_uid_index_parse(&record, path, update->file);
+            update->files_parsed++;
+            if(index->watch_callback &&
+               miband_uid_index_matches(&record, index->watch_uid, index->watch_uid_len)) {
+                index->watch_callback(path, index->watch_context);
+            }
+            return miband_uid_index_update_progress(update);
+        }
+        // Force a parse below
+        entry->record.mtime = ~mtime;
+    }
+
+    entry->seen = true;
+    if(entry->record.mtime != mtime || entry->record.size != (uint32_t)info->size) {
+        miband_uid_index_parse(&entry->record, path, update->file);
+        entry->record.mtime = mtime;
+        entry->record.size = (uint32_t)info->size;
+        index->dirty = true;
+        update->files_parsed++;
+
+        if(index->watch_callback &&
+           miband_uid_index_matches(&entry->record, index->watch_uid, index->watch_uid_len)) {
+            index->watch_callback(path, index->watch_context);
+        }
+    }
+
+    return miband_uid_index_update_progress(update);
+}
+
+bool miband_uid_index_update(
+    MiBandUidIndex* index,
+    const char* folder,
+    MiBandUidIndexProgressCallback callback,
+    void* context) {
+    furi_assert(index);
+    furi_assert(folder);
+
+    for(size_t i = 0; i < index->count; i++) {
+        index->entries[i].seen = false;
+    }
+
+    MiBandUidIndexUpdate update = {
+        .index = index,
+        .file = storage_file_alloc(index->storage),
+        .callback = callback,
+        .context = context,
+    };
+
+    bool complete = miband_dir_walk(
+        index->storage,
+        folder,
+        index->skip_folder,
+        MIBAND_UID_INDEX_EXTENSION,
+        miband_uid_index_update_file,
+        &update);
+
+    storage_file_free(update.file);
+
+    // Only a full walk proves that a file is gone
+    if(complete) {
+        for(size_t i = index->count; i > 0; i--) {
+            if(!index->entries[i - 1].seen) {
+                miband_uid_index_remove(index, i - 1);
+                index->dirty = true;
+            }
+        }
+    }
+
+    FURI_LOG_I(
+        TAG,
+        "Update: %lu files, %lu parsed, %zu indexed",
+        update.files_seen,
+        update.files_parsed,
+        index->count);
+
+    miband_uid_index_save(index);
+    return complete;
+}
+
+void miband_uid_index_watch(
+    MiBandUidIndex* index,
+    const uint8_t* uid,
+    size_t uid_len,
+    MiBandUidIndexMatchCallback callback,
+    void* context) {
+    furi_assert(index);
+
+    if(!uid || uid_len > MIBAND_UID_INDEX_UID_MAX) {
+        index->watch_callback = NULL;
+        index->watch_uid_len = 0;
+        return;
+    }
+
+    memcpy(index->watch_uid, uid, uid_len);
+    index->watch_uid_len = uid_len;
+    index->watch_callback = callback;
+    index->watch_context = context;
+}
+
+size_t miband_uid_index_get_count(const MiBandUidIndex* index) {
+    furi_assert(index);
+    return index->count;
+}
+
+/**
+ * @brief Check that an indexed file is still the one that was parsed
+ */
+static bool miband_uid_index_is_fresh(Storage* storage, const MiBandUidIndexEntry* entry) {
+    FileInfo info;
+    uint32_t mtime = 0;
+    const char* path = furi_string_get_cstr(entry->path);
+
+    if(storage_common_stat(storage, path, &info) != FSE_OK) return false;
+    storage_common_timestamp(storage, path, &mtime);
+    return mtime == entry->record.mtime && (uint32_t)info.size == entry->record.size;
+}
+
+size_t miband_uid_index_find(
+    const MiBandUidIndex* index,
+    const uint8_t* uid,
+    size_t uid_len,
+    bool check_files,
+    MiBandUidIndexMatchCallback callback,
+    void* context) {
+    furi_assert(index);
+    furi_assert(uid);
+
+    size_t matches = 0;
+    for(size_t i = 0; i < index->count; i++) {
+        const MiBandUidIndexEntry* entry = &index->entries[i];
+        if(!miband_uid_index_matches(&entry->record, uid, uid_len)) continue;
+        if(miband_uid_index_is_skipped(index, entry->path)) continue;
+        if(check_files && !miband_uid_index_is_fresh(index->storage, entry)) continue;
+
+        matches++;
+        if(callback) callback(furi_string_get_cstr(entry->path), context);
+    }
+    return matches;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file miband_uid_index.h
+ * @brief Persistent UID -> dump file index
+ *
+ * Quick UID Check used to parse every .nfc file on each run. The index keeps
+ * the UID of every dump together with the file's mtime and size, and is
+ * stored under apps_data/miband_nfc. Updating it only re-parses files whose
+ * mtime or size changed, so a lookup costs one directory listing plus an
+ * in-memory search.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+
+#define MIBAND_UID_INDEX_PATH        EXT_PATH("apps_data/miband_nfc/uid_index.bin")
+#define MIBAND_UID_INDEX_UID_MAX     10
+#define MIBAND_UID_INDEX_ENTRIES_MAX 2048 // Default and upper bound of the RAM limit
+
+/**
+ * @brief UID index structure
+ */
+typedef struct MiBandUidIndex MiBandUidIndex;
+
+/**
+ * @brief Progress callback for miband_uid_index_update()
+ *
+ * @param files_seen Dump files listed so far
+ * @param files_parsed Dump files (re-)parsed so far
+ * @param context User context
+ * @return false to abort the update
+ */
+typedef bool (*MiBandUidIndexProgressCallback)(
+    uint32_t files_seen,
+    uint32_t files_parsed,
+    void* context);
+
+/**
+ * @brief Match callback for miband_uid_index_find()
+ *
+ * @param path Full path of the matching dump
+ * @param context User context
+ */
+typedef void (*MiBandUidIndexMatchCallback)(const char* path, void* context);
+
+/**
+ * @brief Create an empty UID index
+ *
+ * @param storage Storage API instance
+ * @return Allocated MiBandUidIndex instance
+ */
+MiBandUidIndex* miband_uid_index_alloc(Storage* storage);
+
+/**
+ * @brief Free UID index
+ *
+ * @param index UID index instance
+ */
+void miband_uid_index_free(MiBandUidIndex* index);
+
+/**
+ * @brief Limit the number of entries kept in RAM
+ *
+ * Set before loading. Entries past the limit are not loaded, and dumps that
+ * find no room are parsed on every update instead of being indexed: they
+ * are still reported to the watch callback, just never from
+ * miband_uid_index_find().
+ *
+ * @param index UID index instance
+ * @param max_entries Entry limit, up to MIBAND_UID_INDEX_ENTRIES_MAX
+ */
+void miband_uid_index_set_max_entries(MiBandUidIndex* index, size_t max_entries);
+
+/**
+ * @brief Leave a folder tree out of the index
+ *
+ * Updates do not walk it, so its entries are dropped by the next complete
+ * update, and miband_uid_index_find() ignores the ones still loaded.
+ *
+ * @param index UID index instance
+ * @param folder Folder to leave out, must outlive the index; NULL for none
+ */
+void miband_uid_index_set_skip_folder(MiBandUidIndex* index, const char* folder);
+
+/**
+ * @brief Load the index from MIBAND_UID_INDEX_PATH
+ *
+ * @param index UID index instance
+ * @return true if a valid index file was loaded
+ */
+bool miband_uid_index_load(MiBandUidIndex* index);
+
+/**
+ * @brief Save the index to MIBAND_UID_INDEX_PATH if it changed
+ *
+ * @param index UID index instance
+ * @return true if the index is stored on SD
+ */
+bool miband_uid_index_save(MiBandUidIndex* index);
+
+/**
+ * @brief Bring the index in sync with the dumps in a folder tree
+ *
+ * The folder is walked recursively. New and modified files are parsed,
+ * entries of deleted files are dropped, unchanged files are only stat'ed.
+ *
+ * @param index UID index instance
+ * @param folder Root folder holding the .nfc dumps
+ * @param callback Optional progress callback, may abort the update
+ * @param context Callback context
+ * @return true if the whole tree was processed
+ */
+bool miband_uid_index_update(
+    MiBandUidIndex* index,
+    const char* folder,
+    MiBandUidIndexProgressCallback callback,
+    void* context);
+
+/**
+ * @brief Report dumps with a given UID while updating
+ *
+ * Every file (re-)parsed by the next miband_uid_index_update() calls whose
+ * UID matches is passed to the callback as soon as it is parsed. Files that
+ * were already indexed are not reported, look them up with
+ * miband_uid_index_find() first.
+ *
+ * @param index UID index instance
+ * @param uid UID bytes, NULL to stop watching
+ * @param uid_len UID length
+ * @param callback Called for each freshly parsed match
+ * @param context Callback context
+ */
+void miband_uid_index_watch(
+    MiBandUidIndex* index,
+    const uint8_t* uid,
+    size_t uid_len,
+    MiBandUidIndexMatchCallback callback,
+    void* context);
+
+/**
+ * @brief Get the number of indexed dumps
+ *
+ * @param index UID index instance
+ * @return Number of entries
+ */
+size_t miband_uid_index_get_count(const MiBandUidIndex* index);
+
+/**
+ * @brief Find every dump with the given UID
+ *
+ * With check_files set, each match is stat'ed first and skipped if the file
+ * is gone or changed since it was indexed. This makes a lookup on a freshly
+ * loaded index trustworthy before miband_uid_index_update() ran.
+ *
+ * @param index UID index instance
+ * @param uid UID bytes
+ * @param uid_len UID length
+ * @param check_files Only report matches whose file is unchanged on SD
+ * @param callback Called for each match
+ * @param context Callback context
+ * @return Number of matches
+ */
+size_t miband_uid_index_find(
+    const MiBandUidIndex* index,
+    const uint8_t* uid,
+    size_t uid_len,
+    bool check_files,
+    MiBandUidIndexMatchCallback callback,
+    void* context);
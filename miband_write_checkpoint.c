@@ -0,0 +1,126 @@
+/**
+ * @file miband_write_checkpoint.c
+ * @brief Write checkpoint implementation
+ */
+
+#include "miband_write_checkpoint.h"
+#include "miband_hash.h"
+
+#define TAG "MiBandCheckpoint"
+
+#define MIBAND_WRITE_CHECKPOINT_MAGIC   0x4D42434B // "MBCK"
+#define MIBAND_WRITE_CHECKPOINT_VERSION 1
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    MiBandWriteCheckpoint checkpoint;
+} MiBandWriteCheckpointFile;
+
+uint32_t miband_write_checkpoint_dump_id(const MfClassicData* data) {
+    return miband_hash_dump(data);
+}
+
+bool miband_write_checkpoint_begin(
+    MiBandWriteCheckpoint* checkpoint,
+    const uint8_t* uid,
+    size_t uid_len,
+    uint32_t dump_id) {
+    furi_assert(checkpoint);
+    furi_assert(uid);
+
+    uid_len = MIN(uid_len, (size_t)MIBAND_WRITE_CHECKPOINT_UID_MAX);
+    if(uid_len > 0 && checkpoint->uid_len == uid_len && checkpoint->dump_id == dump_id &&
+       memcmp(checkpoint->uid, uid, uid_len) == 0) {
+        return checkpoint->committed != 0;
+    }
+
+    memset(checkpoint, 0, sizeof(MiBandWriteCheckpoint));
+    memcpy(checkpoint->uid, uid, uid_len);
+    checkpoint->uid_len = uid_len;
+    checkpoint->dump_id = dump_id;
+    return false;
+}
+
+void miband_write_checkpoint_commit(MiBandWriteCheckpoint* checkpoint, size_t sector) {
+    furi_assert(checkpoint);
+    furi_assert(sector < MF_CLASSIC_TOTAL_SECTORS_MAX);
+    checkpoint->committed |= 1ULL << sector;
+}
+
+bool miband_write_checkpoint_is_committed(const MiBandWriteCheckpoint* checkpoint, size_t sector) {
+    furi_assert(checkpoint);
+    return (checkpoint->committed >> sector) & 1U;
+}
+
+uint32_t miband_write_checkpoint_get_count(const MiBandWriteCheckpoint* checkpoint) {
+    furi_assert(checkpoint);
+    return __builtin_popcountll(checkpoint->committed);
+}
+
+void miband_write_checkpoint_clear(MiBandWriteCheckpoint* checkpoint) {
+    furi_assert(checkpoint);
+    memset(checkpoint, 0, sizeof(MiBandWriteCheckpoint));
+}
+
+bool miband_write_checkpoint_save(const MiBandWriteCheckpoint* checkpoint, Storage* storage) {
+    furi_assert(checkpoint);
+    furi_assert(storage);
+
+    if(checkpoint->uid_len == 0 || checkpoint->committed == 0) {
+        FS_Error error = storage_common_remove(storage, MIBAND_WRITE_CHECKPOINT_PATH);
+        return error == FSE_OK || error == FSE_NOT_EXIST;
+    }
+
+    storage_simply_mkdir(storage, EXT_PATH("apps_data"));
+    storage_simply_mkdir(storage, EXT_PATH("apps_data/miband_nfc"));
+
+    MiBandWriteCheckpointFile record = {
+        .magic = MIBAND_WRITE_CHECKPOINT_MAGIC,
+        .version = MIBAND_WRITE_CHECKPOINT_VERSION,
+        .checkpoint = *checkpoint,
+    };
+
+    File* file = storage_file_alloc(storage);
+    bool success = false;
+    if(storage_file_open(file, MIBAND_WRITE_CHECKPOINT_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        success = storage_file_write(file, &record, sizeof(record)) == sizeof(record);
+    }
+    storage_file_close(file);
+    storage_file_free(file);
+
+    // Saved after every committed sector, keep the log quiet
+    FURI_LOG_D(
+        TAG,
+        "Checkpoint saved (%lu sectors): %s",
+        miband_write_checkpoint_get_count(checkpoint),
+        success ? "OK" : "FAIL");
+    return success;
+}
+
+bool miband_write_checkpoint_load(MiBandWriteCheckpoint* checkpoint, Storage* storage) {
+    furi_assert(checkpoint);
+    furi_assert(storage);
+
+    MiBandWriteCheckpointFile record = {0};
+    File* file = storage_file_alloc(storage);
+    bool success = false;
+
+    if(storage_file_open(file, MIBAND_WRITE_CHECKPOINT_PATH, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        success = storage_file_read(file, &record, sizeof(record)) == sizeof(record) &&
+                  record.magic == MIBAND_WRITE_CHECKPOINT_MAGIC &&
+                  record.version == MIBAND_WRITE_CHECKPOINT_VERSION &&
+                  record.checkpoint.uid_len <= MIBAND_WRITE_CHECKPOINT_UID_MAX;
+    }
+    storage_file_close(file);
+    storage_file_free(file);
+
+    if(success) {
+        *checkpoint = record.checkpoint;
+        FURI_LOG_I(
+            TAG, "Checkpoint loaded (%lu sectors)", miband_write_checkpoint_get_count(checkpoint));
+    } else {
+        miband_write_checkpoint_clear(checkpoint);
+    }
+    return success;
+}
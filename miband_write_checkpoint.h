@@ -0,0 +1,107 @@
+/**
+ * @file miband_write_checkpoint.h
+ * @brief Sectors already committed by an interrupted write
+ *
+ * When the band leaves the field partway through a write, the sectors
+ * written so far are already on the band. The checkpoint remembers them
+ * for that band (UID) and that dump (content hash), so presenting the same
+ * band again resumes from the first uncommitted sector instead of sector 0.
+ *
+ * The checkpoint lives in RAM and can optionally be kept in a small file
+ * under apps_data/miband_nfc, to survive leaving the app.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
+
+#define MIBAND_WRITE_CHECKPOINT_PATH    EXT_PATH("apps_data/miband_nfc/write_checkpoint.bin")
+#define MIBAND_WRITE_CHECKPOINT_UID_MAX 10
+
+/**
+ * @brief Write checkpoint
+ */
+typedef struct {
+    uint8_t uid[MIBAND_WRITE_CHECKPOINT_UID_MAX];
+    uint8_t uid_len; // 0 when there is no checkpoint
+    uint32_t dump_id; // miband_write_checkpoint_dump_id() of the dump being written
+    uint64_t committed; // Bit N = sector N is on the band
+} MiBandWriteCheckpoint;
+
+/**
+ * @brief Identify a dump by its content
+ *
+ * @param data Dump to write
+ * @return miband_hash_dump() of the dump
+ */
+uint32_t miband_write_checkpoint_dump_id(const MfClassicData* data);
+
+/**
+ * @brief Start or resume a write
+ *
+ * Keeps the committed sectors when the checkpoint is for this band and this
+ * dump, otherwise starts a new, empty checkpoint for them.
+ *
+ * @param checkpoint Write checkpoint
+ * @param uid UID of the band in the field
+ * @param uid_len UID length
+ * @param dump_id Dump identifier
+ * @return true if committed sectors were kept (the write resumes)
+ */
+bool miband_write_checkpoint_begin(
+    MiBandWriteCheckpoint* checkpoint,
+    const uint8_t* uid,
+    size_t uid_len,
+    uint32_t dump_id);
+
+/**
+ * @brief Record a sector as written
+ *
+ * @param checkpoint Write checkpoint
+ * @param sector Sector number
+ */
+void miband_write_checkpoint_commit(MiBandWriteCheckpoint* checkpoint, size_t sector);
+
+/**
+ * @brief Check whether a sector was already written
+ *
+ * @param checkpoint Write checkpoint
+ * @param sector Sector number
+ * @return true if the sector is committed
+ */
+bool miband_write_checkpoint_is_committed(const MiBandWriteCheckpoint* checkpoint, size_t sector);
+
+/**
+ * @brief Get the number of committed sectors
+ *
+ * @param checkpoint Write checkpoint
+ * @return Committed sector count
+ */
+uint32_t miband_write_checkpoint_get_count(const MiBandWriteCheckpoint* checkpoint);
+
+/**
+ * @brief Forget the checkpoint, e.g. once the write completed
+ *
+ * @param checkpoint Write checkpoint
+ */
+void miband_write_checkpoint_clear(MiBandWriteCheckpoint* checkpoint);
+
+/**
+ * @brief Store the checkpoint, or remove the file if there is nothing to resume
+ *
+ * @param checkpoint Write checkpoint
+ * @param storage Storage API instance
+ * @return true on success
+ */
+bool miband_write_checkpoint_save(const MiBandWriteCheckpoint* checkpoint, Storage* storage);
+
+/**
+ * @brief Load the checkpoint file
+ *
+ * @param checkpoint Write checkpoint, cleared if there is no valid file
+ * @param storage Storage API instance
+ * @return true if a checkpoint was loaded
+ */
+bool miband_write_checkpoint_load(MiBandWriteCheckpoint* checkpoint, Storage* storage);
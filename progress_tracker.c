@@ -4,7 +4,22 @@
  */
 
 #include "progress_tracker.h"
-#include <furi_hal_rtc.h>
+#include <gui/elements.h>
+
+#define PROGRESS_TRACKER_HEADER_SIZE 24
+#define PROGRESS_TRACKER_NAME_SIZE   16
+
+/**
+ * @brief What the view draws, copied under the model lock
+ */
+typedef struct {
+    char header[PROGRESS_TRACKER_HEADER_SIZE];
+    char status[PROGRESS_TRACKER_TEXT_SIZE];
+    char operation_name[PROGRESS_TRACKER_NAME_SIZE];
+    uint32_t total_items;
+    uint32_t completed_items;
+    uint32_t eta_seconds;
+} ProgressTrackerModel;
 
 /**
  * @brief Progress tracker internal structure
@@ -12,119 +27,202 @@
 struct ProgressTracker {
     uint32_t total_items;
     uint32_t completed_items;
-    char operation_name[32];
+    char operation_name[PROGRESS_TRACKER_NAME_SIZE];
     uint32_t start_time;
     uint32_t last_update_time;
+    uint32_t last_render_time;
+    uint32_t redraw_ms;
+    char render_buffer[PROGRESS_TRACKER_TEXT_SIZE];
+    View* view;
 };
 
+static void progress_tracker_draw_callback(Canvas* canvas, void* _model) {
+    ProgressTrackerModel* model = _model;
+    char line[PROGRESS_TRACKER_TEXT_SIZE];
+
+    canvas_clear(canvas);
+    canvas_set_font(canvas, FontPrimary);
+    canvas_draw_str_aligned(canvas, 64, 2, AlignCenter, AlignTop, model->header);
+
+    canvas_set_font(canvas, FontSecondary);
+    canvas_draw_str_aligned(canvas, 64, 16, AlignCenter, AlignTop, model->status);
+
+    if(model->total_items == 0) return;
+
+    uint32_t completed = MIN(model->completed_items, model->total_items);
+    snprintf(
+        line, sizeof(line), "%s %lu/%lu", model->operation_name, completed, model->total_items);
+    canvas_draw_str_aligned(canvas, 64, 28, AlignCenter, AlignTop, line);
+
+    float progress = (float)completed / (float)model->total_items;
+    snprintf(line, sizeof(line), "%lu%%", (completed * 100) / model->total_items);
+    elements_progress_bar_with_text(canvas, 4, 39, 120, progress, line);
+
+    if(model->eta_seconds > 0) {
+        snprintf(line, sizeof(line), "ETA %lu s", model->eta_seconds);
+        canvas_draw_str_aligned(canvas, 64, 63, AlignCenter, AlignBottom, line);
+    }
+}
+
+static void progress_tracker_render(ProgressTracker* tracker) {
+    tracker->last_render_time = furi_get_tick();
+    uint32_t eta = progress_tracker_get_eta_seconds(tracker);
+
+    with_view_model(
+        tracker->view,
+        ProgressTrackerModel * model,
+        {
+            model->total_items = tracker->total_items;
+            model->completed_items = tracker->completed_items;
+            model->eta_seconds = eta;
+        },
+        true);
+}
+
+static void progress_tracker_render_throttled(ProgressTracker* tracker) {
+    bool done = tracker->completed_items >= tracker->total_items;
+    uint32_t since_render = tracker->last_update_time - tracker->last_render_time;
+    if(done || since_render >= tracker->redraw_ms) {
+        progress_tracker_render(tracker);
+    }
+}
+
 ProgressTracker* progress_tracker_alloc(uint32_t total_items, const char* operation_name) {
     ProgressTracker* tracker = malloc(sizeof(ProgressTracker));
 
-    tracker->total_items = total_items;
-    tracker->completed_items = 0;
-    tracker->start_time = furi_get_tick();
-    tracker->last_update_time = tracker->start_time;
+    tracker->view = view_alloc();
+    view_allocate_model(tracker->view, ViewModelTypeLocking, sizeof(ProgressTrackerModel));
+    view_set_draw_callback(tracker->view, progress_tracker_draw_callback);
+    tracker->redraw_ms = PROGRESS_TRACKER_REDRAW_MS;
 
-    strncpy(tracker->operation_name, operation_name, 31);
-    tracker->operation_name[31] = '\0';
+    progress_tracker_reset(tracker, total_items, operation_name);
 
     return tracker;
 }
 
 void progress_tracker_free(ProgressTracker* tracker) {
+    view_free(tracker->view);
     free(tracker);
 }
 
+View* progress_tracker_get_view(ProgressTracker* tracker) {
+    return tracker->view;
+}
+
+void progress_tracker_set_redraw_ms(ProgressTracker* tracker, uint32_t redraw_ms) {
+    tracker->redraw_ms = redraw_ms;
+}
+
+void progress_tracker_reset(
+    ProgressTracker* tracker,
+    uint32_t total_items,
+    const char* operation_name) {
+    tracker->total_items = total_items;
+    tracker->completed_items = 0;
+    tracker->start_time = furi_get_tick();
+    tracker->last_update_time = tracker->start_time;
+    tracker->last_render_time = tracker->start_time;
+
+    strlcpy(tracker->operation_name, operation_name, sizeof(tracker->operation_name));
+
+    with_view_model(
+        tracker->view,
+        ProgressTrackerModel * model,
+        {
+            memset(model, 0, sizeof(ProgressTrackerModel));
+            strlcpy(model->operation_name, operation_name, sizeof(model->operation_name));
+            model->total_items = total_items;
+        },
+        true);
+}
+
+void progress_tracker_set_header(ProgressTracker* tracker, const char* header) {
+    bool changed = false;
+    with_view_model(
+        tracker->view,
+        ProgressTrackerModel * model,
+        {
+            changed = strncmp(model->header, header, sizeof(model->header) - 1) != 0;
+            if(changed) strlcpy(model->header, header, sizeof(model->header));
+        },
+        false);
+    if(changed) progress_tracker_render(tracker);
+}
+
+void progress_tracker_set_status(ProgressTracker* tracker, const char* status) {
+    bool changed = false;
+    with_view_model(
+        tracker->view,
+        ProgressTrackerModel * model,
+        {
+            changed = strncmp(model->status, status, sizeof(model->status) - 1) != 0;
+            if(changed) strlcpy(model->status, status, sizeof(model->status));
+        },
+        false);
+    if(changed) progress_tracker_render(tracker);
+}
+
 void progress_tracker_update(ProgressTracker* tracker, uint32_t completed_items) {
     tracker->completed_items = completed_items;
     tracker->last_update_time = furi_get_tick();
+    progress_tracker_render_throttled(tracker);
 }
 
 void progress_tracker_increment(ProgressTracker* tracker) {
     tracker->completed_items++;
     tracker->last_update_time = furi_get_tick();
+    progress_tracker_render_throttled(tracker);
 }
 
 uint8_t progress_tracker_get_percentage(const ProgressTracker* tracker) {
     if(tracker->total_items == 0) return 0;
-    return (tracker->completed_items * 100) / tracker->total_items;
+    uint32_t completed = MIN(tracker->completed_items, tracker->total_items);
+    return (completed * 100) / tracker->total_items;
 }
 
-FuriString* progress_tracker_get_text(const ProgressTracker* tracker) {
-    FuriString* text = furi_string_alloc();
-    uint8_t percentage = progress_tracker_get_percentage(tracker);
-
-    furi_string_printf(
-        text,
+const char* progress_tracker_get_text(ProgressTracker* tracker) {
+    snprintf(
+        tracker->render_buffer,
+        sizeof(tracker->render_buffer),
         "%s: %lu/%lu (%u%%)",
         tracker->operation_name,
         tracker->completed_items,
         tracker->total_items,
-        percentage);
+        progress_tracker_get_percentage(tracker));
 
-    return text;
+    return tracker->render_buffer;
 }
 
-FuriString* progress_tracker_get_bar(const ProgressTracker* tracker, uint8_t width) {
-    FuriString* bar = furi_string_alloc();
+const char* progress_tracker_get_bar(ProgressTracker* tracker, uint8_t width) {
+    width = MIN(width, (uint8_t)(sizeof(tracker->render_buffer) - 3));
     uint8_t percentage = progress_tracker_get_percentage(tracker);
     uint8_t filled = (percentage * width) / 100;
+    char* bar = tracker->render_buffer;
 
-    furi_string_cat_str(bar, "[");
+    *bar++ = '[';
     for(uint8_t i = 0; i < width; i++) {
         if(i < filled) {
-            furi_string_cat_str(bar, "=");
+            *bar++ = '=';
         } else if(i == filled && percentage < 100) {
-            furi_string_cat_str(bar, ">");
+            *bar++ = '>';
         } else {
-            furi_string_cat_str(bar, " ");
+            *bar++ = ' ';
         }
     }
-    furi_string_cat_str(bar, "]");
+    *bar++ = ']';
+    *bar = '\0';
 
-    return bar;
+    return tracker->render_buffer;
 }
 
 uint32_t progress_tracker_get_eta_seconds(const ProgressTracker* tracker) {
     if(tracker->completed_items == 0) return 0;
+    if(tracker->completed_items >= tracker->total_items) return 0;
 
-    uint32_t elapsed_ms = furi_get_tick() - tracker->start_time;
+    uint32_t elapsed_ms = tracker->last_update_time - tracker->start_time;
     uint32_t ms_per_item = elapsed_ms / tracker->completed_items;
     uint32_t remaining_items = tracker->total_items - tracker->completed_items;
     uint32_t eta_ms = ms_per_item * remaining_items;
 
     return eta_ms / 1000; // Convert to seconds
 }
-
-void progress_tracker_update_popup(
-    const ProgressTracker* tracker,
-    Popup* popup,
-    const char* header) {
-    if(header) {
-        popup_set_header(popup, header, 64, 2, AlignCenter, AlignTop);
-    }
-
-    FuriString* text = furi_string_alloc();
-
-    // Progress text
-    FuriString* progress_text = progress_tracker_get_text(tracker);
-    furi_string_cat(text, progress_text);
-    furi_string_free(progress_text);
-
-    furi_string_cat_str(text, "\n\n");
-
-    // Progress bar
-    FuriString* bar = progress_tracker_get_bar(tracker, 20);
-    furi_string_cat(text, bar);
-    furi_string_free(bar);
-
-    // ETA if available
-    uint32_t eta = progress_tracker_get_eta_seconds(tracker);
-    if(eta > 0 && tracker->completed_items > 5) {
-        furi_string_cat_printf(text, "\n\nETA: %lu seconds", eta);
-    }
-
-    popup_set_text(popup, furi_string_get_cstr(text), 4, 18, AlignLeft, AlignTop);
-
-    furi_string_free(text);
-}
@@ -4,13 +4,22 @@
  * 
  * This module provides a reusable progress tracker that can be used
  * across different scenes to show detailed progress information with
- * percentage, progress bar, and estimated time remaining.
+ * percentage, a graphical progress bar, and estimated time remaining.
+ * 
+ * The tracker owns a view: register it once with the view dispatcher and
+ * reset the tracker at the start of each operation. Updates are cheap and
+ * safe from worker threads; the view is redrawn at most once per redraw
+ * interval, PROGRESS_TRACKER_REDRAW_MS unless set otherwise (and always on
+ * completion or status change), and no text is allocated on the way.
  */
 
 #pragma once
 
 #include <furi.h>
-#include <gui/modules/popup.h>
+#include <gui/view.h>
+
+#define PROGRESS_TRACKER_REDRAW_MS 100
+#define PROGRESS_TRACKER_TEXT_SIZE 48
 
 /**
  * @brief Progress tracker structure
@@ -21,7 +30,7 @@ typedef struct ProgressTracker ProgressTracker;
  * @brief Create a new progress tracker
  * 
  * @param total_items Total number of items to process
- * @param operation_name Name of the operation (e.g., "Writing")
+ * @param operation_name Name of the items (e.g., "Sector")
  * @return Allocated ProgressTracker instance
  */
 ProgressTracker* progress_tracker_alloc(uint32_t total_items, const char* operation_name);
@@ -33,6 +42,52 @@ ProgressTracker* progress_tracker_alloc(uint32_t total_items, const char* operat
  */
 void progress_tracker_free(ProgressTracker* tracker);
 
+/**
+ * @brief Get the progress view
+ * 
+ * @param tracker Progress tracker instance
+ * @return View showing header, status, progress bar and ETA
+ */
+View* progress_tracker_get_view(ProgressTracker* tracker);
+
+/**
+ * @brief Set the minimum time between two progress redraws
+ * 
+ * @param tracker Progress tracker instance
+ * @param redraw_ms Redraw interval in milliseconds
+ */
+void progress_tracker_set_redraw_ms(ProgressTracker* tracker, uint32_t redraw_ms);
+
+/**
+ * @brief Start a new operation
+ * 
+ * Clears the counters, header and status and restarts the ETA clock.
+ * 
+ * @param tracker Progress tracker instance
+ * @param total_items Total number of items to process
+ * @param operation_name Name of the items (e.g., "Sector")
+ */
+void progress_tracker_reset(
+    ProgressTracker* tracker,
+    uint32_t total_items,
+    const char* operation_name);
+
+/**
+ * @brief Set the view header (copied), redrawn right away if it changed
+ * 
+ * @param tracker Progress tracker instance
+ * @param header Header text
+ */
+void progress_tracker_set_header(ProgressTracker* tracker, const char* header);
+
+/**
+ * @brief Set the status line (copied), redrawn right away if it changed
+ * 
+ * @param tracker Progress tracker instance
+ * @param status Status text, e.g. "Magic keys detected"
+ */
+void progress_tracker_set_status(ProgressTracker* tracker, const char* status);
+
 /**
  * @brief Update progress
  * 
@@ -59,23 +114,25 @@ uint8_t progress_tracker_get_percentage(const ProgressTracker* tracker);
 /**
  * @brief Get formatted progress string
  * 
- * Generates a string like: "Writing: 45/64 blocks (70%)"
+ * Generates a string like: "Sector: 45/64 (70%)". The text lives in the
+ * tracker's render buffer until the next get_text/get_bar call.
  * 
  * @param tracker Progress tracker instance
- * @return Allocated FuriString with progress text
+ * @return Progress text
  */
-FuriString* progress_tracker_get_text(const ProgressTracker* tracker);
+const char* progress_tracker_get_text(ProgressTracker* tracker);
 
 /**
  * @brief Get progress bar string
  * 
- * Generates ASCII progress bar like: "[=======>   ]"
+ * Generates ASCII progress bar like: "[=======>   ]" for logs. The text
+ * lives in the tracker's render buffer until the next get_text/get_bar call.
  * 
  * @param tracker Progress tracker instance
- * @param width Width of progress bar in characters
- * @return Allocated FuriString with progress bar
+ * @param width Width of progress bar in characters (clamped to the buffer)
+ * @return Progress bar text
  */
-FuriString* progress_tracker_get_bar(const ProgressTracker* tracker, uint8_t width);
+const char* progress_tracker_get_bar(ProgressTracker* tracker, uint8_t width);
 
 /**
  * @brief Get estimated time remaining
@@ -84,17 +141,3 @@ FuriString* progress_tracker_get_bar(const ProgressTracker* tracker, uint8_t wid
  * @return Estimated seconds remaining, or 0 if unknown
  */
 uint32_t progress_tracker_get_eta_seconds(const ProgressTracker* tracker);
-
-/**
- * @brief Update popup with progress information
- * 
- * Convenience function to update a popup view with complete progress info.
- * 
- * @param tracker Progress tracker instance
- * @param popup Popup view to update
- * @param header Optional header text (NULL to keep current)
- */
-void progress_tracker_update_popup(
-    const ProgressTracker* tracker,
-    Popup* popup,
-    const char* header);
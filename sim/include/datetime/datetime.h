@@ -0,0 +1,6 @@
+/**
+ * @file datetime.h
+ * @brief Host stand-in, included by miband_logger.h
+ */
+
+#pragma once
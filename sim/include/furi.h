@@ -0,0 +1,90 @@
+/**
+ * @file furi.h
+ * @brief Host stand-in for the parts of furi used by the shared modules
+ *
+ * Time is virtual: furi_get_tick() only moves when the simulated card
+ * spends latency or a module calls furi_delay_ms(), so runs are
+ * reproducible and take no wall-clock time.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define UNUSED(x)   (void)(x)
+#define COUNT_OF(x) (sizeof(x) / sizeof(x[0]))
+
+#ifndef MIN
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef MAX
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#endif
+#ifndef CLAMP
+#define CLAMP(x, upper, lower) (MIN(upper, MAX(x, lower)))
+#endif
+
+#define furi_check(x)  ((x) ? (void)0 : sim_host_crash(#x, __FILE__, __LINE__))
+#define furi_assert(x) furi_check(x)
+
+#define FURI_LOG_E(tag, ...) sim_host_log('E', tag, __VA_ARGS__)
+#define FURI_LOG_W(tag, ...) sim_host_log('W', tag, __VA_ARGS__)
+#define FURI_LOG_I(tag, ...) sim_host_log('I', tag, __VA_ARGS__)
+#define FURI_LOG_D(tag, ...) sim_host_log('D', tag, __VA_ARGS__)
+
+/**
+ * @brief Abort with the failed check, as furi_crash() does on the device
+ */
+void sim_host_crash(const char* expr, const char* file, int line);
+
+/**
+ * @brief Log sink, printed only in verbose mode
+ *
+ * Not format-checked on purpose: the firmware prints uint32_t with %lu,
+ * which the sink rewrites for LP64 hosts.
+ */
+void sim_host_log(char level, const char* tag, const char* format, ...);
+
+/**
+ * @brief Enable or disable the log sink
+ */
+void sim_host_set_verbose(bool verbose);
+
+/**
+ * @brief Advance the virtual clock
+ *
+ * @param us Microseconds spent, accumulated below tick resolution
+ */
+void sim_host_advance_us(uint32_t us);
+
+/**
+ * @brief Get the virtual clock in microseconds
+ */
+uint64_t sim_host_get_us(void);
+
+uint32_t furi_get_tick(void);
+
+void furi_delay_ms(uint32_t milliseconds);
+
+typedef struct FuriString FuriString;
+
+FuriString* furi_string_alloc(void);
+
+void furi_string_free(FuriString* string);
+
+void furi_string_reset(FuriString* string);
+
+void furi_string_set_str(FuriString* string, const char* cstr);
+
+void furi_string_cat_str(FuriString* string, const char* cstr);
+
+void furi_string_printf(FuriString* string, const char* format, ...);
+
+void furi_string_cat_printf(FuriString* string, const char* format, ...);
+
+const char* furi_string_get_cstr(const FuriString* string);
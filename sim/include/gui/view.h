@@ -0,0 +1,8 @@
+/**
+ * @file view.h
+ * @brief Host stand-in, progress_tracker.h only needs the type
+ */
+
+#pragma once
+
+typedef struct View View;
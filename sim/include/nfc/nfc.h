@@ -0,0 +1,8 @@
+/**
+ * @file nfc.h
+ * @brief Host stand-in: the shared modules only pass Nfc* through
+ */
+
+#pragma once
+
+typedef struct Nfc Nfc;
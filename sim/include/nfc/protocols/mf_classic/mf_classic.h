@@ -0,0 +1,103 @@
+/**
+ * @file mf_classic.h
+ * @brief Host stand-in for the MfClassic types and layout helpers
+ *
+ * Types mirror the firmware's; helpers are implemented in sim_mf_classic.c.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <nfc/protocols/iso14443_3a/iso14443_3a.h>
+
+#define MF_CLASSIC_TOTAL_SECTORS_MAX 40
+#define MF_CLASSIC_TOTAL_BLOCKS_MAX  256
+#define MF_CLASSIC_BLOCK_SIZE        16
+#define MF_CLASSIC_KEY_SIZE          6
+#define MF_CLASSIC_ACCESS_BYTES_SIZE 4
+
+typedef enum {
+    MfClassicErrorNone,
+    MfClassicErrorNotPresent,
+    MfClassicErrorProtocol,
+    MfClassicErrorAuth,
+    MfClassicErrorPartialRead,
+    MfClassicErrorTimeout,
+} MfClassicError;
+
+typedef enum {
+    MfClassicTypeMini,
+    MfClassicType1k,
+    MfClassicType4k,
+    MfClassicTypeNum,
+} MfClassicType;
+
+typedef enum {
+    MfClassicKeyTypeA,
+    MfClassicKeyTypeB,
+} MfClassicKeyType;
+
+typedef struct {
+    uint8_t data[MF_CLASSIC_BLOCK_SIZE];
+} MfClassicBlock;
+
+typedef struct {
+    uint8_t data[MF_CLASSIC_KEY_SIZE];
+} MfClassicKey;
+
+typedef struct {
+    uint8_t data[MF_CLASSIC_ACCESS_BYTES_SIZE];
+} MfClassicAccessBits;
+
+typedef struct {
+    MfClassicKey key_a;
+    MfClassicAccessBits access_bits;
+    MfClassicKey key_b;
+} MfClassicSectorTrailer;
+
+typedef struct {
+    uint8_t data[4];
+} MfClassicNt;
+
+typedef struct {
+    uint8_t block_num;
+    MfClassicKey key;
+    MfClassicKeyType key_type;
+    MfClassicNt nt;
+} MfClassicAuthContext;
+
+typedef struct {
+    Iso14443_3aData* iso14443_3a_data;
+    MfClassicType type;
+    uint32_t block_read_mask[MF_CLASSIC_TOTAL_BLOCKS_MAX / 32];
+    uint64_t key_a_mask;
+    uint64_t key_b_mask;
+    MfClassicBlock block[MF_CLASSIC_TOTAL_BLOCKS_MAX];
+} MfClassicData;
+
+uint8_t mf_classic_get_total_sectors_num(MfClassicType type);
+
+uint16_t mf_classic_get_total_block_num(MfClassicType type);
+
+uint8_t mf_classic_get_first_block_num_of_sector(uint8_t sector);
+
+uint8_t mf_classic_get_blocks_num_in_sector(uint8_t sector);
+
+uint8_t mf_classic_get_sector_trailer_num_by_sector(uint8_t sector);
+
+uint8_t mf_classic_get_sector_by_block(uint8_t block);
+
+bool mf_classic_is_sector_trailer(uint8_t block);
+
+MfClassicSectorTrailer*
+    mf_classic_get_sector_trailer_by_sector(const MfClassicData* data, uint8_t sector);
+
+bool mf_classic_is_key_found(const MfClassicData* data, uint8_t sector, MfClassicKeyType key_type);
+
+void mf_classic_set_key_found(
+    MfClassicData* data,
+    uint8_t sector,
+    MfClassicKeyType key_type,
+    uint64_t key);
+
+void mf_classic_set_block_read(MfClassicData* data, uint8_t block_num, MfClassicBlock* block);
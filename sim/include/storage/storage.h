@@ -0,0 +1,10 @@
+/**
+ * @file storage.h
+ * @brief Host stand-in, miband_logger.h and miband_uid_index.h only need the type and EXT_PATH
+ */
+
+#pragma once
+
+#define EXT_PATH(path) "/ext/" path
+
+typedef struct Storage Storage;
@@ -0,0 +1,301 @@
+/**
+ * @file sim_card.c
+ * @brief Simulated MfClassic band implementation
+ */
+
+#include "sim_card.h"
+
+#define SIM_CARD_NO_AUTH 0xFF
+
+const SimCardLatency sim_card_default_latency = {
+    .activate_us = 6000,
+    .auth_us = 3500,
+    .read_us = 2500,
+    .write_us = 6500,
+    .halt_us = 500,
+    .timeout_us = 25000,
+};
+
+/**
+ * @brief Simulated card internal structure
+ */
+struct SimCard {
+    SimCardConfig config;
+    MfClassicBlock blocks[MF_CLASSIC_TOTAL_BLOCKS_MAX];
+    uint8_t uid[4];
+    uint8_t auth_sector; // Sector of the open crypto session, SIM_CARD_NO_AUTH if none
+    uint8_t stuck_trailer; // Trailer of the stuck block's sector
+    uint32_t rng;
+    SimCardCounters counters;
+};
+
+static const uint8_t sim_card_magic_trailer[MF_CLASSIC_BLOCK_SIZE] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // Key A
+    0xFF, 0x07, 0x80, 0x69, // Transport access bits, GPB
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // Key B
+};
+
+/**
+ * @brief Spend the cost of one exchange, or a timeout
+ *
+ * @return true if the exchange went through
+ */
+static bool sim_card_exchange(SimCard* card, uint32_t latency_us) {
+    // xorshift32: cheap, and the same seed replays the same timeouts
+    card->rng ^= card->rng << 13;
+    card->rng ^= card->rng >> 17;
+    card->rng ^= card->rng << 5;
+
+    if(card->rng % 1000 < card->config.timeout_permille) {
+        sim_host_advance_us(card->config.latency.timeout_us);
+        card->counters.timeouts++;
+        card->auth_sector = SIM_CARD_NO_AUTH;
+        return false;
+    }
+
+    sim_host_advance_us(latency_us);
+    return true;
+}
+
+static bool sim_card_check_key(
+    const SimCard* card,
+    uint8_t sector,
+    const MfClassicKey* key,
+    MfClassicKeyType key_type) {
+    uint8_t trailer_num = mf_classic_get_sector_trailer_num_by_sector(sector);
+    const MfClassicSectorTrailer* trailer =
+        (const MfClassicSectorTrailer*)card->blocks[trailer_num].data;
+    const MfClassicKey* expected =
+        key_type == MfClassicKeyTypeA ? &trailer->key_a : &trailer->key_b;
+    return memcmp(expected->data, key->data, MF_CLASSIC_KEY_SIZE) == 0;
+}
+
+static Iso14443_3aError sim_card_activate_card(SimCard* card, Iso14443_3aData* data) {
+    card->auth_sector = SIM_CARD_NO_AUTH;
+    card->counters.activations++;
+    if(!sim_card_exchange(card, card->config.latency.activate_us)) return Iso14443_3aErrorTimeout;
+
+    if(data) {
+        memset(data, 0, sizeof(Iso14443_3aData));
+        memcpy(data->uid, card->uid, sizeof(card->uid));
+        data->uid_len = sizeof(card->uid);
+        data->atqa[0] = card->config.type == MfClassicType4k ? 0x02 : 0x04;
+        data->sak = card->config.type == MfClassicType4k ? 0x18 : 0x08;
+    }
+    return Iso14443_3aErrorNone;
+}
+
+static MfClassicError sim_card_session_auth(
+    void* session,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type) {
+    SimCard* card = session;
+    uint8_t sector = mf_classic_get_sector_by_block(block_num);
+
+    card->counters.auths++;
+    if(sector >= mf_classic_get_total_sectors_num(card->config.type)) {
+        card->auth_sector = SIM_CARD_NO_AUTH;
+        return MfClassicErrorNotPresent;
+    }
+    if(!sim_card_exchange(card, card->config.latency.auth_us)) return MfClassicErrorTimeout;
+
+    if(!sim_card_check_key(card, sector, key, key_type)) {
+        // The band stops answering until it is selected again
+        card->counters.auth_failures++;
+        card->auth_sector = SIM_CARD_NO_AUTH;
+        return MfClassicErrorAuth;
+    }
+
+    card->auth_sector = sector;
+    return MfClassicErrorNone;
+}
+
+static MfClassicError
+    sim_card_session_read_block(void* session, uint8_t block_num, MfClassicBlock* data) {
+    SimCard* card = session;
+
+    card->counters.reads++;
+    if(card->auth_sector != mf_classic_get_sector_by_block(block_num)) {
+        return MfClassicErrorProtocol;
+    }
+    if(!sim_card_exchange(card, card->config.latency.read_us)) return MfClassicErrorTimeout;
+
+    *data = card->blocks[block_num];
+    if(mf_classic_is_sector_trailer(block_num)) {
+        memset(data->data, 0, MF_CLASSIC_KEY_SIZE);
+    }
+    return MfClassicErrorNone;
+}
+
+static MfClassicError
+    sim_card_session_write_block(void* session, uint8_t block_num, MfClassicBlock* data) {
+    SimCard* card = session;
+
+    card->counters.writes++;
+    if(card->auth_sector != mf_classic_get_sector_by_block(block_num)) {
+        return MfClassicErrorProtocol;
+    }
+    if(!sim_card_exchange(card, card->config.latency.write_us)) return MfClassicErrorTimeout;
+
+    if(block_num == 0) {
+        // Manufacturer block: NAK'd, crypto session lost
+        card->auth_sector = SIM_CARD_NO_AUTH;
+        return MfClassicErrorProtocol;
+    }
+
+    card->blocks[block_num] = *data;
+    if(card->config.stuck_block && block_num == card->config.stuck_block) {
+        card->blocks[block_num].data[0] ^= 0xFF; // Acked, but stored wrong
+    } else if(card->config.stuck_block && block_num == card->stuck_trailer) {
+        card->counters.stuck_trailer_writes++;
+    }
+    return MfClassicErrorNone;
+}
+
+static void sim_card_session_halt(void* session) {
+    SimCard* card = session;
+    sim_host_advance_us(card->config.latency.halt_us);
+    card->auth_sector = SIM_CARD_NO_AUTH;
+}
+
+static const MiBandCardIoSessionApi sim_card_session_api = {
+    .auth = sim_card_session_auth,
+    .read_block = sim_card_session_read_block,
+    .write_block = sim_card_session_write_block,
+    .halt = sim_card_session_halt,
+};
+
+static Iso14443_3aError sim_card_activate(void* context, Nfc* nfc, Iso14443_3aData* data) {
+    UNUSED(nfc);
+    return sim_card_activate_card(context, data);
+}
+
+static MfClassicError sim_card_detect_type(void* context, Nfc* nfc, MfClassicType* type) {
+    UNUSED(nfc);
+    SimCard* card = context;
+
+    // The firmware probes with an auth to a high block, refused or not
+    if(sim_card_activate_card(card, NULL) != Iso14443_3aErrorNone) return MfClassicErrorTimeout;
+    if(!sim_card_exchange(card, card->config.latency.auth_us)) return MfClassicErrorTimeout;
+
+    *type = card->config.type;
+    return MfClassicErrorNone;
+}
+
+static MfClassicError sim_card_auth(
+    void* context,
+    Nfc* nfc,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicAuthContext* auth_context) {
+    UNUSED(nfc);
+    SimCard* card = context;
+
+    if(sim_card_activate_card(card, NULL) != Iso14443_3aErrorNone) return MfClassicErrorTimeout;
+    MfClassicError error = sim_card_session_auth(card, block_num, key, key_type);
+    if(auth_context) {
+        auth_context->block_num = block_num;
+        auth_context->key = *key;
+        auth_context->key_type = key_type;
+    }
+    return error;
+}
+
+static MfClassicError sim_card_read_block(
+    void* context,
+    Nfc* nfc,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicBlock* data) {
+    SimCard* card = context;
+
+    MfClassicError error = sim_card_auth(card, nfc, block_num, key, key_type, NULL);
+    if(error == MfClassicErrorNone) error = sim_card_session_read_block(card, block_num, data);
+    return error;
+}
+
+static MfClassicError sim_card_write_block(
+    void* context,
+    Nfc* nfc,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicBlock* data) {
+    SimCard* card = context;
+
+    MfClassicError error = sim_card_auth(card, nfc, block_num, key, key_type, NULL);
+    if(error == MfClassicErrorNone) error = sim_card_session_write_block(card, block_num, data);
+    return error;
+}
+
+static MfClassicError sim_card_run_session(
+    void* context,
+    Nfc* nfc,
+    MiBandCardIoSessionCallback callback,
+    void* callback_context) {
+    UNUSED(nfc);
+    SimCard* card = context;
+
+    card->counters.sessions++;
+    if(sim_card_activate_card(card, NULL) != Iso14443_3aErrorNone) return MfClassicErrorTimeout;
+    return callback(&sim_card_session_api, card, callback_context);
+}
+
+static const MiBandCardIoBackend sim_card_backend = {
+    .activate = sim_card_activate,
+    .detect_type = sim_card_detect_type,
+    .auth = sim_card_auth,
+    .read_block = sim_card_read_block,
+    .write_block = sim_card_write_block,
+    .run_session = sim_card_run_session,
+};
+
+SimCard* sim_card_alloc(const SimCardConfig* config, const MfClassicData* dump) {
+    furi_assert(config);
+    furi_assert(dump);
+
+    SimCard* card = malloc(sizeof(SimCard));
+    memset(card, 0, sizeof(SimCard));
+    card->config = *config;
+    card->auth_sector = SIM_CARD_NO_AUTH;
+    card->rng = config->seed ? config->seed : 1;
+    memcpy(card->uid, dump->block[0].data, sizeof(card->uid));
+    card->stuck_trailer = mf_classic_get_sector_trailer_num_by_sector(
+        mf_classic_get_sector_by_block(config->stuck_block));
+
+    uint16_t total_blocks = mf_classic_get_total_block_num(config->type);
+    if(config->keys == SimCardKeysOriginal) {
+        memcpy(card->blocks, dump->block, total_blocks * sizeof(MfClassicBlock));
+    } else {
+        card->blocks[0] = dump->block[0];
+        for(uint16_t block = 1; block < total_blocks; block++) {
+            if(mf_classic_is_sector_trailer(block)) {
+                memcpy(card->blocks[block].data, sim_card_magic_trailer, MF_CLASSIC_BLOCK_SIZE);
+            }
+        }
+    }
+
+    return card;
+}
+
+void sim_card_free(SimCard* card) {
+    free(card);
+}
+
+void sim_card_install(SimCard* card) {
+    furi_assert(card);
+    miband_card_io_set_backend(&sim_card_backend, card);
+}
+
+const MfClassicBlock* sim_card_get_block(const SimCard* card, uint8_t block_num) {
+    furi_assert(card);
+    return &card->blocks[block_num];
+}
+
+const SimCardCounters* sim_card_get_counters(const SimCard* card) {
+    furi_assert(card);
+    return &card->counters;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file sim_card.h
+ * @brief Simulated MfClassic band behind the card I/O interface
+ *
+ * The card keeps its own memory and crypto state: auth checks the keys of
+ * the sector trailer, Block 0 is read-only, Key A reads back as zeros and a
+ * written trailer changes the keys for the next auth. Access bits are not
+ * enforced, both keys may read and write every block.
+ *
+ * Every RF exchange spends its configured latency on the virtual clock and
+ * may be turned into a timeout, which also drops the crypto session, as a
+ * band slipping out of the field would. An optional stuck block acks every
+ * write but stores a corrupted copy, so it never verifies.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
+#include "miband_card_io.h"
+
+/**
+ * @brief Key state of the band at the start of a run
+ */
+typedef enum {
+    SimCardKeysMagic, /**< Blank band: every sector answers to 0xFF keys */
+    SimCardKeysOriginal, /**< Band already holds the dump, keys included */
+} SimCardKeys;
+
+/**
+ * @brief Cost of each RF exchange, in microseconds
+ */
+typedef struct {
+    uint32_t activate_us; /**< Anticollision and select */
+    uint32_t auth_us; /**< Three-pass auth handshake */
+    uint32_t read_us;
+    uint32_t write_us; /**< Both phases of the write */
+    uint32_t halt_us;
+    uint32_t timeout_us; /**< Time lost on an injected timeout */
+} SimCardLatency;
+
+typedef struct {
+    MfClassicType type;
+    SimCardKeys keys;
+    SimCardLatency latency;
+    uint16_t timeout_permille; /**< Chance of a timeout on every exchange, in 1/1000 */
+    uint32_t seed; /**< Seed of the timeout injection */
+    uint8_t stuck_block; /**< Data block that never takes a write intact, 0 for none */
+} SimCardConfig;
+
+/**
+ * @brief Exchange counters of one card
+ */
+typedef struct {
+    uint32_t activations;
+    uint32_t auths;
+    uint32_t auth_failures;
+    uint32_t reads;
+    uint32_t writes;
+    uint32_t sessions;
+    uint32_t timeouts; /**< Injected timeouts */
+    uint32_t stuck_trailer_writes; /**< Writes to the trailer of the stuck block's sector */
+} SimCardCounters;
+
+typedef struct SimCard SimCard;
+
+/**
+ * @brief Default latencies, rough figures of a Flipper talking to a band
+ */
+extern const SimCardLatency sim_card_default_latency;
+
+/**
+ * @brief Allocate a card
+ *
+ * @param config Card configuration, copied
+ * @param dump Dump the band is provisioned with: its Block 0 gives the UID,
+ *             and with SimCardKeysOriginal its whole content is on the card
+ * @return Card instance
+ */
+SimCard* sim_card_alloc(const SimCardConfig* config, const MfClassicData* dump);
+
+void sim_card_free(SimCard* card);
+
+/**
+ * @brief Route every miband_card_io call to this card
+ */
+void sim_card_install(SimCard* card);
+
+/**
+ * @brief Direct memory access, no RF cost, for checking results
+ *
+ * Trailers hold the real keys, not what a read would return.
+ */
+const MfClassicBlock* sim_card_get_block(const SimCard* card, uint8_t block_num);
+
+const SimCardCounters* sim_card_get_counters(const SimCard* card);
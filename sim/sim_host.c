@@ -0,0 +1,177 @@
+/**
+ * @file sim_host.c
+ * @brief Host implementations of the furi and logger calls of the shared modules
+ */
+
+#include <furi.h>
+#include <stdarg.h>
+#include "miband_logger.h"
+
+#define SIM_HOST_FORMAT_MAX 256
+
+static uint64_t sim_host_us = 0;
+static bool sim_host_verbose = false;
+
+struct FuriString {
+    char* data;
+    size_t len;
+    size_t capacity;
+};
+
+void sim_host_crash(const char* expr, const char* file, int line) {
+    fprintf(stderr, "check failed: %s (%s:%d)\n", expr, file, line);
+    abort();
+}
+
+/**
+ * @brief Rewrite a firmware format string for the host
+ *
+ * uint32_t is unsigned long on the Cortex-M4 and unsigned int on LP64
+ * hosts: dropping the 'l' of %lu/%ld/%lx keeps the varargs in step.
+ */
+static void sim_host_format(char* out, size_t out_size, const char* format) {
+    size_t len = 0;
+    bool in_spec = false;
+
+    for(const char* p = format; *p && len < out_size - 1; p++) {
+        if(in_spec && *p == 'l' && out[len - 1] != 'l' && p[1] && strchr("udxX", p[1])) {
+            continue;
+        }
+        if(*p == '%') {
+            in_spec = !in_spec;
+        } else if(in_spec && strchr("diouxXcspfeEgGzn", *p)) {
+            in_spec = *p == 'z';
+        }
+        out[len++] = *p;
+    }
+    out[len] = '\0';
+}
+
+void sim_host_log(char level, const char* tag, const char* format, ...) {
+    if(!sim_host_verbose) return;
+
+    char host_format[SIM_HOST_FORMAT_MAX];
+    sim_host_format(host_format, sizeof(host_format), format);
+
+    fprintf(stderr, "%10.3f [%c][%s] ", sim_host_us / 1000.0, level, tag);
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, host_format, args);
+    va_end(args);
+    fputc('\n', stderr);
+}
+
+void sim_host_set_verbose(bool verbose) {
+    sim_host_verbose = verbose;
+}
+
+void sim_host_advance_us(uint32_t us) {
+    sim_host_us += us;
+}
+
+uint64_t sim_host_get_us(void) {
+    return sim_host_us;
+}
+
+uint32_t furi_get_tick(void) {
+    return (uint32_t)(sim_host_us / 1000);
+}
+
+void furi_delay_ms(uint32_t milliseconds) {
+    sim_host_us += (uint64_t)milliseconds * 1000;
+}
+
+FuriString* furi_string_alloc(void) {
+    FuriString* string = malloc(sizeof(FuriString));
+    string->capacity = 64;
+    string->data = malloc(string->capacity);
+    furi_string_reset(string);
+    return string;
+}
+
+void furi_string_free(FuriString* string) {
+    free(string->data);
+    free(string);
+}
+
+void furi_string_reset(FuriString* string) {
+    string->len = 0;
+    string->data[0] = '\0';
+}
+
+static void furi_string_reserve(FuriString* string, size_t len) {
+    if(len < string->capacity) return;
+    while(string->capacity <= len) string->capacity *= 2;
+    string->data = realloc(string->data, string->capacity);
+}
+
+void furi_string_cat_str(FuriString* string, const char* cstr) {
+    size_t len = strlen(cstr);
+    furi_string_reserve(string, string->len + len);
+    memcpy(&string->data[string->len], cstr, len + 1);
+    string->len += len;
+}
+
+void furi_string_set_str(FuriString* string, const char* cstr) {
+    furi_string_reset(string);
+    furi_string_cat_str(string, cstr);
+}
+
+static void furi_string_cat_vprintf(FuriString* string, const char* format, va_list args) {
+    char host_format[SIM_HOST_FORMAT_MAX];
+    sim_host_format(host_format, sizeof(host_format), format);
+
+    va_list copy;
+    va_copy(copy, args);
+    int len = vsnprintf(NULL, 0, host_format, copy);
+    va_end(copy);
+    if(len <= 0) return;
+
+    furi_string_reserve(string, string->len + len);
+    vsnprintf(&string->data[string->len], len + 1, host_format, args);
+    string->len += len;
+}
+
+void furi_string_printf(FuriString* string, const char* format, ...) {
+    furi_string_reset(string);
+    va_list args;
+    va_start(args, format);
+    furi_string_cat_vprintf(string, format, args);
+    va_end(args);
+}
+
+void furi_string_cat_printf(FuriString* string, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    furi_string_cat_vprintf(string, format, args);
+    va_end(args);
+}
+
+const char* furi_string_get_cstr(const FuriString* string) {
+    return string->data;
+}
+
+// The harness keeps no event log: the shared modules pass a NULL logger anyway
+
+void miband_logger_log(MiBandLogger* logger, LogLevel level, const char* format, ...) {
+    UNUSED(logger);
+    UNUSED(level);
+    UNUSED(format);
+}
+
+void miband_logger_event(
+    MiBandLogger* logger,
+    LogLevel level,
+    MiBandLogEvent event,
+    uint8_t sector,
+    uint8_t block,
+    uint8_t key_type,
+    uint8_t error) {
+    UNUSED(logger);
+    UNUSED(level);
+    UNUSED(event);
+    UNUSED(sector);
+    UNUSED(block);
+    UNUSED(key_type);
+    UNUSED(error);
+}
@@ -0,0 +1,365 @@
+/**
+ * @file sim_main.c
+ * @brief Host harness: repeated provisioning runs on simulated bands
+ *
+ * Every run writes a synthetic dump to a fresh simulated band and verifies
+ * it, with the same timeout sequence for every pipeline profile so the
+ * profiles compare on equal terms. Prints virtual-time and retry figures per
+ * profile.
+ *
+ * With a stuck block (-b), every profile that reads back while writing must
+ * leave that sector's trailer alone; the harness exits with 1 otherwise.
+ */
+
+#include <furi.h>
+#include <getopt.h>
+#include "sim_card.h"
+#include "sim_provision.h"
+
+#define SIM_DEFAULT_RUNS     1000
+#define SIM_DEFAULT_TIMEOUTS 10 // Per mille of exchanges
+
+/**
+ * @brief The shared modules only pass Nfc* through to the backend
+ */
+struct Nfc {
+    uint8_t unused;
+};
+
+typedef struct {
+    uint32_t runs;
+    MfClassicType type;
+    SimCardKeys keys;
+    SimCardLatency latency;
+    uint16_t timeout_permille;
+    uint32_t seed;
+    bool all_profiles;
+    MiBandPipelineProfileId profile_id;
+    bool write_verify; // Force the read-back while writing, whatever the profile
+    bool verify;
+    uint8_t stuck_block; // Data block that never verifies, 0 for none
+} SimOptions;
+
+typedef struct {
+    uint32_t passed;
+    uint32_t corrupt; // Reported success, band content differs from the dump
+    uint32_t* write_ms;
+    uint64_t verify_ms;
+    uint64_t retries;
+    uint64_t rewrites;
+    uint64_t fallback_blocks;
+    uint64_t auths;
+    uint64_t timeouts;
+    uint32_t stuck_commits; // Runs that wrote the trailer over the stuck block's sector
+} SimTotals;
+
+static uint32_t sim_next_random(uint32_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+/**
+ * @brief Fill a dump like a backup would: Block 0, random data, keys found
+ */
+static void sim_make_dump(MfClassicData* dump, MfClassicType type, uint32_t seed) {
+    static const uint8_t access_bits[MF_CLASSIC_ACCESS_BYTES_SIZE] = {0xFF, 0x07, 0x80, 0x69};
+    uint32_t state = seed ? seed : 1;
+
+    memset(dump, 0, sizeof(MfClassicData));
+    dump->type = type;
+
+    uint8_t* block0 = dump->block[0].data;
+    for(size_t i = 0; i < 4; i++) block0[i] = sim_next_random(&state);
+    block0[4] = block0[0] ^ block0[1] ^ block0[2] ^ block0[3];
+    block0[5] = 0x08;
+    block0[6] = 0x04;
+
+    uint16_t total_blocks = mf_classic_get_total_block_num(type);
+    for(uint16_t block = 1; block < total_blocks; block++) {
+        if(mf_classic_is_sector_trailer(block)) continue;
+        for(size_t i = 0; i < MF_CLASSIC_BLOCK_SIZE; i++) {
+            dump->block[block].data[i] = sim_next_random(&state);
+        }
+    }
+
+    uint8_t total_sectors = mf_classic_get_total_sectors_num(type);
+    for(uint8_t sector = 0; sector < total_sectors; sector++) {
+        MfClassicSectorTrailer* trailer = mf_classic_get_sector_trailer_by_sector(dump, sector);
+        memcpy(trailer->access_bits.data, access_bits, sizeof(access_bits));
+        mf_classic_set_key_found(dump, sector, MfClassicKeyTypeA, 0xA0A1A2A3A400ULL | sector);
+        mf_classic_set_key_found(dump, sector, MfClassicKeyTypeB, 0xB0B1B2B3B400ULL | sector);
+    }
+}
+
+/**
+ * @brief Check the band memory against the dump, trailers and keys included
+ */
+static bool sim_card_matches_dump(const SimCard* card, const MfClassicData* dump) {
+    uint16_t total_blocks = mf_classic_get_total_block_num(dump->type);
+    for(uint16_t block = 1; block < total_blocks; block++) {
+        if(memcmp(sim_card_get_block(card, block)->data,
+                  dump->block[block].data,
+                  MF_CLASSIC_BLOCK_SIZE) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int sim_compare_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Run one profile over every band
+ *
+ * @return false if the stuck block's sector got its trailer written anyway
+ */
+static bool sim_run_profile(const SimOptions* options, MiBandPipelineProfileId profile_id) {
+    struct Nfc nfc_instance = {0};
+    Nfc* nfc = &nfc_instance;
+    MiBandAuthCache* auth_cache = miband_auth_cache_alloc();
+    MiBandCardSession* card_session = miband_card_session_alloc(auth_cache);
+    MfClassicData* dump = malloc(sizeof(MfClassicData));
+
+    SimTotals totals = {0};
+    totals.write_ms = malloc(options->runs * sizeof(uint32_t));
+
+    SimProvisionConfig config = {
+        .verify = options->verify,
+    };
+    miband_pipeline_profile_init(&config.profile, profile_id);
+    if(options->write_verify) config.profile.fused_verify = true;
+
+    for(uint32_t run = 0; run < options->runs; run++) {
+        // Same seeds for every profile: same bands, same timeouts
+        uint32_t run_seed = options->seed + run * 7919;
+        sim_make_dump(dump, options->type, run_seed);
+
+        SimCardConfig card_config = {
+            .type = options->type,
+            .keys = options->keys,
+            .latency = options->latency,
+            .timeout_permille = options->timeout_permille,
+            .seed = run_seed ^ 0x9E3779B9,
+            .stuck_block = options->stuck_block,
+        };
+        SimCard* card = sim_card_alloc(&card_config, dump);
+        sim_card_install(card);
+
+        // A fresh band: nothing known about it
+        miband_card_session_reset(card_session);
+        miband_auth_cache_clear(auth_cache);
+
+        SimProvisionResult result;
+        bool passed = sim_provision_run(nfc, card_session, auth_cache, dump, &config, &result);
+        if(passed) totals.passed++;
+        if(result.written && !sim_card_matches_dump(card, dump)) totals.corrupt++;
+
+        totals.write_ms[run] = result.write_ms;
+        totals.verify_ms += result.verify_ms;
+        totals.retries += result.retries;
+        totals.rewrites += result.rewrites;
+        totals.fallback_blocks += result.fallback_blocks;
+        totals.auths += result.auth_attempts;
+        totals.timeouts += sim_card_get_counters(card)->timeouts;
+        if(sim_card_get_counters(card)->stuck_trailer_writes) totals.stuck_commits++;
+
+        sim_card_free(card);
+    }
+
+    qsort(totals.write_ms, options->runs, sizeof(uint32_t), sim_compare_u32);
+    uint64_t write_total = 0;
+    for(uint32_t run = 0; run < options->runs; run++) write_total += totals.write_ms[run];
+
+    double runs = options->runs;
+    printf(
+        "%-8s %5.1f%% ok %3u corrupt | write ms min %4u avg %6.1f p95 %4u max %4u"
+        " | verify avg %6.1f | per run: %5.2f retries %5.2f fallback %5.1f auths"
+        " %5.2f timeouts %4.2f rewrites\n",
+        miband_pipeline_get_profile_name(profile_id),
+        100.0 * totals.passed / runs,
+        totals.corrupt,
+        totals.write_ms[0],
+        write_total / runs,
+        totals.write_ms[(options->runs * 95) / 100],
+        totals.write_ms[options->runs - 1],
+        totals.verify_ms / runs,
+        totals.retries / runs,
+        totals.fallback_blocks / runs,
+        totals.auths / runs,
+        totals.timeouts / runs,
+        totals.rewrites / runs);
+
+    // Without the read-back the writer cannot tell, the verify pass catches it
+    bool stuck_ok = !options->stuck_block || !config.profile.fused_verify ||
+                    totals.stuck_commits == 0;
+    if(options->stuck_block) {
+        printf(
+            "%-8s stuck block %u: trailer written in %u runs%s\n",
+            "",
+            options->stuck_block,
+            totals.stuck_commits,
+            stuck_ok ? "" : ", FAIL");
+    }
+
+    free(totals.write_ms);
+    free(dump);
+    miband_card_session_free(card_session);
+    miband_auth_cache_free(auth_cache);
+    return stuck_ok;
+}
+
+static void sim_usage(const char* name) {
+    fprintf(
+        stderr,
+        "usage: %s [options]\n"
+        "  -n RUNS          runs per profile (%d)\n"
+        "  -t mini|1k|4k    band and dump type (1k)\n"
+        "  -k magic|orig    key state of the band before the write (magic)\n"
+        "  -r PERMILLE      timeout chance per RF exchange (%d)\n"
+        "  -l ACT,AUTH,RD,WR[,TMO]  exchange latencies in us\n"
+        "  -p fastest|balanced|safest|all  pipeline profile (all)\n"
+        "  -w               write+verify (read back while writing) in every profile\n"
+        "  -x               skip the verify pass\n"
+        "  -b BLOCK         data block that acks writes but never verifies\n"
+        "  -s SEED          first seed (1)\n"
+        "  -v               print module logs\n",
+        name,
+        SIM_DEFAULT_RUNS,
+        SIM_DEFAULT_TIMEOUTS);
+}
+
+static bool sim_parse_profile(const char* arg, SimOptions* options) {
+    options->all_profiles = strcmp(arg, "all") == 0;
+    if(options->all_profiles) return true;
+
+    for(MiBandPipelineProfileId id = 0; id < MiBandPipelineProfileCount; id++) {
+        if(strcasecmp(arg, miband_pipeline_get_profile_name(id)) == 0) {
+            options->profile_id = id;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool sim_parse_options(int argc, char** argv, SimOptions* options) {
+    int opt;
+    while((opt = getopt(argc, argv, "n:t:k:r:l:p:wxb:s:vh")) != -1) {
+        switch(opt) {
+        case 'n':
+            options->runs = strtoul(optarg, NULL, 0);
+            if(options->runs == 0) return false;
+            break;
+        case 't':
+            if(strcmp(optarg, "mini") == 0) {
+                options->type = MfClassicTypeMini;
+            } else if(strcmp(optarg, "1k") == 0) {
+                options->type = MfClassicType1k;
+            } else if(strcmp(optarg, "4k") == 0) {
+                options->type = MfClassicType4k;
+            } else {
+                return false;
+            }
+            break;
+        case 'k':
+            if(strcmp(optarg, "magic") == 0) {
+                options->keys = SimCardKeysMagic;
+            } else if(strcmp(optarg, "orig") == 0) {
+                options->keys = SimCardKeysOriginal;
+            } else {
+                return false;
+            }
+            break;
+        case 'r':
+            options->timeout_permille = strtoul(optarg, NULL, 0);
+            if(options->timeout_permille > 1000) return false;
+            break;
+        case 'l': {
+            SimCardLatency* latency = &options->latency;
+            int fields = sscanf(
+                optarg,
+                "%u,%u,%u,%u,%u",
+                &latency->activate_us,
+                &latency->auth_us,
+                &latency->read_us,
+                &latency->write_us,
+                &latency->timeout_us);
+            if(fields < 4) return false;
+            break;
+        }
+        case 'p':
+            if(!sim_parse_profile(optarg, options)) return false;
+            break;
+        case 'w':
+            options->write_verify = true;
+            break;
+        case 'x':
+            options->verify = false;
+            break;
+        case 'b':
+            options->stuck_block = strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            options->seed = strtoul(optarg, NULL, 0);
+            break;
+        case 'v':
+            sim_host_set_verbose(true);
+            break;
+        default:
+            return false;
+        }
+    }
+    if(options->stuck_block &&
+       (options->stuck_block >= mf_classic_get_total_block_num(options->type) ||
+        mf_classic_is_sector_trailer(options->stuck_block))) {
+        return false;
+    }
+    return optind == argc;
+}
+
+int main(int argc, char** argv) {
+    SimOptions options = {
+        .runs = SIM_DEFAULT_RUNS,
+        .type = MfClassicType1k,
+        .keys = SimCardKeysMagic,
+        .latency = sim_card_default_latency,
+        .timeout_permille = SIM_DEFAULT_TIMEOUTS,
+        .seed = 1,
+        .all_profiles = true,
+        .verify = true,
+    };
+
+    if(!sim_parse_options(argc, argv, &options)) {
+        sim_usage(argv[0]);
+        return 2;
+    }
+
+    printf(
+        "%u runs, %u sectors, %s band, %u/1000 timeouts, latency %u/%u/%u/%u us%s%s\n",
+        options.runs,
+        mf_classic_get_total_sectors_num(options.type),
+        options.keys == SimCardKeysMagic ? "magic" : "original",
+        options.timeout_permille,
+        options.latency.activate_us,
+        options.latency.auth_us,
+        options.latency.read_us,
+        options.latency.write_us,
+        options.write_verify ? ", write+verify" : "",
+        options.verify ? ", verify pass" : "");
+
+    bool ok = true;
+    if(options.all_profiles) {
+        for(MiBandPipelineProfileId id = 0; id < MiBandPipelineProfileCount; id++) {
+            ok &= sim_run_profile(&options, id);
+        }
+    } else {
+        ok = sim_run_profile(&options, options.profile_id);
+    }
+
+    return ok ? 0 : 1;
+}
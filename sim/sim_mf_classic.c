@@ -0,0 +1,90 @@
+/**
+ * @file sim_mf_classic.c
+ * @brief Host implementations of the MfClassic layout helpers
+ *
+ * Same layout as the firmware: 4-block sectors up to sector 31, 16-block
+ * sectors above (4K only).
+ */
+
+#include <nfc/protocols/mf_classic/mf_classic.h>
+
+static const uint8_t sim_mf_classic_sectors[MfClassicTypeNum] = {
+    [MfClassicTypeMini] = 5,
+    [MfClassicType1k] = 16,
+    [MfClassicType4k] = 40,
+};
+
+uint8_t mf_classic_get_total_sectors_num(MfClassicType type) {
+    furi_assert(type < MfClassicTypeNum);
+    return sim_mf_classic_sectors[type];
+}
+
+uint16_t mf_classic_get_total_block_num(MfClassicType type) {
+    uint8_t sectors = mf_classic_get_total_sectors_num(type);
+    return sectors <= 32 ? sectors * 4 : 32 * 4 + (sectors - 32) * 16;
+}
+
+uint8_t mf_classic_get_first_block_num_of_sector(uint8_t sector) {
+    return sector < 32 ? sector * 4 : 32 * 4 + (sector - 32) * 16;
+}
+
+uint8_t mf_classic_get_blocks_num_in_sector(uint8_t sector) {
+    return sector < 32 ? 4 : 16;
+}
+
+uint8_t mf_classic_get_sector_trailer_num_by_sector(uint8_t sector) {
+    return mf_classic_get_first_block_num_of_sector(sector) +
+           mf_classic_get_blocks_num_in_sector(sector) - 1;
+}
+
+uint8_t mf_classic_get_sector_by_block(uint8_t block) {
+    return block < 128 ? block / 4 : 32 + (block - 128) / 16;
+}
+
+bool mf_classic_is_sector_trailer(uint8_t block) {
+    uint8_t sector = mf_classic_get_sector_by_block(block);
+    return block == mf_classic_get_sector_trailer_num_by_sector(sector);
+}
+
+MfClassicSectorTrailer*
+    mf_classic_get_sector_trailer_by_sector(const MfClassicData* data, uint8_t sector) {
+    furi_assert(data);
+    uint8_t trailer = mf_classic_get_sector_trailer_num_by_sector(sector);
+    return (MfClassicSectorTrailer*)data->block[trailer].data;
+}
+
+bool mf_classic_is_key_found(
+    const MfClassicData* data,
+    uint8_t sector,
+    MfClassicKeyType key_type) {
+    furi_assert(data);
+    uint64_t mask = key_type == MfClassicKeyTypeA ? data->key_a_mask : data->key_b_mask;
+    return (mask >> sector) & 1;
+}
+
+void mf_classic_set_key_found(
+    MfClassicData* data,
+    uint8_t sector,
+    MfClassicKeyType key_type,
+    uint64_t key) {
+    furi_assert(data);
+
+    MfClassicSectorTrailer* trailer = mf_classic_get_sector_trailer_by_sector(data, sector);
+    MfClassicKey* dest = key_type == MfClassicKeyTypeA ? &trailer->key_a : &trailer->key_b;
+    for(size_t i = 0; i < MF_CLASSIC_KEY_SIZE; i++) {
+        dest->data[MF_CLASSIC_KEY_SIZE - 1 - i] = (uint8_t)(key >> (8 * i));
+    }
+
+    if(key_type == MfClassicKeyTypeA) {
+        data->key_a_mask |= 1ULL << sector;
+    } else {
+        data->key_b_mask |= 1ULL << sector;
+    }
+}
+
+void mf_classic_set_block_read(MfClassicData* data, uint8_t block_num, MfClassicBlock* block) {
+    furi_assert(data);
+
+    data->block[block_num] = *block;
+    data->block_read_mask[block_num / 32] |= 1UL << (block_num % 32);
+}
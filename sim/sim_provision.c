@@ -0,0 +1,351 @@
+/**
+ * @file sim_provision.c
+ * @brief Host provisioning run implementation
+ */
+
+#include "sim_provision.h"
+#include "miband_block_diff.h"
+#include "miband_sector_iter.h"
+#include "miband_sector_session.h"
+
+#define TAG "SimProvision"
+
+typedef struct {
+    Nfc* nfc;
+    MiBandCardSession* card_session;
+    MiBandAuthCache* auth_cache;
+    MfClassicData* dump;
+    const SimProvisionConfig* config;
+    const MiBandRetryPolicy* policy;
+    SimProvisionResult* result;
+} SimProvision;
+
+/**
+ * @brief Authenticate, retrying timeouts only when asked to
+ *
+ * The writer retries its magic probe; fallback re-auths get a single try.
+ * Keys are tested by the sector session auth itself.
+ */
+static MfClassicError sim_provision_auth(
+    SimProvision* provision,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    bool with_retry) {
+    MfClassicAuthContext auth_context;
+    MfClassicError error;
+    MiBandRetry retry;
+    miband_retry_init(&retry, provision->policy);
+
+    do {
+        error = miband_auth_cache_auth(
+            provision->auth_cache, provision->nfc, block_num, key, key_type, &auth_context);
+    } while(error != MfClassicErrorNone && with_retry && miband_retry_next(&retry, error));
+
+    return error;
+}
+
+/**
+ * @brief Read Block 0 in a sector 0 read session, as the writer does
+ */
+static MfClassicError sim_provision_read_block0(
+    SimProvision* provision,
+    MfClassicKey* key,
+    MfClassicKeyType key_type) {
+    MfClassicBlock block0;
+    MiBandSectorSessionRequest request = {
+        .op = MiBandSectorSessionOpRead,
+        .sector = 0,
+        .key = *key,
+        .key_type = key_type,
+        .block_mask = 1U,
+        .blocks = &block0,
+        .auth_cache = provision->auth_cache,
+    };
+    MiBandSectorSessionResult session;
+    miband_sector_session_transfer(
+        provision->nfc, &request, provision->policy->max_attempts, &session);
+
+    return session.error;
+}
+
+static MfClassicError sim_provision_write_block_with_retry(
+    SimProvision* provision,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type) {
+    MfClassicError error;
+    MiBandRetry retry;
+    miband_retry_init(&retry, provision->policy);
+
+    do {
+        error = miband_op_stats_write_block(
+            provision->nfc, block_num, key, key_type, &provision->dump->block[block_num]);
+    } while(error != MfClassicErrorNone && miband_retry_next(&retry, error));
+
+    return error;
+}
+
+/**
+ * @brief Per-block fallback for a data block, with read-back in write+verify mode
+ */
+static bool sim_provision_write_data_block(
+    SimProvision* provision,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type) {
+    const MfClassicBlock* expected = &provision->dump->block[block_num];
+
+    for(uint8_t rewrite = 0;; rewrite++) {
+        if(sim_provision_write_block_with_retry(provision, block_num, key, key_type) !=
+           MfClassicErrorNone) {
+            return false;
+        }
+        if(!provision->config->profile.fused_verify) return true;
+
+        MfClassicBlock readback;
+        if(miband_op_stats_read_block(provision->nfc, block_num, key, key_type, &readback) !=
+           MfClassicErrorNone) {
+            return false;
+        }
+        if(memcmp(readback.data, expected->data, sizeof(readback.data)) == 0) return true;
+
+        if(rewrite == MIBAND_SECTOR_SESSION_VERIFY_REWRITES) return false;
+        provision->result->rewrites++;
+    }
+}
+
+/**
+ * @brief Write one sector: session fast path, per-block fallback, trailer last
+ */
+static bool sim_provision_write_sector(
+    SimProvision* provision,
+    const MiBandSectorIter* iter,
+    MfClassicKey* key,
+    MfClassicKeyType key_type) {
+    uint16_t write_mask = iter->full_mask;
+    if(iter->sector == 0) write_mask &= ~1U; // Block 0 is never written
+    uint16_t trailer_bit = 1U << (iter->blocks_in_sector - 1);
+
+    MiBandSectorSessionRequest request = {
+        .op = provision->config->profile.fused_verify ? MiBandSectorSessionOpWriteVerify :
+                                                        MiBandSectorSessionOpWrite,
+        .sector = iter->sector,
+        .key = *key,
+        .key_type = key_type,
+        .block_mask = write_mask,
+        .blocks = provision->dump->block,
+        .auth_cache = provision->auth_cache,
+    };
+    MiBandSectorSessionResult session;
+    MiBandRetry retry;
+    miband_retry_init(&retry, provision->policy);
+    do {
+        miband_sector_session_transfer(
+            provision->nfc, &request, provision->policy->max_attempts, &session);
+    } while(!session.authenticated && miband_retry_next(&retry, session.error));
+    if(!session.authenticated) return false; // Key rejected, try the next candidate
+    provision->result->rewrites += session.rewrites;
+    if(session.mismatch_mask) return false;
+
+    uint16_t written_mask = (session.done_mask & write_mask) | ~write_mask;
+    provision->result->fallback_blocks += __builtin_popcount(~written_mask & iter->full_mask);
+
+    // Block 0 never needs writing, so the first data block of the sector is 0 or 1
+    uint8_t first_data = iter->sector == 0 ? 1 : 0;
+    for(uint8_t block_in_sector = first_data; block_in_sector < iter->blocks_in_sector - 1;
+        block_in_sector++) {
+        if(written_mask & (1U << block_in_sector)) continue;
+
+        // Same re-auth as the writer before every data block but the first
+        uint8_t block_num = iter->first_block + block_in_sector;
+        if(block_in_sector > first_data &&
+           sim_provision_auth(provision, iter->first_block, key, key_type, false) !=
+               MfClassicErrorNone) {
+            return false;
+        }
+
+        if(!sim_provision_write_data_block(provision, block_num, key, key_type)) {
+            FURI_LOG_E(TAG, "Failed to write block %u", block_num);
+            return false;
+        }
+    }
+
+    if(!(written_mask & trailer_bit) &&
+       sim_provision_write_block_with_retry(provision, iter->trailer_block, key, key_type) !=
+           MfClassicErrorNone) {
+        FURI_LOG_E(TAG, "Failed to write trailer at block %u", iter->trailer_block);
+        return false;
+    }
+
+    // The band now answers to the dump's Key A
+    MfClassicKey written_key;
+    memcpy(
+        written_key.data,
+        provision->dump->block[iter->trailer_block].data,
+        sizeof(written_key.data));
+    miband_auth_cache_set(provision->auth_cache, iter->sector, &written_key, MfClassicKeyTypeA);
+    return true;
+}
+
+static bool sim_provision_write(SimProvision* provision) {
+    if(!miband_card_session_refresh(provision->card_session, provision->nfc)) {
+        FURI_LOG_E(TAG, "Card not present before write");
+        return false;
+    }
+
+    MfClassicType type;
+    if(miband_card_session_get_type(provision->card_session, provision->nfc, &type) !=
+       MfClassicErrorNone) {
+        FURI_LOG_E(TAG, "Card detection failed before write");
+        return false;
+    }
+    if(mf_classic_get_total_sectors_num(type) <
+       mf_classic_get_total_sectors_num(provision->dump->type)) {
+        FURI_LOG_E(TAG, "Card type %d is smaller than the dump", type);
+        return false;
+    }
+
+    // Same magic probe as the writer: 0xFF Key A on sector 1, unless the profile skips it
+    bool has_magic_keys;
+    MiBandCardKeyState key_state = miband_card_session_get_key_state(provision->card_session);
+    if(key_state != MiBandCardKeysUnknown) {
+        has_magic_keys = key_state == MiBandCardKeysMagic;
+    } else if(provision->config->profile.skip_detection) {
+        has_magic_keys = true;
+    } else {
+        MfClassicKey test_key;
+        memset(test_key.data, 0xFF, sizeof(test_key.data));
+        has_magic_keys = sim_provision_auth(provision, 4, &test_key, MfClassicKeyTypeA, true) ==
+                         MfClassicErrorNone;
+    }
+
+    MiBandSectorIter iter;
+    miband_sector_iter_init(&iter, provision->dump->type);
+    while(miband_sector_iter_next(&iter)) {
+        MfClassicKey keys[MIBAND_AUTH_CACHE_MAX_CANDIDATES];
+        MfClassicKeyType key_types[MIBAND_AUTH_CACHE_MAX_CANDIDATES];
+        size_t candidates = miband_auth_cache_get_candidates(
+            provision->auth_cache, provision->dump, iter.sector, has_magic_keys, keys, key_types);
+
+        bool sector_written = false;
+        for(size_t i = 0; i < candidates && !sector_written; i++) {
+            // The writer reads Block 0 first to preserve the UID
+            if(iter.sector == 0 &&
+               sim_provision_read_block0(provision, &keys[i], key_types[i]) !=
+                   MfClassicErrorNone) {
+                continue;
+            }
+
+            sector_written = sim_provision_write_sector(provision, &iter, &keys[i], key_types[i]);
+        }
+
+        if(!sector_written) {
+            FURI_LOG_E(TAG, "Sector %u: every key failed", iter.sector);
+            miband_card_session_set_key_state(provision->card_session, MiBandCardKeysUnknown);
+            return false;
+        }
+    }
+
+    const MfClassicSectorTrailer* trailer =
+        mf_classic_get_sector_trailer_by_sector(provision->dump, 1);
+    miband_card_session_set_key_state(
+        provision->card_session, miband_card_session_classify_key(&trailer->key_a));
+    return true;
+}
+
+/**
+ * @brief Read every sector back with sector sessions and compare with the dump
+ */
+static bool sim_provision_verify(SimProvision* provision) {
+    MfClassicData* readback = malloc(sizeof(MfClassicData));
+    memset(readback, 0, sizeof(MfClassicData));
+    readback->type = provision->dump->type;
+
+    bool read_ok = true;
+    MiBandSectorIter iter;
+    miband_sector_iter_init(&iter, provision->dump->type);
+    while(read_ok && miband_sector_iter_next(&iter)) {
+        MfClassicKey keys[MIBAND_AUTH_CACHE_MAX_CANDIDATES];
+        MfClassicKeyType key_types[MIBAND_AUTH_CACHE_MAX_CANDIDATES];
+        size_t candidates = miband_auth_cache_get_candidates(
+            provision->auth_cache, provision->dump, iter.sector, false, keys, key_types);
+
+        bool sector_read = false;
+        for(size_t i = 0; i < candidates && !sector_read; i++) {
+            MiBandSectorSessionRequest request = {
+                .op = MiBandSectorSessionOpRead,
+                .sector = iter.sector,
+                .key = keys[i],
+                .key_type = key_types[i],
+                .block_mask = iter.data_mask,
+                .blocks = readback->block,
+                .auth_cache = provision->auth_cache,
+            };
+            MiBandSectorSessionResult session;
+            sector_read = miband_sector_session_transfer(
+                provision->nfc, &request, provision->policy->max_attempts, &session);
+        }
+
+        if(!sector_read) {
+            FURI_LOG_E(TAG, "Verify: sector %u unreadable", iter.sector);
+            read_ok = false;
+        }
+    }
+
+    size_t diffs = read_ok ? miband_block_diff_collect(provision->dump, readback, NULL, 0) : 0;
+    if(diffs) FURI_LOG_E(TAG, "Verify: %zu blocks differ", diffs);
+
+    free(readback);
+    return read_ok && diffs == 0;
+}
+
+bool sim_provision_run(
+    Nfc* nfc,
+    MiBandCardSession* card_session,
+    MiBandAuthCache* auth_cache,
+    MfClassicData* dump,
+    const SimProvisionConfig* config,
+    SimProvisionResult* result) {
+    furi_assert(nfc);
+    furi_assert(dump);
+    furi_assert(config);
+    furi_assert(result);
+
+    memset(result, 0, sizeof(SimProvisionResult));
+    SimProvision provision = {
+        .nfc = nfc,
+        .card_session = card_session,
+        .auth_cache = auth_cache,
+        .dump = dump,
+        .config = config,
+        .policy = &config->profile.retry,
+        .result = result,
+    };
+
+    miband_auth_cache_reset_stats(auth_cache);
+    miband_op_stats_begin(&result->write_stats, "Write");
+    result->written = sim_provision_write(&provision);
+    miband_op_stats_end(NULL);
+    result->write_ms = result->write_stats.duration_ms;
+    result->auth_attempts = miband_auth_cache_get_attempts(auth_cache);
+    result->auth_failures = miband_auth_cache_get_failures(auth_cache);
+
+    for(size_t i = 0; i < MIBAND_OP_STATS_ERRORS; i++) {
+        result->retries += result->write_stats.retries[i];
+    }
+
+    if(!result->written || !config->verify) return result->written;
+
+    MiBandOpStats verify_stats;
+    miband_op_stats_begin(&verify_stats, "Verify");
+    result->verified = sim_provision_verify(&provision);
+    miband_op_stats_end(NULL);
+    result->verify_ms = verify_stats.duration_ms;
+
+    for(size_t i = 0; i < MIBAND_OP_STATS_ERRORS; i++) {
+        result->retries += verify_stats.retries[i];
+    }
+
+    return result->verified;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file sim_provision.h
+ * @brief Provisioning run on the host: the writer's write, then a verify pass
+ *
+ * Follows the sector strategy of the Write scene with the shared modules
+ * (card session, auth cache, sector sessions, pipeline profile): magic probe,
+ * per-sector key candidates, one-auth sector session with per-block retry
+ * fallback, trailer last. The verify pass reads the band back as the Verify
+ * scene does and compares it with the dump.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <nfc/nfc.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
+#include "miband_auth_cache.h"
+#include "miband_card_session.h"
+#include "miband_op_stats.h"
+#include "miband_pipeline.h"
+
+typedef struct {
+    MiBandPipelineProfile profile; /**< Retry policy, magic probe and read-back while writing */
+    bool verify; /**< Verify pass after the write */
+} SimProvisionConfig;
+
+typedef struct {
+    bool written; /**< The writer reported success */
+    bool verified; /**< The verify pass found the dump on the band */
+    uint32_t write_ms;
+    uint32_t verify_ms;
+    uint32_t retries; /**< Timeouts retried per the profile's retry policy */
+    uint32_t rewrites; /**< Blocks rewritten after a read-back mismatch */
+    uint32_t fallback_blocks; /**< Blocks left to the per-block path by the session */
+    uint32_t auth_attempts;
+    uint32_t auth_failures;
+    MiBandOpStats write_stats;
+} SimProvisionResult;
+
+/**
+ * @brief Write a dump to the band in the field and verify it
+ *
+ * @param nfc NFC instance, passed through to the card I/O backend
+ * @param card_session Card session, reset by the caller between bands
+ * @param auth_cache Auth cache the card session is bound to
+ * @param dump Dump to write
+ * @param config Run configuration
+ * @param result Filled with the outcome and metrics
+ * @return true if written and, when enabled, verified
+ */
+bool sim_provision_run(
+    Nfc* nfc,
+    MiBandCardSession* card_session,
+    MiBandAuthCache* auth_cache,
+    MfClassicData* dump,
+    const SimProvisionConfig* config,
+    SimProvisionResult* result);